@@ -0,0 +1,137 @@
+#include "mf_bench.h"
+#include <mathflow/ops/mf_ops_core.h>
+#include <mathflow/isa/mf_opcodes.h>
+#include <mathflow/isa/mf_exec_ctx.h>
+#include <mathflow/base/mf_memory.h>
+#include <mathflow/base/mf_platform.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Gather Suite
+ * One Gather over a whole batch through the checked loop (reference table)
+ * and the fast paths, for random (atlas-like), sequential and strided index
+ * streams. Outputs must match bit for bit.
+ */
+
+#define BENCH_GATHER_COUNT (1024*1024)
+#define BENCH_GATHER_DATA  (512*512)     // render_text's font atlas
+#define BENCH_GATHER_ITERS 20
+
+typedef enum { GATHER_RANDOM, GATHER_SEQUENTIAL, GATHER_STRIDED } bench_gather_pattern;
+
+typedef struct {
+    const char* name;
+    mf_dtype data_dtype;
+    mf_dtype idx_dtype;
+    bench_gather_pattern pattern;
+} bench_gather_case;
+
+static const bench_gather_case GATHER_CASES[] = {
+    { "random f32[i32]",  MF_DTYPE_F32, MF_DTYPE_I32, GATHER_RANDOM },
+    { "random f32[f32]",  MF_DTYPE_F32, MF_DTYPE_F32, GATHER_RANDOM },
+    { "random u8[i32]",   MF_DTYPE_U8,  MF_DTYPE_I32, GATHER_RANDOM },
+    { "seq f32[i32]",     MF_DTYPE_F32, MF_DTYPE_I32, GATHER_SEQUENTIAL },
+    { "seq f32[f32]",     MF_DTYPE_F32, MF_DTYPE_F32, GATHER_SEQUENTIAL },
+    { "stride4 f32[i32]", MF_DTYPE_F32, MF_DTYPE_I32, GATHER_STRIDED },
+};
+
+static mf_bench_regs g_regs;
+
+// The whole batch as one job; the data is bound whole (stride 0), like a resource of another size
+static void gather_call(mf_op_func fn, const bench_gather_case* gc, mf_exec_ctx* ctx, mf_arena* scratch,
+                        u8* out, const u8* data, const u8* idx, u32 count, u32 data_count) {
+    mf_arena_reset(scratch);
+    mf_bench_ctx_init(ctx, &g_regs, (mf_allocator*)scratch);
+    int32_t out_shape[1] = { (int32_t)count };
+    int32_t data_shape[1] = { (int32_t)data_count };
+    mf_type_info_init_contiguous(&ctx->reg_info[0], gc->data_dtype, out_shape, 1);
+    mf_type_info_init_contiguous(&ctx->reg_info[1], gc->data_dtype, data_shape, 1);
+    mf_type_info_init_contiguous(&ctx->reg_info[2], gc->idx_dtype, out_shape, 1);
+    ctx->reg_strides[0] = (i32)mf_dtype_size(gc->data_dtype);
+    ctx->reg_strides[1] = 0;
+    ctx->reg_strides[2] = (i32)mf_dtype_size(gc->idx_dtype);
+    ctx->reg_ptrs[0] = out;
+    ctx->reg_ptrs[1] = (void*)data;
+    ctx->reg_ptrs[2] = (void*)idx;
+    ctx->linear_offset = 0;
+    ctx->batch_size = count;
+
+    mf_instruction inst = {0};
+    inst.opcode = MF_OP_GATHER;
+    inst.dest_idx = 0; inst.src1_idx = 1; inst.src2_idx = 2;
+    fn(ctx, &inst);
+}
+
+static f64 gather_time(mf_op_func fn, const bench_gather_case* gc, mf_exec_ctx* ctx, mf_arena* scratch,
+                       u8* out, const u8* data, const u8* idx, u32 count, u32 data_count, u32 iters) {
+    gather_call(fn, gc, ctx, scratch, out, data, idx, count, data_count); // Warm-up
+    f64 start = mf_time_now();
+    for (u32 i = 0; i < iters; ++i) gather_call(fn, gc, ctx, scratch, out, data, idx, count, data_count);
+    return (mf_time_now() - start) / iters;
+}
+
+int mf_bench_gather(const mf_bench_opts* opts) {
+    u32 count = opts->size ? opts->size : BENCH_GATHER_COUNT;
+    u32 iters = opts->iters ? opts->iters : BENCH_GATHER_ITERS;
+    u32 data_count = BENCH_GATHER_DATA;
+
+    mf_op_func fast[MF_OP_LIMIT];
+    mf_op_func checked[MF_OP_LIMIT];
+    mf_ops_fill_table(fast);
+    mf_ops_fill_table_reference(checked);
+
+    mf_arena scratch;
+    if (!mf_arena_init_reserve(&scratch, 64 * 1024 * 1024)) return 1;
+    mf_exec_ctx ctx;
+
+    int failures = 0;
+    printf("ISA: %s, %u elements from %u, M elements/s\n", mf_ops_simd_name(), count, data_count);
+    printf("%-18s %12s %12s %8s %s\n", "Case", "Checked", "Fast", "Speedup", "Check");
+
+    for (size_t i = 0; i < sizeof(GATHER_CASES) / sizeof(GATHER_CASES[0]); ++i) {
+        const bench_gather_case* gc = &GATHER_CASES[i];
+        size_t elem = mf_dtype_size(gc->data_dtype);
+        u8* data = malloc(elem * data_count);
+        u8* idx = malloc(sizeof(i32) * count);
+        u8* out_ref = malloc(elem * count);
+        u8* out = malloc(elem * count);
+        if (!data || !idx || !out_ref || !out) {
+            free(data); free(idx); free(out_ref); free(out);
+            failures++;
+            continue;
+        }
+        for (size_t k = 0; k < elem * data_count; ++k) data[k] = (u8)(k * 131u + 7u);
+
+        u32 seed = 0x9E3779B9u;
+        for (u32 k = 0; k < count; ++k) {
+            u32 v;
+            switch (gc->pattern) {
+                case GATHER_RANDOM: seed = seed * 1664525u + 1013904223u; v = (seed >> 8) % data_count; break;
+                case GATHER_SEQUENTIAL: v = k % data_count; break;
+                default: v = (k * 4u) % data_count; break;
+            }
+            if (gc->idx_dtype == MF_DTYPE_F32) ((f32*)idx)[k] = (f32)v;
+            else ((i32*)idx)[k] = (i32)v;
+        }
+        // Whole-batch affine streams need the batch to fit in the data once
+        u32 n = count;
+        if (gc->pattern == GATHER_SEQUENTIAL && n > data_count) n = data_count;
+        if (gc->pattern == GATHER_STRIDED && n > data_count / 4) n = data_count / 4;
+
+        f64 t_ref = gather_time(checked[MF_OP_GATHER], gc, &ctx, &scratch, out_ref, data, idx, n, data_count, iters);
+        f64 t_new = gather_time(fast[MF_OP_GATHER], gc, &ctx, &scratch, out, data, idx, n, data_count, iters);
+
+        bool match = memcmp(out, out_ref, elem * n) == 0;
+        if (!match) failures++;
+
+        printf("%-18s %12.2f %12.2f %7.2fx %s\n", gc->name,
+            n * 1e-6 / t_ref, n * 1e-6 / t_new, t_ref / t_new, match ? "ok" : "MISMATCH");
+
+        free(data); free(idx); free(out_ref); free(out);
+    }
+
+    mf_arena_release(&scratch);
+    return failures ? 1 : 0;
+}
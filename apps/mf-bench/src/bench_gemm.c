@@ -0,0 +1,200 @@
+#include "mf_bench.h"
+#include <mathflow/ops/mf_ops_core.h>
+#include <mathflow/isa/mf_opcodes.h>
+#include <mathflow/isa/mf_exec_ctx.h>
+#include <mathflow/base/mf_thread_pool.h>
+#include <mathflow/base/mf_memory.h>
+#include <mathflow/base/mf_platform.h>
+#include <mathflow/base/mf_shape.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * GEMM Suite
+ * Runs MatMul through the direct loop (reference table) and the blocked
+ * kernel, single-threaded over the whole output and split by rows over the
+ * thread pool the way the CPU backend splits a MatMul task into jobs.
+ * Every run must match the direct loop bit for bit.
+ */
+
+#define BENCH_GEMM_SCRATCH   (256*1024*1024) // Reserved per thread, committed on demand
+#define BENCH_GEMM_JOBS      4               // Row jobs per thread
+#define BENCH_GEMM_MIN_FLOPS 1e9             // Default iterations cover at least this much work
+
+typedef struct {
+    const char* kind;
+    i32 M, K, N;
+} bench_gemm_shape;
+
+static const bench_gemm_shape GEMM_SHAPES[] = {
+    { "square", 64, 64, 64 },
+    { "square", 256, 256, 256 },
+    { "square", 512, 512, 512 },
+    { "square", 1024, 1024, 1024 },
+    { "skinny", 4096, 256, 16 },     // Tall output, few columns
+    { "skinny", 16, 256, 4096 },     // Few rows, wide output
+    { "skinny", 4096, 16, 4096 },    // Shallow K (outer product like)
+    { "skinny", 256, 4096, 256 },    // Deep K
+};
+
+typedef struct {
+    mf_op_func fn;
+    i32 M, K, N;
+    f32* a;
+    f32* b;
+    f32* c;
+    i32 rows_per_job;
+} bench_gemm_run;
+
+typedef struct {
+    mf_arena scratch;
+    mf_exec_ctx ctx;
+    mf_bench_regs regs;
+} bench_gemm_worker;
+
+static void* gemm_worker_init(int thread_idx, void* user_data) {
+    (void)thread_idx; (void)user_data;
+    bench_gemm_worker* worker = calloc(1, sizeof(bench_gemm_worker));
+    if (worker && !mf_arena_init_reserve(&worker->scratch, BENCH_GEMM_SCRATCH)) { free(worker); return NULL; }
+    return worker;
+}
+
+static void gemm_worker_cleanup(void* thread_local_data, void* user_data) {
+    (void)user_data;
+    bench_gemm_worker* worker = (bench_gemm_worker*)thread_local_data;
+    if (!worker) return;
+    mf_arena_release(&worker->scratch);
+    free(worker);
+}
+
+static void set_info(mf_type_info* info, i32 rows, i32 cols) {
+    int32_t shape[2] = { rows, cols };
+    mf_type_info_init_contiguous(info, MF_DTYPE_F32, shape, 2);
+}
+
+// Output rows [r0, r1), with register pointers offset as the backend prepares them for a job
+static void gemm_rows(bench_gemm_worker* worker, const bench_gemm_run* run, i32 r0, i32 r1) {
+    mf_exec_ctx* ctx = &worker->ctx;
+    size_t total = (size_t)run->M * run->N;
+    size_t offset = (size_t)r0 * run->N;
+
+    mf_arena_reset(&worker->scratch);
+    mf_bench_ctx_init(ctx, &worker->regs, (mf_allocator*)&worker->scratch);
+    set_info(&ctx->reg_info[0], run->M, run->N);
+    set_info(&ctx->reg_info[1], run->M, run->K);
+    set_info(&ctx->reg_info[2], run->K, run->N);
+    ctx->reg_strides[0] = (i32)sizeof(f32);
+    ctx->reg_strides[1] = mf_shape_calc_linear_stride((size_t)run->M * run->K, total) * (i32)sizeof(f32);
+    ctx->reg_strides[2] = mf_shape_calc_linear_stride((size_t)run->K * run->N, total) * (i32)sizeof(f32);
+    ctx->reg_ptrs[0] = (u8*)run->c + offset * ctx->reg_strides[0];
+    ctx->reg_ptrs[1] = (u8*)run->a + offset * ctx->reg_strides[1];
+    ctx->reg_ptrs[2] = (u8*)run->b + offset * ctx->reg_strides[2];
+    ctx->linear_offset = (u32)offset;
+    ctx->batch_size = (u32)((size_t)(r1 - r0) * run->N);
+
+    mf_instruction inst = {0};
+    inst.opcode = MF_OP_MATMUL;
+    inst.dest_idx = 0; inst.src1_idx = 1; inst.src2_idx = 2;
+    run->fn(ctx, &inst);
+}
+
+static void gemm_job(u32 job_idx, void* thread_local_data, void* user_data) {
+    bench_gemm_worker* worker = (bench_gemm_worker*)thread_local_data;
+    const bench_gemm_run* run = (const bench_gemm_run*)user_data;
+    i32 r0 = (i32)job_idx * run->rows_per_job;
+    i32 r1 = r0 + run->rows_per_job < run->M ? r0 + run->rows_per_job : run->M;
+    if (worker && r0 < r1) gemm_rows(worker, run, r0, r1);
+}
+
+static f64 time_single(bench_gemm_run* run, bench_gemm_worker* worker, u32 iters) {
+    gemm_rows(worker, run, 0, run->M); // Warm-up
+    f64 start = mf_time_now();
+    for (u32 i = 0; i < iters; ++i) gemm_rows(worker, run, 0, run->M);
+    return mf_time_now() - start;
+}
+
+static f64 time_pool(bench_gemm_run* run, mf_thread_pool* pool, u32 iters) {
+    u32 jobs = (u32)((run->M + run->rows_per_job - 1) / run->rows_per_job);
+    mf_thread_pool_run(pool, jobs, gemm_job, run); // Warm-up
+    f64 start = mf_time_now();
+    for (u32 i = 0; i < iters; ++i) mf_thread_pool_run(pool, jobs, gemm_job, run);
+    return mf_time_now() - start;
+}
+
+int mf_bench_gemm(const mf_bench_opts* opts) {
+    int threads = opts->threads ? (int)opts->threads : mf_cpu_count();
+
+    mf_op_func blocked[MF_OP_LIMIT];
+    mf_op_func direct[MF_OP_LIMIT];
+    mf_ops_fill_table(blocked);
+    mf_ops_fill_table_reference(direct);
+
+    mf_thread_pool_desc desc = { .num_threads = threads, .init_fn = gemm_worker_init, .cleanup_fn = gemm_worker_cleanup };
+    mf_thread_pool* pool = mf_thread_pool_create(&desc);
+    bench_gemm_worker* worker = gemm_worker_init(0, NULL);
+    if (!pool || !worker) {
+        if (pool) mf_thread_pool_destroy(pool);
+        gemm_worker_cleanup(worker, NULL);
+        return 1;
+    }
+
+    // --size runs one square shape instead of the table
+    bench_gemm_shape custom = { "square", (i32)opts->size, (i32)opts->size, (i32)opts->size };
+    const bench_gemm_shape* shapes = opts->size ? &custom : GEMM_SHAPES;
+    size_t shape_count = opts->size ? 1 : sizeof(GEMM_SHAPES) / sizeof(GEMM_SHAPES[0]);
+
+    int failures = 0;
+    printf("ISA: %s, %d threads, GFLOP/s\n", mf_ops_simd_name(), threads);
+    printf("%-7s %-16s %10s %10s %10s %8s %8s %s\n", "Shape", "MxKxN", "Direct", "Blocked", "Split", "Speedup", "Scaling", "Check");
+
+    for (size_t s = 0; s < shape_count; ++s) {
+        const bench_gemm_shape* shape = &shapes[s];
+        size_t count_a = (size_t)shape->M * shape->K;
+        size_t count_b = (size_t)shape->K * shape->N;
+        size_t count_c = (size_t)shape->M * shape->N;
+        f64 flops = 2.0 * (f64)shape->M * (f64)shape->K * (f64)shape->N;
+        u32 iters = opts->iters ? opts->iters : (u32)ceil(BENCH_GEMM_MIN_FLOPS / flops);
+
+        f32* a = malloc(sizeof(f32) * count_a);
+        f32* b = malloc(sizeof(f32) * count_b);
+        f32* c_ref = malloc(sizeof(f32) * count_c);
+        f32* c = malloc(sizeof(f32) * count_c);
+        if (!a || !b || !c_ref || !c) {
+            free(a); free(b); free(c_ref); free(c);
+            failures++;
+            continue;
+        }
+        for (size_t i = 0; i < count_a; ++i) a[i] = sinf((f32)i * 0.37f);
+        for (size_t i = 0; i < count_b; ++i) b[i] = cosf((f32)i * 0.11f);
+
+        i32 rows_per_job = shape->M / (threads * BENCH_GEMM_JOBS);
+        bench_gemm_run run = { direct[MF_OP_MATMUL], shape->M, shape->K, shape->N, a, b, c_ref, rows_per_job > 0 ? rows_per_job : 1 };
+        // The direct loop is slow on big shapes; one pass is enough to rate it
+        f64 t_direct = time_single(&run, worker, 1);
+
+        run.fn = blocked[MF_OP_MATMUL];
+        run.c = c;
+        memset(c, 0, sizeof(f32) * count_c);
+        f64 t_blocked = time_single(&run, worker, iters) / iters;
+        bool match = memcmp(c, c_ref, sizeof(f32) * count_c) == 0;
+
+        memset(c, 0, sizeof(f32) * count_c);
+        f64 t_split = time_pool(&run, pool, iters) / iters;
+        match = match && memcmp(c, c_ref, sizeof(f32) * count_c) == 0;
+        if (!match) failures++;
+
+        char dims[32];
+        snprintf(dims, sizeof(dims), "%dx%dx%d", shape->M, shape->K, shape->N);
+        printf("%-7s %-16s %10.2f %10.2f %10.2f %7.2fx %7.2fx %s\n", shape->kind, dims,
+            flops * 1e-9 / t_direct, flops * 1e-9 / t_blocked, flops * 1e-9 / t_split,
+            t_direct / t_blocked, t_blocked / t_split, match ? "ok" : "MISMATCH");
+
+        free(a); free(b); free(c_ref); free(c);
+    }
+
+    gemm_worker_cleanup(worker, NULL);
+    mf_thread_pool_destroy(pool);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,130 @@
+#include "mf_bench.h"
+#include <mathflow/ops/mf_ops_core.h>
+#include <mathflow/isa/mf_opcodes.h>
+#include <mathflow/isa/mf_exec_ctx.h>
+#include <mathflow/base/mf_platform.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/**
+ * Ops Suite
+ * Runs every SIMD-generated kernel from mf_ops_db.inc through both the
+ * vectorized entry point and the scalar reference loop, on the operand
+ * layouts the backend produces (contiguous, broadcast, strided channel).
+ */
+
+typedef struct {
+    u16 opcode;
+    const char* name;
+    int arity;
+} bench_op;
+
+#define MF_BENCH_AUTO(...)
+#define MF_BENCH_MANUAL(...)
+#define MF_BENCH_SIMD(_op, _n, _ar) { MF_OP_##_op, _n, _ar },
+#define MF_OP(_s, _n, _op, _cat, _strat, _in, _out, _tr, _sr, _ar, _p1, _p2, _p3, _p4, _kt, _ke, _kv, _arity) \
+    MF_BENCH_##_kt(_op, _n, _arity)
+
+static const bench_op BENCH_OPS[] = {
+    MF_OP_LIST
+};
+
+#undef MF_OP
+#undef MF_BENCH_AUTO
+#undef MF_BENCH_MANUAL
+#undef MF_BENCH_SIMD
+
+#define BENCH_OP_COUNT (sizeof(BENCH_OPS) / sizeof(BENCH_OPS[0]))
+#define BENCH_CHANNELS 4
+
+typedef enum {
+    LAYOUT_CONTIGUOUS,   // All operands stride == 4
+    LAYOUT_BROADCAST,    // a contiguous, b/c broadcast scalars
+    LAYOUT_STRIDED,      // a read from one channel of an interleaved [N, 4] tensor
+    LAYOUT_COUNT
+} bench_layout;
+
+static const char* LAYOUT_NAMES[LAYOUT_COUNT] = { "contig", "bcast", "stride4" };
+
+static mf_exec_ctx g_ctx;
+static mf_bench_regs g_regs;
+
+static void setup_ctx(mf_exec_ctx* ctx, u32 n, bench_layout layout, f32* d, f32* a, f32* b, f32* c) {
+    mf_bench_ctx_init(ctx, &g_regs, NULL);
+    ctx->batch_size = n;
+    ctx->reg_ptrs[0] = d; ctx->reg_ptrs[1] = a; ctx->reg_ptrs[2] = b; ctx->reg_ptrs[3] = c;
+    ctx->reg_strides[0] = sizeof(f32);
+    ctx->reg_strides[1] = (layout == LAYOUT_STRIDED) ? (i32)(sizeof(f32) * BENCH_CHANNELS) : (i32)sizeof(f32);
+    ctx->reg_strides[2] = (layout == LAYOUT_BROADCAST) ? 0 : (i32)sizeof(f32);
+    ctx->reg_strides[3] = (layout == LAYOUT_BROADCAST) ? 0 : (i32)sizeof(f32);
+}
+
+static f64 time_kernel(mf_op_func fn, mf_exec_ctx* ctx, const mf_instruction* inst, u32 iters) {
+    fn(ctx, inst); // Warm-up
+    f64 start = mf_time_now();
+    for (u32 i = 0; i < iters; ++i) fn(ctx, inst);
+    return mf_time_now() - start;
+}
+
+int mf_bench_ops(const mf_bench_opts* opts) {
+    u32 n = opts->size ? opts->size : 4096;
+    u32 iters = opts->iters ? opts->iters : 20000;
+
+    mf_op_func simd[MF_OP_LIMIT];
+    mf_op_func ref[MF_OP_LIMIT];
+    mf_ops_fill_table(simd);
+    mf_ops_fill_table_reference(ref);
+
+    f32* a = malloc(sizeof(f32) * n * BENCH_CHANNELS);
+    f32* b = malloc(sizeof(f32) * n);
+    f32* c = malloc(sizeof(f32) * n);
+    f32* d_simd = malloc(sizeof(f32) * n);
+    f32* d_ref = malloc(sizeof(f32) * n);
+    if (!a || !b || !c || !d_simd || !d_ref) {
+        free(a); free(b); free(c); free(d_simd); free(d_ref);
+        return 1;
+    }
+
+    for (u32 i = 0; i < n * BENCH_CHANNELS; ++i) a[i] = sinf((f32)i * 0.37f) * 8.0f;
+    for (u32 i = 0; i < n; ++i) {
+        b[i] = cosf((f32)i * 0.11f) * 4.0f + 0.5f;
+        c[i] = 0.25f + (f32)(i % 7) * 0.125f;
+    }
+
+    mf_instruction inst = {0};
+    inst.dest_idx = 0; inst.src1_idx = 1; inst.src2_idx = 2; inst.src3_idx = 3;
+
+    int failures = 0;
+    printf("ISA: %s, %u elements x %u iterations\n", mf_ops_simd_name(), n, iters);
+    printf("%-8s %-8s %12s %12s %8s %s\n", "Op", "Layout", "Ref Melem/s", "SIMD Melem/s", "Speedup", "Check");
+
+    for (size_t o = 0; o < BENCH_OP_COUNT; ++o) {
+        const bench_op* op = &BENCH_OPS[o];
+        inst.opcode = op->opcode;
+
+        for (int l = 0; l < LAYOUT_COUNT; ++l) {
+            if (l == LAYOUT_BROADCAST && op->arity < 2) continue;
+
+            memset(d_simd, 0, sizeof(f32) * n);
+            memset(d_ref, 0, sizeof(f32) * n);
+
+            setup_ctx(&g_ctx, n, (bench_layout)l, d_ref, a, b, c);
+            f64 t_ref = time_kernel(ref[op->opcode], &g_ctx, &inst, iters);
+
+            setup_ctx(&g_ctx, n, (bench_layout)l, d_simd, a, b, c);
+            f64 t_simd = time_kernel(simd[op->opcode], &g_ctx, &inst, iters);
+
+            bool match = memcmp(d_simd, d_ref, sizeof(f32) * n) == 0;
+            if (!match) failures++;
+
+            f64 elems = (f64)n * (f64)iters * 1e-6;
+            printf("%-8s %-8s %12.1f %12.1f %7.2fx %s\n", op->name, LAYOUT_NAMES[l],
+                elems / t_ref, elems / t_simd, t_ref / t_simd, match ? "ok" : "MISMATCH");
+        }
+    }
+
+    free(a); free(b); free(c); free(d_simd); free(d_ref);
+    return failures ? 1 : 0;
+}
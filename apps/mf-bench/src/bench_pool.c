@@ -0,0 +1,119 @@
+#include "mf_bench.h"
+#include <mathflow/base/mf_thread_pool.h>
+#include <mathflow/base/mf_platform.h>
+#include <stdio.h>
+
+/**
+ * Pool Suite
+ * Dispatch latency of mf_thread_pool_run with empty jobs: the cost of
+ * publishing a batch, waking workers and collecting completion. Every row
+ * also checks that each job ran exactly once. The region row measures one
+ * mf_thread_pool_region stepping through barrier-separated phases.
+ */
+
+#define BENCH_NESTED_JOBS 16
+#define BENCH_REGION_STEPS 16
+
+typedef struct {
+    mf_thread_pool* pool;
+    mf_atomic_i32 executed;
+    mf_thread_barrier barrier;
+} bench_pool_ctx;
+
+static void empty_job(u32 job_idx, void* thread_local_data, void* user_data) {
+    (void)job_idx; (void)thread_local_data; (void)user_data;
+}
+
+static void counting_job(u32 job_idx, void* thread_local_data, void* user_data) {
+    (void)job_idx; (void)thread_local_data;
+    mf_atomic_inc(&((bench_pool_ctx*)user_data)->executed);
+}
+
+static void nested_job(u32 job_idx, void* thread_local_data, void* user_data) {
+    (void)job_idx; (void)thread_local_data;
+    bench_pool_ctx* ctx = (bench_pool_ctx*)user_data;
+    mf_thread_pool_run(ctx->pool, BENCH_NESTED_JOBS, counting_job, ctx);
+}
+
+static void region_steps(int thread_idx, int thread_count, void* thread_local_data, void* user_data) {
+    (void)thread_idx; (void)thread_count; (void)thread_local_data;
+    bench_pool_ctx* ctx = (bench_pool_ctx*)user_data;
+    int32_t sense = 0;
+    for (int s = 0; s < BENCH_REGION_STEPS; ++s) {
+        mf_atomic_inc(&ctx->executed);
+        mf_thread_barrier_wait(&ctx->barrier, &sense);
+    }
+}
+
+static f64 time_dispatch(mf_thread_pool* pool, u32 jobs, u32 iters, mf_thread_job_func fn, void* user) {
+    mf_thread_pool_run(pool, jobs, fn, user); // Warm-up
+    f64 start = mf_time_now();
+    for (u32 i = 0; i < iters; ++i) mf_thread_pool_run(pool, jobs, fn, user);
+    return mf_time_now() - start;
+}
+
+int mf_bench_pool(const mf_bench_opts* opts) {
+    u32 iters = opts->iters ? opts->iters : 20000;
+    int max_threads = opts->threads ? (int)opts->threads : mf_cpu_count();
+    static const u32 JOB_COUNTS[] = { 1, 16, 1024 };
+
+    int failures = 0;
+    printf("%u dispatches per row, empty job bodies\n", iters);
+    printf("%-8s %-10s %14s %12s %s\n", "Threads", "Jobs", "us/dispatch", "ns/job", "Check");
+
+    for (int t = 1; t <= max_threads; ++t) {
+        mf_thread_pool_desc desc = { .num_threads = t };
+        mf_thread_pool* pool = mf_thread_pool_create(&desc);
+        if (!pool) return 1;
+
+        for (size_t j = 0; j < sizeof(JOB_COUNTS) / sizeof(JOB_COUNTS[0]); ++j) {
+            u32 jobs = JOB_COUNTS[j];
+            u32 row_iters = jobs > 64 ? (iters / 16 > 0 ? iters / 16 : 1) : iters;
+
+            f64 elapsed = time_dispatch(pool, jobs, row_iters, empty_job, NULL);
+
+            bench_pool_ctx ctx = { .pool = pool };
+            mf_atomic_store(&ctx.executed, 0);
+            mf_thread_pool_run(pool, jobs, counting_job, &ctx);
+            bool ok = mf_atomic_load(&ctx.executed) == (int32_t)jobs;
+            if (!ok) failures++;
+
+            printf("%-8d %-10u %14.2f %12.1f %s\n", t, jobs,
+                elapsed * 1e6 / row_iters, elapsed * 1e9 / ((f64)row_iters * jobs), ok ? "ok" : "FAIL");
+        }
+
+        // Nested submission: every outer job submits and waits on an inner batch
+        {
+            u32 outer = 16;
+            u32 row_iters = iters / 16 > 0 ? iters / 16 : 1;
+            bench_pool_ctx ctx = { .pool = pool };
+            mf_atomic_store(&ctx.executed, 0);
+            f64 elapsed = time_dispatch(pool, outer, row_iters, nested_job, &ctx);
+            bool ok = mf_atomic_load(&ctx.executed) == (int32_t)((row_iters + 1) * outer * BENCH_NESTED_JOBS);
+            if (!ok) failures++;
+
+            printf("%-8d %-10s %14.2f %12.1f %s\n", t, "16x16", 
+                elapsed * 1e6 / row_iters, elapsed * 1e9 / ((f64)row_iters * outer * (BENCH_NESTED_JOBS + 1)), ok ? "ok" : "FAIL");
+        }
+
+        // Region: all threads step together, one barrier per step
+        {
+            u32 row_iters = iters / 16 > 0 ? iters / 16 : 1;
+            bench_pool_ctx ctx = { .pool = pool };
+            mf_atomic_store(&ctx.executed, 0);
+            mf_thread_barrier_init(&ctx.barrier, pool, t);
+            f64 start = mf_time_now();
+            for (u32 i = 0; i < row_iters; ++i) mf_thread_pool_region(pool, region_steps, &ctx);
+            f64 elapsed = mf_time_now() - start;
+            bool ok = mf_atomic_load(&ctx.executed) == (int32_t)(row_iters * BENCH_REGION_STEPS * (u32)t);
+            if (!ok) failures++;
+
+            printf("%-8d %-10s %14.2f %12.1f %s\n", t, "region16",
+                elapsed * 1e6 / row_iters, elapsed * 1e9 / ((f64)row_iters * BENCH_REGION_STEPS), ok ? "ok" : "FAIL");
+        }
+
+        mf_thread_pool_destroy(pool);
+    }
+
+    return failures ? 1 : 0;
+}
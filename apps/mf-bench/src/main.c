@@ -0,0 +1,73 @@
+#include "mf_bench.h"
+#include <mathflow/base/mf_log.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef int (*mf_bench_suite_func)(const mf_bench_opts* opts);
+
+typedef struct {
+    const char* name;
+    const char* help;
+    mf_bench_suite_func func;
+} mf_bench_suite;
+
+static const mf_bench_suite SUITES[] = {
+    { "ops", "Per-op throughput of vectorized kernels vs. scalar reference", mf_bench_ops },
+    { "pool", "Thread pool dispatch latency for empty jobs", mf_bench_pool },
+    { "gemm", "MatMul GFLOP/s: direct loop vs. blocked kernel, single and row-split", mf_bench_gemm },
+    { "batched", "Small MatMul/Inverse per entity: per-matrix loop vs. batched kernels", mf_bench_batched },
+    { "gather", "Gather throughput: checked loop vs. fast paths (random, sequential, strided)", mf_bench_gather },
+};
+
+#define SUITE_COUNT (sizeof(SUITES) / sizeof(SUITES[0]))
+
+static void print_help(const char* prog) {
+    printf("Usage: %s <suite|all> [options]\n", prog);
+    printf("Suites:\n");
+    for (size_t i = 0; i < SUITE_COUNT; ++i) {
+        printf("  %-8s %s\n", SUITES[i].name, SUITES[i].help);
+    }
+    printf("Options:\n");
+    printf("  --size <n>     Problem size (suite specific)\n");
+    printf("  --iters <n>    Repetitions per measurement\n");
+    printf("  --threads <n>  Max thread count (default: CPU count)\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        print_help(argv[0]);
+        return 1;
+    }
+
+    mf_bench_opts opts = {0};
+    for (int i = 2; i < argc; ++i) {
+        if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            opts.size = (u32)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--iters") == 0 && i + 1 < argc) {
+            opts.iters = (u32)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            opts.threads = (u32)atoi(argv[++i]);
+        }
+    }
+
+    const char* suite = argv[1];
+    bool all = strcmp(suite, "all") == 0;
+    bool found = false;
+    int result = 0;
+
+    for (size_t i = 0; i < SUITE_COUNT; ++i) {
+        if (all || strcmp(suite, SUITES[i].name) == 0) {
+            found = true;
+            printf("=== %s ===\n", SUITES[i].name);
+            result |= SUITES[i].func(&opts);
+        }
+    }
+
+    if (!found) {
+        MF_LOG_ERROR("Unknown suite '%s'", suite);
+        print_help(argv[0]);
+        return 1;
+    }
+    return result;
+}
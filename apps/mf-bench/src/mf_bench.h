@@ -0,0 +1,40 @@
+#ifndef MF_BENCH_H
+#define MF_BENCH_H
+
+#include <mathflow/base/mf_types.h>
+#include <mathflow/isa/mf_exec_ctx.h>
+#include <string.h>
+
+/**
+ * MathFlow Micro-Benchmarks
+ * Each suite prints a table to stdout and returns 0 on success (non-zero if a
+ * correctness check against the reference path failed).
+ */
+
+typedef struct mf_bench_opts {
+    u32 size;       // Elements per kernel call / problem size (0 = suite default)
+    u32 iters;      // Repetitions per measurement (0 = suite default)
+    u32 threads;    // Max thread count (0 = CPU count)
+} mf_bench_opts;
+
+// Register window of kernels called by hand (registers 0..3)
+#define MF_BENCH_REGS 4
+typedef struct mf_bench_regs {
+    void* ptrs[MF_BENCH_REGS];
+    i32 strides[MF_BENCH_REGS];
+    mf_type_info info[MF_BENCH_REGS];
+} mf_bench_regs;
+
+static inline void mf_bench_ctx_init(mf_exec_ctx* ctx, mf_bench_regs* regs, mf_allocator* allocator) {
+    memset(regs, 0, sizeof(*regs));
+    mf_exec_ctx_init(ctx, allocator);
+    mf_exec_ctx_set_window(ctx, regs->ptrs, regs->strides, regs->info, MF_BENCH_REGS);
+}
+
+int mf_bench_ops(const mf_bench_opts* opts);
+int mf_bench_pool(const mf_bench_opts* opts);
+int mf_bench_gemm(const mf_bench_opts* opts);
+int mf_bench_batched(const mf_bench_opts* opts);
+int mf_bench_gather(const mf_bench_opts* opts);
+
+#endif // MF_BENCH_H
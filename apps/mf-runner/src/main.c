@@ -10,6 +10,7 @@ static void print_help(const char* prog) {
     printf("Options:\n");
     printf("  --frames <n>   Number of frames to execute (default: 1)\n");
     printf("  --trace        Enable trace logging\n");
+    printf("  --safe         Keep NaN/Inf sanitization whatever profile the app asks for\n");
 }
 
 int main(int argc, char** argv) {
@@ -22,6 +23,7 @@ int main(int argc, char** argv) {
 
     const char* mfapp_path = argv[1];
     int frames = 1;
+    mf_host_desc app_desc = {0};
     
     for (int i = 2; i < argc; ++i) {
         if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
@@ -29,10 +31,11 @@ int main(int argc, char** argv) {
             i++;
         } else if (strcmp(argv[i], "--trace") == 0) {
             mf_log_set_global_level(MF_LOG_LEVEL_TRACE);
+        } else if (strcmp(argv[i], "--safe") == 0) {
+            app_desc.exec_profile = MF_EXEC_PROFILE_SAFE;
         }
     }
 
-    mf_host_desc app_desc = {0};
     if (mf_app_load_config(mfapp_path, &app_desc) != 0) {
         MF_LOG_ERROR("Failed to load application from %s", mfapp_path);
         return 1;
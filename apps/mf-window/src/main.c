@@ -11,7 +11,7 @@ int main(int argc, char** argv) {
     mf_log_set_global_level(MF_LOG_LEVEL_INFO);
 
     if (argc < 2) {
-        printf("Usage: mf-window <app.mfapp> [--log-interval <seconds>] [--trace] [--debug]\n");
+        printf("Usage: mf-window <app.mfapp> [--log-interval <seconds>] [--trace] [--debug] [--safe]\n");
         return 1;
     }
 
@@ -26,6 +26,9 @@ int main(int argc, char** argv) {
             mf_log_set_global_level(MF_LOG_LEVEL_TRACE);
         } else if (strcmp(argv[i], "--debug") == 0) {
             mf_log_set_global_level(MF_LOG_LEVEL_DEBUG);
+            desc.exec_profile = MF_EXEC_PROFILE_SAFE; // Debug runs keep NaN/Inf sanitization
+        } else if (strcmp(argv[i], "--safe") == 0) {
+            desc.exec_profile = MF_EXEC_PROFILE_SAFE;
         }
     }
 
@@ -2,6 +2,45 @@
 #define MF_BACKEND_CPU_H
 
 #include <mathflow/isa/mf_backend.h>
+#include <mathflow/isa/mf_program.h>
+
+/**
+ * @brief How a frame (mf_backend_dispatch_graph_func) is spread over the threads.
+ */
+typedef enum {
+    MF_CPU_SCHEDULE_AUTO = 0,   // Frame region for frames of small tasks, task graph otherwise
+    MF_CPU_SCHEDULE_GRAPH,      // Each task starts as soon as its dependencies finish
+    MF_CPU_SCHEDULE_FRAME       // All threads step through the frame together, separated by barriers
+} mf_backend_cpu_schedule;
+
+typedef struct mf_backend_cpu_desc {
+    int num_threads;                    // Number of threads (0 = auto)
+    mf_backend_cpu_schedule schedule;
+    bool autotune;                      // Time the first runs of each task to refine its job size
+    int strip_size;                     // Sub-batch of elementwise instruction runs (0 = auto, < 0 = off)
+    mf_exec_profile profile;            // Forced on every program (DEFAULT = each program's own)
+    int poll_interval;                  // Instructions between kill switch polls in a job (0 = job start only)
+    bool pairwise_sum;                  // F32 ReduceSum/ReduceMean add pairwise within a job (slower, smaller rounding error)
+} mf_backend_cpu_desc;
+
+/**
+ * @brief Job sizing and scratch use of one task (see mf_backend_cpu_get_stats).
+ */
+typedef struct mf_backend_cpu_task_stats {
+    const struct mf_program* program;
+    uint32_t task_idx;
+    size_t total_elements;      // Domain the plan was resolved for
+    uint32_t job_size;          // Elements per job
+    uint32_t job_count;
+    uint32_t footprint;         // Bytes of bound registers per element
+    uint32_t strip_size;        // Elements per sub-batch of elementwise runs (0 = not strip-mined)
+    size_t scratch_hint;        // Worker scratch one job is expected to need (bytes)
+    size_t scratch_peak;        // Largest worker scratch one job actually used (bytes)
+    bool tuned;                 // Size is final (tuner finished or disabled)
+    double ns_per_element;      // Best tuner sample (0 if never sampled)
+} mf_backend_cpu_task_stats;
+
+typedef void (*mf_backend_cpu_stats_cb)(const mf_backend_cpu_task_stats* stats, void* user_data);
 
 /**
  * @brief Initializes the CPU backend.
@@ -12,4 +51,14 @@
  */
 void mf_backend_cpu_init(mf_backend* backend, int num_threads);
 
+/**
+ * @brief Initializes the CPU backend with explicit options.
+ */
+void mf_backend_cpu_init_desc(mf_backend* backend, const mf_backend_cpu_desc* desc);
+
+/**
+ * @brief Reports the job sizing and scratch use of every resolved task of every baked program.
+ */
+void mf_backend_cpu_get_stats(const mf_backend* backend, mf_backend_cpu_stats_cb cb, void* user_data);
+
 #endif // MF_BACKEND_CPU_H
@@ -7,6 +7,7 @@
 #include <mathflow/base/mf_log.h>
 #include <mathflow/base/mf_platform.h>
 #include <mathflow/base/mf_shape.h>
+#include <mathflow/base/mf_half.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -14,59 +15,255 @@
 
 // --- Constants ---
 
-#define MF_CPU_JOB_SIZE         4096         // Elements per job (Linear)
+#define MF_CPU_JOB_SIZE         4096         // Elements per job until a task plan picks its own
 #define MF_CPU_INLINE_THRESHOLD 1024         // If total elements < this, run inline
-#define MF_CPU_WORKER_HEAP_SZ   (64*1024*1024) // 64MB per worker
+#define MF_CPU_WORKER_RESERVE   (256*1024*1024) // Address space per worker; committed on demand
+#define MF_CPU_FRAME_STEP_JOBS  4            // AUTO schedule: frame region while steps average fewer jobs per thread
+
+// Job sizing (per task, see plan_job_size)
+#define MF_CPU_JOB_MIN          256          // Elements
+#define MF_CPU_JOB_MAX          65536
+#define MF_CPU_JOB_ALIGN        64           // Keeps jobs whole SIMD blocks
+#define MF_CPU_JOB_CACHE_BYTES  (256*1024)   // Bound registers of one job should fit in L2
+#define MF_CPU_JOB_MIN_WORK     16384        // Instructions x elements that amortize one job's setup
+#define MF_CPU_JOBS_PER_THREAD  4            // Load balancing: at least this many jobs per thread
+#define MF_CPU_SORT_JOB_MIN     4096         // A sort tile publishes and looks back one status word per digit
+#define MF_CPU_TUNE_CANDIDATES  3            // Heuristic size, half and double
+#define MF_CPU_TUNE_SAMPLES     3            // Runs per candidate; the fastest one counts
+
+// Strip-mining (see cpu_exec_strips)
+#define MF_CPU_STRIP_MIN        64           // Elements per sub-batch
+#define MF_CPU_STRIP_MAX        256
+#define MF_CPU_STRIP_CACHE_BYTES (16*1024)   // Bound registers of one sub-batch should fit in L1
+
+#define MF_CPU_CACHE_LINE       64           // Threads' reduction accumulators never share one
+
+// Scatter targets up to this size get a partial per thread (L2-resident), larger ones
+// one partial written with atomics
+#define MF_CPU_SCATTER_PRIVATE_BYTES (64*1024)
 
 // --- Internal Structures ---
 
+/**
+ * Auto-tuner state of a task: the candidate job sizes are tried in turn over the
+ * first runs after a resolve, then the fastest per element is kept.
+ */
+typedef struct {
+    u32 sizes[MF_CPU_TUNE_CANDIDATES];
+    f64 best[MF_CPU_TUNE_CANDIDATES];   // Seconds per element
+    u32 trial;
+    bool done;
+} mf_cpu_job_tuner;
+
+/**
+ * A run of consecutive instructions of a task. Elementwise runs are strip-mined:
+ * every instruction of the run goes over one small sub-batch before the next one.
+ */
+typedef struct {
+    u32 start;              // Relative to the task's first instruction
+    u32 count;
+    bool strip;
+} mf_cpu_inst_run;
+
+/**
+ * Per-task execution plan.
+ * Operand strides and specialized kernels are resolved once (at bake, and again only
+ * when the bound shapes change), so jobs just offset base pointers and call.
+ */
+typedef struct {
+    const mf_task* task;
+    bool resolved;
+    size_t total_elements;  // Domain size the plan was resolved for
+    size_t* reg_counts;     // [binding_count] Element count of each binding at resolve time
+    i32* strides;           // [window] Byte strides
+    mf_op_func* kernels;    // [inst_count] Pre-resolved (possibly specialized) kernels
+
+    // Register window: the task's bindings renumbered densely (binding b is register b),
+    // then one empty slot that operands the task does not bind resolve to
+    u32 window;             // binding_count + 1
+    mf_instruction* code;   // [inst_count] The task's instructions, renumbered into the window
+    mf_type_info* reg_info; // [window] Register metadata, refreshed per run and shared by its jobs
+
+    // Job sizing
+    u32 job_size;           // Elements per job
+    u32 job_align;          // Job sizes are multiples of this (SIMD blocks, or output rows)
+    u32 footprint;          // Bytes of bound registers per element
+    mf_cpu_job_tuner tuner;
+
+    // Scan tasks
+    mf_atomic_i64* scan_tiles; // [scan_capacity] Look-back status word of each job
+    u32 scan_capacity;
+
+    // Sort tasks: buffers for sort_capacity elements over up to sort_tiles tiles
+    mf_sort_state sort;
+    size_t sort_capacity;
+    u32 sort_tiles;
+
+    // Worker scratch
+    size_t scratch_hint;    // Bytes one job allocates (generated registers), committed up front
+    mf_atomic_i32 scratch_peak; // Largest scratch use of one job so far
+
+    // Instruction runs
+    mf_cpu_inst_run* runs;  // [run_count]
+    u32 run_count;
+    u32 strip_size;         // Elements per sub-batch of an elementwise run (0 = whole job)
+    bool strip_generators;  // Only strip-mined runs read index registers: they are generated per sub-batch
+
+    // Task graph
+    u32* successors;        // [successor_count] Tasks depending on this one
+    u32 successor_count;
+    u32* ready;             // [successor_count] Successors released by this task (graph run scratch)
+} mf_cpu_task_plan;
+
+/**
+ * A register written by a reduction. Every thread folds its jobs into its own
+ * accumulators of it (one per element: segmented reductions have several); the
+ * task's end merges them and stores the result.
+ */
+typedef struct {
+    u32 task;
+    u32 inst;               // Relative to the task's first instruction
+    u16 reg;
+    u16 opcode;
+    u32 offset;             // First accumulator within a thread's block
+    u32 slots;              // Accumulators (elements of reg)
+} mf_cpu_reduction;
+
+/**
+ * A register written by a scatter. Jobs write into a zeroed partial target, the
+ * task's end folds the partials and stores them over the base (see mf_ops_scatter_fold).
+ * Each thread has its own partial unless the target is too large to copy per thread,
+ * then all share the first one and write it with atomics (plan_scatter_shared).
+ */
 typedef struct {
+    u32 task;
+    u32 inst;               // Relative to the task's first instruction
+    u16 reg;
+    u16 base;               // Register the target starts from
+    u16 opcode;
+    bool shared;            // Current run writes one partial with atomics
+    size_t stride;          // Bytes between threads' partials (whole cache lines)
+    size_t capacity;        // Bytes reserved
+    void* mem;              // Allocation the partials are aligned within
+    u8* partials;
+} mf_cpu_scatter;
+
+typedef struct mf_cpu_baked_kernel {
     const mf_program* program;
+    mf_exec_profile profile; // Resolved at bake (never DEFAULT)
+    u32 poll_interval;       // Instructions between kill switch polls within a run (0 = once per job)
+    mf_cpu_task_plan* plans; // [task_count]
+    struct mf_cpu_baked_kernel* next; // Backend's list of baked kernels (stats)
+
+    // Task graph
+    u32* roots;              // Tasks without dependencies
+    u32 root_count;
+    mf_atomic_i32* remaining; // [task_count] Unfinished dependencies during a graph run
+    mf_atomic_i32 pending;   // Tasks left in the current iteration
+    mf_atomic_i32 blocked;   // Kernels (plus the launch token) this kernel still waits for
+    u32 iterations;          // Iterations left in the current graph run
     
-    // Pre-allocated scratchpads
-    f32* reduction_scratch;
-    u32 reduction_scratch_size;
+    // Reductions: thread t's accumulators of reduction r start at
+    // reduction_accs[t * reduction_stride + reductions[r].offset].
+    // Each thread's block is padded to whole cache lines.
+    mf_cpu_reduction* reductions; // [reduction_count]
+    u32 reduction_count;
+    u32 reduction_stride;
+    mf_reduce_acc* reduction_accs;
+    void* reduction_mem;          // Allocation reduction_accs is aligned within
 
-    f32* sync_scratch;
-    u32 sync_scratch_size; 
+    // Scatters: each has its own partials, grown when a run needs more
+    mf_cpu_scatter* scatters;     // [scatter_count]
+    u32 scatter_count;
 } mf_cpu_baked_kernel;
 
-typedef struct {
-    mf_thread_pool* pool;
-    mf_op_func op_table[MF_OP_LIMIT];
-} mf_backend_cpu_state;
-
 typedef struct {
     int thread_idx;
     mf_exec_ctx ctx;
-    mf_arena temp_arena; 
-    void* heap_mem;
-    size_t heap_size;
+    void* reg_ptrs[MF_MAX_REGISTERS + 1]; // Window of the running job (only its first plan->window are touched)
+    mf_arena temp_arena;    // Reserved range, committed up to the largest job seen
 } mf_backend_cpu_worker_state;
 
 typedef struct {
     const mf_program* program;
     mf_state* main_state;
-    mf_op_func* op_table;
     
     const mf_task* current_task;
+    const mf_cpu_task_plan* plan;
     uint32_t start_inst;
     uint32_t inst_count;
     
     size_t total_elements;
+    u32 job_size;
     u8 ndim;
     u32 domain_shape[MF_MAX_DIMS];
+    f64 start_time;         // Set when the tuner samples this run
     
-    // Parallel Sync Support
-    int sync_pass;
-    void* sync_data;
+    // Parallel Scan Support
+    mf_atomic_i64* scan_tiles; // Plan's tiles, NULL unless a scan task
+    mf_atomic_i32 scan_next;   // Next tile, handed out in job start order
+
+    // Parallel Sort Support
+    mf_sort_state* sort;       // Plan's sort state, NULL unless a sort task
+    u32 rounds;                // Jobs go over the tiles this many times (MF_SORT_ROUNDS for sorts, else 1)
 
     // Parallel Reduction Support
-    f32* reduction_scratch; // [num_threads * num_registers]
-    u32 reduction_scratch_per_thread;
+    const mf_cpu_baked_kernel* baked; // Owner of the reduction accumulators
     int num_threads;
+
+    bool check_finite;      // FAST_CHECKED profile: jobs scan the registers they wrote
+    u32 poll_interval;      // Baked kill switch poll interval (0 = job start only)
 } mf_cpu_parallel_batch;
 
+/**
+ * One task run in a frame schedule.
+ */
+typedef struct {
+    u32 kernel;
+    u32 task;
+    u32 step;
+    bool active;             // Begun and not ended yet
+    u32 job_offset;          // Within the current step
+    u32 job_count;
+    mf_cpu_parallel_batch batch;
+} mf_cpu_frame_run;
+
+/**
+ * Frame schedule: every thread steps through it inside one pool region, with a
+ * barrier before and after the jobs of each step. Buffers grow and are reused.
+ */
+typedef struct {
+    const mf_backend_kernel* kernels;
+    u32 kernel_count;
+
+    mf_cpu_frame_run* runs;
+    u32 run_count, run_capacity;
+    u32* step_items;         // Run indices, grouped by step
+    u32* step_offsets;       // [step_count + 1]
+    u32 step_count, item_capacity, step_capacity;
+    u32* scratch;            // Per-task end steps and per-kernel start steps while building
+    u32 scratch_capacity;
+
+    mf_thread_barrier barrier;
+    mf_atomic_i32 next_job;
+    u32 step_jobs;
+    bool abort;
+} mf_cpu_frame;
+
+typedef struct {
+    mf_thread_pool* pool;
+    mf_op_func op_table[MF_OP_LIMIT];
+    mf_op_func op_table_fast[MF_OP_LIMIT]; // Unsanitized kernels (FAST profiles)
+    mf_exec_profile profile;
+    u32 poll_interval;
+    mf_backend_cpu_schedule schedule;
+    bool autotune;
+    bool pairwise_sum;
+    int strip_size;
+    mf_cpu_frame frame;
+    struct mf_cpu_baked_kernel* baked_list;
+} mf_backend_cpu_state;
+
 // --- Worker Lifecycle ---
 
 static void* worker_init(int thread_idx, void* user_data) {
@@ -74,19 +271,11 @@ static void* worker_init(int thread_idx, void* user_data) {
     mf_backend_cpu_worker_state* state = malloc(sizeof(mf_backend_cpu_worker_state));
     if (!state) return NULL;
     state->thread_idx = thread_idx;
-    
-#ifdef _WIN32
-    state->heap_mem = _aligned_malloc(MF_CPU_WORKER_HEAP_SZ, 16);
-#else
-    state->heap_mem = aligned_alloc(16, MF_CPU_WORKER_HEAP_SZ);
-#endif
-
-    if (!state->heap_mem) {
+    if (!mf_arena_init_reserve(&state->temp_arena, MF_CPU_WORKER_RESERVE)) {
+        MF_LOG_ERROR("Backend: Failed to reserve worker scratch (%zu MB)", (size_t)(MF_CPU_WORKER_RESERVE >> 20));
         free(state);
         return NULL;
     }
-    state->heap_size = MF_CPU_WORKER_HEAP_SZ;
-    mf_arena_init(&state->temp_arena, state->heap_mem, state->heap_size);
     return state;
 }
 
@@ -94,11 +283,7 @@ static void worker_cleanup(void* thread_local_data, void* user_data) {
     (void)user_data;
     mf_backend_cpu_worker_state* state = (mf_backend_cpu_worker_state*)thread_local_data;
     if (!state) return;
-#ifdef _WIN32
-    _aligned_free(state->heap_mem);
-#else
-    free(state->heap_mem);
-#endif
+    mf_arena_release(&state->temp_arena);
     free(state);
 }
 
@@ -109,6 +294,8 @@ static const char* _dtype_to_str(mf_dtype type) {
         case MF_DTYPE_F32: return "F32";
         case MF_DTYPE_I32: return "I32";
         case MF_DTYPE_U8:  return "U8";
+        case MF_DTYPE_F16: return "F16";
+        case MF_DTYPE_BF16: return "BF16";
         default: return "UNK";
     }
 }
@@ -121,15 +308,16 @@ static const char* find_reg_name(const mf_program* prog, u32 reg_idx) {
     return "temp";
 }
 
-static void format_tensor_debug(char* buf, const mf_exec_ctx* ctx, int reg_idx, const mf_program* prog, const char* port_name) {
-    if (reg_idx < 0 || reg_idx >= MF_MAX_REGISTERS) {
+// Program register reg_idx, seen by the kernel as window slot local_idx
+static void format_tensor_debug(char* buf, const mf_exec_ctx* ctx, int reg_idx, u16 local_idx, const mf_program* prog, const char* port_name) {
+    if (reg_idx < 0 || reg_idx >= MF_MAX_REGISTERS || local_idx >= ctx->reg_count) {
         sprintf(buf, "Reg %-2d (INVALID)", reg_idx);
         return;
     }
     
     const char* name = find_reg_name(prog, reg_idx);
-    const mf_type_info* info = &ctx->reg_info[reg_idx];
-    void* data = ctx->reg_ptrs[reg_idx];
+    const mf_type_info* info = &ctx->reg_info[local_idx];
+    void* data = ctx->reg_ptrs[local_idx];
 
     char shape_str[64] = {0};
     int pos = 0;
@@ -152,14 +340,18 @@ static void format_tensor_debug(char* buf, const mf_exec_ctx* ctx, int reg_idx,
         if (info->dtype == MF_DTYPE_F32) val = *(f32*)data;
         else if (info->dtype == MF_DTYPE_I32) val = (f32)*(int32_t*)data;
         else if (info->dtype == MF_DTYPE_U8) val = (f32)*(u8*)data;
+        else if (mf_dtype_is_half(info->dtype)) val = mf_dtype_load_f32(data, info->dtype, 0);
         sprintf(buf, "%-30s : Value: %-10.3f (%s)", tag, val, _dtype_to_str(info->dtype));
     } else {
         sprintf(buf, "%-30s : Tensor[%-10s] (%s) Ptr: %p", tag, shape_str, _dtype_to_str(info->dtype), data);
     }
 }
 
-static void report_crash(mf_exec_ctx* ctx, const mf_cpu_parallel_batch* batch, u32 inst_idx) {
+// i: the failing instruction within the task
+static void report_crash(mf_exec_ctx* ctx, const mf_cpu_parallel_batch* batch, u32 i) {
+    u32 inst_idx = batch->start_inst + i;
     const mf_instruction* inst = &batch->program->code[inst_idx];
+    const mf_instruction* local = &batch->plan->code[i];
     const mf_runtime_op_metadata* meta = mf_get_op_metadata(inst->opcode);
 
     char coords[128] = {0};
@@ -175,58 +367,490 @@ static void report_crash(mf_exec_ctx* ctx, const mf_cpu_parallel_batch* batch, u
     for (int d = 0; d < ctx->ndim; ++d) pos += sprintf(coords + pos, "%u%s", exact_coords[d], (d < ctx->ndim - 1) ? ", " : "");
 
     char s1_info[128], s2_info[128], s3_info[128], s4_info[128], d_info[128];
-    format_tensor_debug(d_info,  ctx, inst->dest_idx, batch->program, "out");
-    format_tensor_debug(s1_info, ctx, inst->src1_idx, batch->program, meta ? meta->ports[0] : "src1");
-    format_tensor_debug(s2_info, ctx, inst->src2_idx, batch->program, meta ? meta->ports[1] : "src2");
-    format_tensor_debug(s3_info, ctx, inst->src3_idx, batch->program, meta ? meta->ports[2] : "src3");
-    format_tensor_debug(s4_info, ctx, inst->src4_idx, batch->program, meta ? meta->ports[3] : "src4");
+    format_tensor_debug(d_info,  ctx, inst->dest_idx, local->dest_idx, batch->program, "out");
+    format_tensor_debug(s1_info, ctx, inst->src1_idx, local->src1_idx, batch->program, meta ? meta->ports[0] : "src1");
+    format_tensor_debug(s2_info, ctx, inst->src2_idx, local->src2_idx, batch->program, meta ? meta->ports[1] : "src2");
+    format_tensor_debug(s3_info, ctx, inst->src3_idx, local->src3_idx, batch->program, meta ? meta->ports[2] : "src3");
+    format_tensor_debug(s4_info, ctx, inst->src4_idx, local->src4_idx, batch->program, meta ? meta->ports[3] : "src4");
 
     MF_LOG_FATAL("\nKERNEL CRASH #%u Opcode: %s\nDest: %s\nSrc1: %s\nSrc2: %s\nSrc3: %s\nSrc4: %s\nCoord: [%s] Error: %s\n",
                  inst_idx, mf_opcode_to_str(inst->opcode), d_info, s1_info, s2_info, s3_info, s4_info,
                  coords, mf_exec_error_to_str(ctx->error));
 }
 
-static inline void mf_cpu_exec(mf_exec_ctx* ctx, const mf_cpu_parallel_batch* batch, u32 count) {
-    for (uint32_t i = 0; i < count; ++i) {
-        if (ctx->error != MF_ERROR_NONE) break;
-        if (batch->main_state && mf_atomic_load((mf_atomic_i32*)&batch->main_state->error_code) != 0) break;
+// Kill switch: this kernel's own error word, or the engine-wide one other kernels fail into
+static inline bool cpu_killed(const mf_exec_ctx* ctx, const mf_cpu_parallel_batch* batch) {
+    if (batch->main_state && mf_atomic_load((mf_atomic_i32*)&batch->main_state->error_code) != 0) return true;
+    return ctx->global_error_ptr && mf_atomic_load(ctx->global_error_ptr) != 0;
+}
+
+/**
+ * Runs instructions [first, first + count) of the task. Kernels report failure by
+ * return code (with ctx->error_idx set), so the loop only calls; the kill switch is
+ * polled every batch->poll_interval instructions, or not at all here (job start).
+ * Returns false if the job must stop: a kernel failed (ctx->error) or it was killed.
+ */
+static inline bool mf_cpu_exec(mf_exec_ctx* ctx, const mf_cpu_parallel_batch* batch, u32 first, u32 count) {
+    const mf_op_func* kernels = batch->plan->kernels;
+    const mf_instruction* code = batch->plan->code;
+    const u32 poll = batch->poll_interval;
+    u32 next_poll = poll ? first + poll : UINT32_MAX;
 
-        u32 inst_idx = batch->start_inst + i;
-        const mf_instruction* inst = &batch->program->code[inst_idx];
-        
-        mf_op_func op = batch->op_table[inst->opcode];
-        if (op) {
-            op(ctx, inst);
-            if (ctx->error != MF_ERROR_NONE) { report_crash(ctx, batch, inst_idx); break; }
+    for (u32 i = first; i < first + count; ++i) {
+        if (i == next_poll) {
+            if (cpu_killed(ctx, batch)) return false;
+            next_poll += poll;
+        }
+        mf_exec_error err = kernels[i](ctx, &code[i]);
+        if (err != MF_ERROR_NONE) {
+            ctx->error = err;
+            report_crash(ctx, batch, i);
+            return false;
         }
     }
+    return true;
+}
+
+// --- Index Generation ---
+
+/**
+ * Coordinate along one axis for elements [offset, offset + count): constant runs of
+ * `inner` elements (the axis' row-major stride) stepping up and wrapping at `dim`.
+ * The innermost axis (inner == 1) is an iota per row instead, which vectorizes.
+ */
+#define MF_INDEX_FILL_AXIS(T) { \
+    T* o = (T*)out; \
+    u32 c = (offset / inner) % dim; \
+    if (inner == 1) { \
+        while (count > 0) { \
+            u32 seg = dim - c < count ? dim - c : count; \
+            for (u32 j = 0; j < seg; ++j) o[j] = (T)(c + j); \
+            o += seg; count -= seg; c = 0; \
+        } \
+    } else { \
+        u32 left = inner - offset % inner; \
+        while (count > 0) { \
+            u32 seg = left < count ? left : count; \
+            const T v = (T)c; \
+            for (u32 j = 0; j < seg; ++j) o[j] = v; \
+            o += seg; count -= seg; left = inner; \
+            c = (c + 1 == dim) ? 0 : c + 1; \
+        } \
+    } \
+}
+
+static void index_fill_axis(void* out, mf_dtype dtype, u32 count, u32 offset, u32 dim, u32 inner) {
+    if (dtype == MF_DTYPE_F32) MF_INDEX_FILL_AXIS(f32)
+    else if (dtype == MF_DTYPE_I32) MF_INDEX_FILL_AXIS(i32)
+}
+
+// All coordinates per element: outer ones are constant along a row, the last one counts up
+#define MF_INDEX_FILL_VECTOR(T) { \
+    T* o = (T*)out; \
+    const u32 row = domain_shape[ndim - 1]; \
+    while (count > 0) { \
+        u32 x = coords[ndim - 1]; \
+        u32 seg = row - x < count ? row - x : count; \
+        for (u32 j = 0; j < seg; ++j, o += ndim) { \
+            for (u32 d = 0; d + 1 < ndim; ++d) o[d] = (T)coords[d]; \
+            o[ndim - 1] = (T)(x + j); \
+        } \
+        count -= seg; coords[ndim - 1] = 0; \
+        for (int d = (int)ndim - 2; d >= 0; --d) { \
+            if (++coords[d] < domain_shape[d] || d == 0) break; \
+            coords[d] = 0; \
+        } \
+    } \
+}
+
+static void index_fill_vector(void* out, mf_dtype dtype, u32 count, u32 offset, u8 ndim, const u32* domain_shape) {
+    u32 coords[MF_MAX_DIMS];
+    for (int i = ndim - 1; i >= 0; --i) {
+        coords[i] = offset % domain_shape[i];
+        offset /= domain_shape[i];
+    }
+    if (dtype == MF_DTYPE_F32) MF_INDEX_FILL_VECTOR(f32)
+    else if (dtype == MF_DTYPE_I32) MF_INDEX_FILL_VECTOR(i32)
 }
 
 static void mf_generate_index_chunk(void* out_raw, mf_dtype dtype, u32 count, u32 job_offset, u8 axis, bool is_vector, u8 domain_ndim, const u32* domain_shape) {
-    u32 current_coords[MF_MAX_DIMS];
-    u32 temp_idx = job_offset;
-    for (int i = domain_ndim - 1; i >= 0; --i) {
-        current_coords[i] = temp_idx % domain_shape[i];
-        temp_idx /= domain_shape[i];
-    }
-    for (u32 e = 0; e < count; ++e) {
-        if (is_vector) {
-            for (u32 d = 0; d < domain_ndim; ++d) {
-                float val = (f32)current_coords[d];
-                if (dtype == MF_DTYPE_F32) ((f32*)out_raw)[e * domain_ndim + d] = val;
-                else if (dtype == MF_DTYPE_I32) ((i32*)out_raw)[e * domain_ndim + d] = (i32)current_coords[d];
+    if (count == 0) return;
+    if (is_vector) {
+        if (domain_ndim > 0) index_fill_vector(out_raw, dtype, count, job_offset, domain_ndim, domain_shape);
+        return;
+    }
+    if (axis >= domain_ndim) {
+        if (dtype == MF_DTYPE_F32 || dtype == MF_DTYPE_I32) memset(out_raw, 0, (size_t)count * mf_dtype_size(dtype));
+        return;
+    }
+    u32 inner = 1;
+    for (u32 d = axis + 1; d < domain_ndim; ++d) inner *= domain_shape[d];
+    if (domain_shape[axis] == 0 || inner == 0) return;
+    index_fill_axis(out_raw, dtype, count, job_offset, domain_shape[axis], inner);
+}
+
+// --- Task Plans ---
+
+// Aliased registers follow the bound resource, dynamic ones the length their writer set
+static inline bool reg_follows_state(const mf_program* prog, u16 reg) {
+    return (prog->tensor_flags[reg] & (MF_TENSOR_FLAG_ALIAS | MF_TENSOR_FLAG_DYNAMIC)) != 0;
+}
+
+static inline const mf_type_info* plan_reg_info(const mf_program* prog, const mf_state* state, u16 reg) {
+    // Everything else is fixed by the program
+    if (state && reg_follows_state(prog, reg)) return &state->registers[reg].info;
+    return &prog->tensor_infos[reg];
+}
+
+static inline bool reg_is_index(const mf_program* prog, u16 reg) {
+    return (prog->tensor_flags[reg] & MF_TENSOR_FLAG_GENERATOR) && prog->builtin_ids[reg] == MF_BUILTIN_INDEX;
+}
+
+// Values generated per domain element: all coordinates for a vector index, else one
+static inline u32 index_width(const mf_type_info* info, u8 domain_ndim) {
+    return (info->ndim > domain_ndim) ? domain_ndim : 1;
+}
+
+static bool plan_is_current(const mf_cpu_task_plan* plan, const mf_program* prog, const mf_state* state, size_t total_elements) {
+    if (!plan->resolved || plan->total_elements != total_elements) return false;
+    const mf_task* task = plan->task;
+    for (u32 b = 0; b < task->binding_count; ++b) {
+        u16 reg = prog->bindings[task->binding_offset + b].reg_idx;
+        if (!reg_follows_state(prog, reg)) continue;
+        const mf_type_info* info = plan_reg_info(prog, state, reg);
+        if (mf_shape_calc_count(info->shape, info->ndim) != plan->reg_counts[b]) return false;
+    }
+    return true;
+}
+
+static inline u32 cpu_job_count(size_t total_elements, u32 job_size) {
+    return (u32)((total_elements + job_size - 1) / job_size);
+}
+
+// Times a run of the task goes over its tiles
+static inline u32 cpu_task_rounds(const mf_task* task) {
+    return task->strategy == MF_STRATEGY_SORT ? MF_SORT_ROUNDS : 1;
+}
+
+static inline u32 job_size_clamp(size_t size, u32 align) {
+    if (size < MF_CPU_JOB_MIN) size = MF_CPU_JOB_MIN;
+    if (size > MF_CPU_JOB_MAX) size = MF_CPU_JOB_MAX;
+    size = size / align * align;
+    return (u32)(size ? size : align);
+}
+
+/**
+ * Jobs of a MatMul or Inverse task cover whole output rows, so each runs the blocked
+ * kernel; with small matrices, whole groups of matrices for the batched kernels.
+ */
+static u32 plan_job_align(const mf_task* task, const mf_program* prog, const mf_type_info* domain) {
+    if (domain->ndim == 0 || domain->shape[domain->ndim - 1] <= 0) return MF_CPU_JOB_ALIGN;
+    for (u32 i = 0; i < task->inst_count; ++i) {
+        u16 opcode = prog->code[task->start_inst + i].opcode;
+        if (opcode != MF_OP_MATMUL && opcode != MF_OP_INVERSE) continue;
+        u32 row = (u32)domain->shape[domain->ndim - 1];
+        u32 plane = (domain->ndim > 1) ? row * (u32)domain->shape[domain->ndim - 2] : row;
+        return (plane <= MF_CPU_JOB_ALIGN) ? plane * MF_CPU_JOB_ALIGN : row;
+    }
+    return MF_CPU_JOB_ALIGN;
+}
+
+/**
+ * Big enough to amortize the per-job setup over the task's instructions, small enough
+ * for one job's registers to stay in L2 and for every thread to get a few jobs.
+ */
+static u32 plan_job_size(const mf_cpu_task_plan* plan, u32 footprint, size_t total_elements, int num_threads) {
+    const mf_task* task = plan->task;
+    size_t size = MF_CPU_JOB_CACHE_BYTES / (footprint ? footprint : 1);
+    size_t balance = total_elements / ((size_t)num_threads * MF_CPU_JOBS_PER_THREAD);
+    if (num_threads > 1 && balance < size) size = balance;
+    size_t work = MF_CPU_JOB_MIN_WORK / (task->inst_count ? task->inst_count : 1);
+    if (size < work) size = work;
+    return job_size_clamp(size, plan->job_align);
+}
+
+static void plan_tuner_reset(mf_cpu_task_plan* plan) {
+    u32 base = plan->job_size;
+    plan->tuner.sizes[0] = base;
+    plan->tuner.sizes[1] = job_size_clamp(base / 2, plan->job_align);
+    plan->tuner.sizes[2] = job_size_clamp((size_t)base * 2, plan->job_align);
+    for (u32 c = 0; c < MF_CPU_TUNE_CANDIDATES; ++c) plan->tuner.best[c] = -1.0;
+    plan->tuner.trial = 0;
+    plan->tuner.done = false;
+}
+
+// Called once per sampled run, from the thread that ended it
+static void plan_tuner_record(mf_cpu_task_plan* plan, f64 seconds, size_t total_elements) {
+    mf_cpu_job_tuner* tuner = &plan->tuner;
+    u32 c = tuner->trial % MF_CPU_TUNE_CANDIDATES;
+    f64 per_element = seconds / (f64)total_elements;
+    if (tuner->best[c] < 0 || per_element < tuner->best[c]) tuner->best[c] = per_element;
+
+    if (++tuner->trial < MF_CPU_TUNE_CANDIDATES * MF_CPU_TUNE_SAMPLES) {
+        plan->job_size = tuner->sizes[tuner->trial % MF_CPU_TUNE_CANDIDATES];
+        return;
+    }
+    u32 best = 0;
+    for (u32 i = 1; i < MF_CPU_TUNE_CANDIDATES; ++i) if (tuner->best[i] < tuner->best[best]) best = i;
+    plan->job_size = tuner->sizes[best];
+    tuner->done = true;
+}
+
+static inline bool inst_is_elementwise(u16 opcode) {
+    const mf_runtime_op_metadata* meta = mf_get_op_metadata(opcode);
+    return meta && meta->access == MF_ACCESS_LINEAR && (meta->category == MF_OP_CAT_ATOMIC || meta->category == MF_OP_CAT_SPECIAL);
+}
+
+/**
+ * Renumbers the task's instructions into its register window. Operands it does not
+ * bind (unused ports, left at register 0) get the empty slot past the bindings.
+ */
+static void plan_build_window(mf_cpu_task_plan* plan, const mf_program* prog) {
+    const mf_task* task = plan->task;
+    u16 local[MF_MAX_REGISTERS];
+    for (u32 r = 0; r < MF_MAX_REGISTERS; ++r) local[r] = (u16)task->binding_count;
+    for (u32 b = 0; b < task->binding_count; ++b) local[prog->bindings[task->binding_offset + b].reg_idx] = (u16)b;
+
+    for (u32 i = 0; i < task->inst_count; ++i) {
+        mf_instruction inst = prog->code[task->start_inst + i];
+        inst.dest_idx = local[inst.dest_idx];
+        inst.src1_idx = local[inst.src1_idx];
+        inst.src2_idx = local[inst.src2_idx];
+        inst.src3_idx = local[inst.src3_idx];
+        inst.src4_idx = local[inst.src4_idx];
+        plan->code[i] = inst;
+    }
+    for (u32 b = 0; b < task->binding_count; ++b) plan->reg_info[b] = prog->tensor_infos[prog->bindings[task->binding_offset + b].reg_idx];
+}
+
+/**
+ * Splits a task into runs of elementwise instructions and runs of everything else
+ * (reductions, gathers, scans, ...), which keep operating on the whole job.
+ * A single elementwise instruction gains nothing from strip-mining and joins its neighbours.
+ */
+static void plan_build_runs(mf_cpu_task_plan* plan, const mf_program* prog) {
+    const mf_task* task = plan->task;
+    plan->run_count = 0;
+    for (u32 i = 0; i < task->inst_count; ++i) {
+        bool elementwise = inst_is_elementwise(prog->code[task->start_inst + i].opcode);
+        mf_cpu_inst_run* last = plan->run_count ? &plan->runs[plan->run_count - 1] : NULL;
+        if (last && last->strip == elementwise) { last->count++; continue; }
+        plan->runs[plan->run_count++] = (mf_cpu_inst_run){ .start = i, .count = 1, .strip = elementwise };
+    }
+
+    u32 merged = 0;
+    for (u32 r = 0; r < plan->run_count; ++r) {
+        mf_cpu_inst_run run = plan->runs[r];
+        if (run.count < 2) run.strip = false;
+        if (merged > 0 && !run.strip && !plan->runs[merged - 1].strip) plan->runs[merged - 1].count += run.count;
+        else plan->runs[merged++] = run;
+    }
+    plan->run_count = merged;
+}
+
+// Sub-batch whose bound registers fit in L1, or 0 if the task has nothing to strip-mine
+static u32 plan_strip_size(const mf_cpu_task_plan* plan, u32 footprint, const mf_backend_cpu_state* cpu) {
+    if (cpu->strip_size < 0) return 0;
+    bool any = false;
+    for (u32 r = 0; r < plan->run_count; ++r) any |= plan->runs[r].strip;
+    if (!any) return 0;
+    if (cpu->strip_size > 0) return (u32)cpu->strip_size;
+
+    size_t size = MF_CPU_STRIP_CACHE_BYTES / (footprint ? footprint : 1);
+    if (size < MF_CPU_STRIP_MIN) size = MF_CPU_STRIP_MIN;
+    if (size > MF_CPU_STRIP_MAX) size = MF_CPU_STRIP_MAX;
+    return (u32)(size / MF_CPU_STRIP_MIN * MF_CPU_STRIP_MIN);
+}
+
+/**
+ * Whether every instruction reading an index register sits in a strip-mined run. The
+ * coordinates are then produced one sub-batch at a time, right before the run reads
+ * them, and a whole job's worth is never stored.
+ */
+static bool plan_index_in_strips(const mf_cpu_task_plan* plan, const mf_program* prog) {
+    const mf_task* task = plan->task;
+    for (u32 r = 0; r < plan->run_count; ++r) {
+        if (plan->runs[r].strip) continue;
+        for (u32 i = plan->runs[r].start; i < plan->runs[r].start + plan->runs[r].count; ++i) {
+            const mf_instruction* inst = &prog->code[task->start_inst + i];
+            const mf_runtime_op_metadata* meta = mf_get_op_metadata(inst->opcode);
+            const u16 srcs[4] = { inst->src1_idx, inst->src2_idx, inst->src3_idx, inst->src4_idx };
+            for (int k = 0; k < 4; ++k) {
+                // Unused operands are left at register 0
+                if (meta && !meta->ports[k]) continue;
+                if (reg_is_index(prog, srcs[k])) return false;
             }
-        } else {
-            float val = (axis < domain_ndim) ? (f32)current_coords[axis] : 0.0f;
-            if (dtype == MF_DTYPE_F32) ((f32*)out_raw)[e] = val;
-            else if (dtype == MF_DTYPE_I32) ((i32*)out_raw)[e] = (axis < domain_ndim) ? (i32)current_coords[axis] : 0;
-        }
-        for (int d = (int)domain_ndim - 1; d >= 0; --d) {
-            current_coords[d]++;
-            if (current_coords[d] < domain_shape[d] || d == 0) break;
-            current_coords[d] = 0;
         }
     }
+    return true;
+}
+
+// Scratch one job takes from the worker arena: the chunks of generated index registers
+static size_t plan_scratch_hint(const mf_cpu_task_plan* plan, const mf_program* prog, const mf_state* state, size_t total_elements) {
+    const mf_task* task = plan->task;
+    const mf_type_info* dom = plan_reg_info(prog, state, task->domain_reg);
+    size_t count = plan->job_size < total_elements ? plan->job_size : total_elements;
+    if (plan->strip_generators && count > plan->strip_size) count = plan->strip_size;
+    size_t bytes = 0;
+    for (u32 b = 0; b < task->binding_count; ++b) {
+        u16 reg = prog->bindings[task->binding_offset + b].reg_idx;
+        if (!reg_is_index(prog, reg)) continue;
+        const mf_type_info* info = plan_reg_info(prog, state, reg);
+        bytes += (count * index_width(info, dom->ndim) * mf_dtype_size(info->dtype) + 15) & ~(size_t)15;
+    }
+    return bytes;
+}
+
+/**
+ * Scan tasks keep one look-back status word per job, enough for the smallest job size
+ * the tuner may try. Grows only, so dispatch never allocates once shapes settle.
+ */
+static void plan_reserve_scan(mf_cpu_task_plan* plan, size_t total_elements) {
+    u32 job_size = plan->job_size;
+    for (u32 c = 0; !plan->tuner.done && c < MF_CPU_TUNE_CANDIDATES; ++c) {
+        if (plan->tuner.sizes[c] < job_size) job_size = plan->tuner.sizes[c];
+    }
+    u32 jobs = cpu_job_count(total_elements, job_size);
+    if (jobs <= plan->scan_capacity) return;
+    mf_atomic_i64* tiles = realloc(plan->scan_tiles, sizeof(mf_atomic_i64) * jobs);
+    if (!tiles) return; // The task then scans in one job
+    plan->scan_tiles = tiles;
+    plan->scan_capacity = jobs;
+}
+
+/**
+ * Sort tasks keep ping-pong key (and payload) buffers of the domain size and a status
+ * word per pass, tile and digit, for the plan's job size (sorts are not tuned). Grows
+ * only, like the scan tiles.
+ */
+static void plan_reserve_sort(mf_cpu_task_plan* plan, size_t total_elements) {
+    mf_sort_state* sort = &plan->sort;
+    if (!sort->histogram) {
+        sort->histogram = malloc(sizeof(mf_atomic_i32) * MF_SORT_PASSES * MF_SORT_RADIX);
+        sort->rounds_done = malloc(sizeof(mf_atomic_i32) * MF_SORT_ROUNDS);
+        if (!sort->histogram || !sort->rounds_done) return;
+    }
+    u32 tiles = cpu_job_count(total_elements, plan->job_size);
+    if (tiles > plan->sort_tiles) {
+        mf_atomic_i64* status = realloc(sort->status, sizeof(mf_atomic_i64) * MF_SORT_PASSES * MF_SORT_RADIX * tiles);
+        if (status) { sort->status = status; plan->sort_tiles = tiles; }
+    }
+    if (total_elements > plan->sort_capacity) {
+        // ArgSort and SortByKey carry a payload along with the keys
+        bool payload = plan->code[0].opcode != MF_OP_SORT;
+        u32* keys = realloc(sort->keys[0], sizeof(u32) * 2 * total_elements);
+        if (keys) sort->keys[0] = keys;
+        u32* values = payload ? realloc(sort->payload[0], sizeof(u32) * 2 * total_elements) : NULL;
+        if (values) sort->payload[0] = values;
+        if (!keys || (payload && !values)) return;
+        sort->keys[1] = keys + total_elements;
+        if (payload) sort->payload[1] = values + total_elements;
+        plan->sort_capacity = total_elements;
+    }
+}
+
+static void plan_free_sort(mf_cpu_task_plan* plan) {
+    free(plan->sort.histogram);
+    free(plan->sort.rounds_done);
+    free(plan->sort.status);
+    free(plan->sort.keys[0]);
+    free(plan->sort.payload[0]);
+}
+
+// A scatter (window numbering) into a target too large to copy per thread shares one partial
+static bool plan_scatter_shared(const mf_cpu_task_plan* plan, const mf_instruction* inst, int num_threads) {
+    size_t bytes = plan->reg_counts[inst->dest_idx] * mf_ops_scatter_slot_size(inst->opcode, plan->reg_info[inst->dest_idx].dtype);
+    return num_threads > 1 && bytes > MF_CPU_SCATTER_PRIVATE_BYTES;
+}
+
+static void plan_resolve(mf_cpu_task_plan* plan, const mf_cpu_baked_kernel* baked, const mf_state* state, size_t total_elements, const mf_backend_cpu_state* cpu) {
+    const mf_program* prog = baked->program;
+    const mf_task* task = plan->task;
+    i32 reg_strides[MF_MAX_REGISTERS] = {0};
+    u32 footprint = 0;
+    u8 domain_ndim = plan_reg_info(prog, state, task->domain_reg)->ndim;
+    const bool fast = baked->profile != MF_EXEC_PROFILE_SAFE;
+    const mf_op_func* table = fast ? cpu->op_table_fast : cpu->op_table;
+    int num_threads = cpu->pool ? mf_thread_pool_get_thread_count(cpu->pool) : 1;
+
+    // Under a Filter's domain only the compacted registers are as long as the domain,
+    // the rest keep the layout of the Filter's capacity
+    size_t layout_elements = total_elements;
+    if (prog->tensor_flags[task->domain_reg] & MF_TENSOR_FLAG_DYNAMIC) {
+        const mf_type_info* cap = &prog->tensor_infos[task->domain_reg];
+        layout_elements = mf_shape_calc_count(cap->shape, cap->ndim);
+    }
+
+    for (u32 b = 0; b < task->binding_count; ++b) {
+        const mf_bin_task_binding* bind = &prog->bindings[task->binding_offset + b];
+        const mf_type_info* info = plan_reg_info(prog, state, bind->reg_idx);
+        size_t count = mf_shape_calc_count(info->shape, info->ndim);
+        size_t layout = (prog->tensor_flags[bind->reg_idx] & MF_TENSOR_FLAG_DYNAMIC) ? total_elements : layout_elements;
+        i32 stride = mf_shape_calc_linear_stride(count, layout) * (i32)mf_dtype_size(info->dtype);
+
+        // Reductions accumulate into the running thread's accumulator, scatters write a partial target
+        if (bind->flags & (MF_BINDING_FLAG_REDUCTION | MF_BINDING_FLAG_SCATTER)) stride = 0;
+        // Indices are generated per job for this task's domain, whatever resource the register is bound to
+        else if (reg_is_index(prog, bind->reg_idx)) stride = (i32)(index_width(info, domain_ndim) * mf_dtype_size(info->dtype));
+
+        plan->reg_counts[b] = count;
+        plan->strides[b] = stride;
+        plan->reg_info[b] = *info;
+        reg_strides[bind->reg_idx] = stride;
+        footprint += (u32)(stride < 0 ? -stride : stride);
+    }
+
+    for (u32 i = 0; i < task->inst_count; ++i) {
+        const mf_instruction* inst = &prog->code[task->start_inst + i];
+        const i32 st[4] = { reg_strides[inst->dest_idx], reg_strides[inst->src1_idx], reg_strides[inst->src2_idx], reg_strides[inst->src3_idx] };
+        const mf_dtype dt[4] = {
+            plan_reg_info(prog, state, inst->dest_idx)->dtype, plan_reg_info(prog, state, inst->src1_idx)->dtype,
+            plan_reg_info(prog, state, inst->src2_idx)->dtype, plan_reg_info(prog, state, inst->src3_idx)->dtype };
+        // Non-f32 signatures bind their native kernel, f32 ones may pick a stride variant
+        mf_op_func fn = NULL;
+        if (task->strategy == MF_STRATEGY_SCATTER && plan_scatter_shared(plan, &plan->code[i], num_threads)) fn = mf_ops_find_atomic(inst->opcode);
+        if (!fn && cpu->pairwise_sum) fn = mf_ops_find_pairwise(inst->opcode, dt[1]);
+        if (!fn) fn = mf_ops_find_typed(inst->opcode, dt);
+        if (!fn) fn = fast ? mf_ops_find_specialized_fast(inst->opcode, st) : mf_ops_find_specialized(inst->opcode, st);
+        if (!fn) fn = table[inst->opcode];
+        // The run loop calls without checking (an opcode without kernel is a no-op)
+        plan->kernels[i] = fn ? fn : table[MF_OP_NOOP];
+    }
+
+    plan->footprint = footprint;
+    plan->job_align = plan_job_align(task, prog, plan_reg_info(prog, state, task->domain_reg));
+    plan->job_size = plan_job_size(plan, footprint, total_elements, num_threads);
+    if (task->strategy == MF_STRATEGY_SORT && plan->job_size < MF_CPU_SORT_JOB_MIN) plan->job_size = MF_CPU_SORT_JOB_MIN;
+    plan->strip_size = plan_strip_size(plan, footprint, cpu);
+    plan->strip_generators = plan->strip_size > 0 && plan_index_in_strips(plan, prog);
+    plan->scratch_hint = plan_scratch_hint(plan, prog, state, total_elements);
+    if (cpu->autotune && task->strategy != MF_STRATEGY_SORT) plan_tuner_reset(plan);
+    else plan->tuner.done = true;
+    if (task->strategy == MF_STRATEGY_SCAN) plan_reserve_scan(plan, total_elements);
+    if (task->strategy == MF_STRATEGY_SORT) plan_reserve_sort(plan, total_elements);
+
+    plan->total_elements = total_elements;
+    plan->resolved = true;
+}
+
+// --- Register Preparation ---
+
+// Partial target of thread tid for a scatter register of the task
+static u8* scatter_partial(const mf_cpu_baked_kernel* baked, u32 task_idx, u16 reg, int tid) {
+    for (u32 s = 0; s < baked->scatter_count; ++s) {
+        const mf_cpu_scatter* sc = &baked->scatters[s];
+        if (sc->task == task_idx && sc->reg == reg) return sc->partials ? sc->partials + (sc->shared ? 0 : (size_t)tid * sc->stride) : NULL;
+    }
+    return NULL;
+}
+
+// Accumulators of thread tid for a reduction register of the task
+static mf_reduce_acc* reduction_acc(const mf_cpu_baked_kernel* baked, u32 task_idx, u16 reg, int tid) {
+    for (u32 r = 0; r < baked->reduction_count; ++r) {
+        const mf_cpu_reduction* red = &baked->reductions[r];
+        if (red->task == task_idx && red->reg == reg) return &baked->reduction_accs[(size_t)tid * baked->reduction_stride + red->offset];
+    }
+    return NULL;
 }
 
 static void prepare_registers(mf_backend_cpu_worker_state* state, const mf_cpu_parallel_batch* batch, size_t start_idx, size_t count) {
@@ -234,70 +858,145 @@ static void prepare_registers(mf_backend_cpu_worker_state* state, const mf_cpu_p
     int tid = state->thread_idx;
     const mf_task* task = batch->current_task;
     const mf_program* prog = batch->program;
+    const mf_cpu_task_plan* plan = batch->plan;
+
+    // Window slot b is binding b; strides and metadata are the plan's, only pointers are per job
+    mf_exec_ctx_set_window(ctx, state->reg_ptrs, plan->strides, plan->reg_info, plan->window);
+    ctx->reg_ptrs[task->binding_count] = NULL;
 
     for (u32 b = 0; b < task->binding_count; ++b) {
         const mf_bin_task_binding* bind = &prog->bindings[task->binding_offset + b];
         u16 i = bind->reg_idx;
         
-        ctx->reg_info[i] = prog->tensor_infos[i];
-        
-        // For dynamic resources (aliased), we must update the info to match the bound resource
         mf_tensor* t = &batch->main_state->registers[i];
         uint8_t flags = prog->tensor_flags[i];
-        
-        if (flags & MF_TENSOR_FLAG_ALIAS) {
-            ctx->reg_info[i] = t->info;
-        }
-
-        // DYNAMIC STRIDE CALCULATION
-        // The baked bind->byte_stride is only valid if shapes haven't changed.
-        // We recalculate it based on current info and batch total elements.
-        size_t reg_elements = mf_shape_calc_count(ctx->reg_info[i].shape, ctx->reg_info[i].ndim);
-        i32 elem_stride = mf_shape_calc_linear_stride(reg_elements, batch->total_elements);
-        ctx->reg_strides[i] = elem_stride * (i32)mf_dtype_size(ctx->reg_info[i].dtype);
+        const mf_type_info* info = &ctx->reg_info[b];
+        ctx->reg_ptrs[b] = NULL;
 
-        if (batch->reduction_scratch && (bind->flags & MF_BINDING_FLAG_REDUCTION)) {
-            ctx->reg_ptrs[i] = &batch->reduction_scratch[tid * batch->reduction_scratch_per_thread + i];
-            ctx->reg_strides[i] = 0;
+        if (bind->flags & MF_BINDING_FLAG_REDUCTION) {
+            ctx->reg_ptrs[b] = reduction_acc(batch->baked, (u32)(task - prog->tasks), i, tid);
+            continue;
+        }
+        if (bind->flags & MF_BINDING_FLAG_SCATTER) {
+            ctx->reg_ptrs[b] = scatter_partial(batch->baked, (u32)(task - prog->tasks), i, tid);
             continue;
         }
 
         if (flags & MF_TENSOR_FLAG_GENERATOR) {
             mf_builtin_id bid = (mf_builtin_id)prog->builtin_ids[i];
             if (bid == MF_BUILTIN_INDEX) {
-                bool is_vector = (ctx->reg_info[i].ndim > batch->ndim);
-                size_t vec_size = is_vector ? (size_t)ctx->reg_info[i].shape[ctx->reg_info[i].ndim - 1] : 1;
-                size_t bytes = count * vec_size * mf_dtype_size(ctx->reg_info[i].dtype);
+                bool is_vector = (info->ndim > batch->ndim);
+                // Strip-mined runs fill one sub-batch of indices at a time (cpu_exec_strips)
+                bool per_strip = plan->strip_generators && count > plan->strip_size;
+                size_t gen_count = per_strip ? plan->strip_size : count;
+                size_t bytes = gen_count * index_width(info, batch->ndim) * mf_dtype_size(info->dtype);
                 void* mem = mf_exec_ctx_scratch_alloc(ctx, bytes);
                 if (mem) {
-                    mf_generate_index_chunk(mem, ctx->reg_info[i].dtype, (u32)count, (u32)start_idx, prog->builtin_axes[i], is_vector, batch->ndim, batch->domain_shape);
-                    ctx->reg_ptrs[i] = mem;
+                    if (!per_strip) mf_generate_index_chunk(mem, info->dtype, (u32)gen_count, (u32)start_idx, prog->builtin_axes[i], is_vector, batch->ndim, batch->domain_shape);
+                    ctx->reg_ptrs[b] = mem;
                 }
             }
         } else {
             // Buffer-based (Symbol, Constant, or Scratch)
             if (t->buffer && t->buffer->data) {
-                ctx->reg_ptrs[i] = (u8*)t->buffer->data + t->byte_offset + (start_idx * ctx->reg_strides[i]);
-            } else {
-                ctx->reg_ptrs[i] = NULL;
-                if (ctx->error == MF_ERROR_NONE) {
-                    MF_LOG_ERROR("Backend: Reg %u (%s) has NULL buffer data (Flags: 0x%X)", i, find_reg_name(prog, i), flags);
-                    ctx->error = MF_ERROR_RUNTIME;
-                }
+                ctx->reg_ptrs[b] = (u8*)t->buffer->data + t->byte_offset + (start_idx * ctx->reg_strides[b]);
+            } else if (ctx->error == MF_ERROR_NONE) {
+                MF_LOG_ERROR("Backend: Reg %u (%s) has NULL buffer data (Flags: 0x%X)", i, find_reg_name(prog, i), flags);
+                ctx->error = MF_ERROR_RUNTIME;
+            }
+        }
+    }
+}
+
+/**
+ * Runs an elementwise instruction run over the job in sub-batches of plan->strip_size,
+ * so intermediates written by one instruction are still in L1 when the next reads them.
+ */
+static bool cpu_exec_strips(mf_backend_cpu_worker_state* state, const mf_cpu_parallel_batch* batch, const mf_cpu_inst_run* run, size_t start_idx, u32 count) {
+    mf_exec_ctx* ctx = &state->ctx;
+    const mf_cpu_task_plan* plan = batch->plan;
+    const mf_task* task = batch->current_task;
+    const mf_program* prog = batch->program;
+    u8* base[MF_MAX_REGISTERS];
+    bool alive = true;
+
+    for (u32 b = 0; b < task->binding_count; ++b) base[b] = (u8*)ctx->reg_ptrs[b];
+
+    for (u32 offset = 0; offset < count; offset += plan->strip_size) {
+        u32 n = count - offset < plan->strip_size ? count - offset : plan->strip_size;
+        for (u32 b = 0; b < task->binding_count; ++b) {
+            u16 reg = prog->bindings[task->binding_offset + b].reg_idx;
+            if (plan->strip_generators && reg_is_index(prog, reg)) {
+                if (!base[b]) continue;
+                bool is_vector = (ctx->reg_info[b].ndim > batch->ndim);
+                mf_generate_index_chunk(base[b], ctx->reg_info[b].dtype, n, (u32)(start_idx + offset), prog->builtin_axes[reg], is_vector, batch->ndim, batch->domain_shape);
+            } else if (base[b]) {
+                ctx->reg_ptrs[b] = base[b] + (ptrdiff_t)offset * ctx->reg_strides[b];
             }
         }
+        ctx->batch_size = n;
+        ctx->linear_offset = (u32)(start_idx + offset);
+        if (!(alive = mf_cpu_exec(ctx, batch, run->start, run->count))) break;
+    }
+
+    for (u32 b = 0; b < task->binding_count; ++b) ctx->reg_ptrs[b] = base[b];
+    ctx->batch_size = count;
+    ctx->linear_offset = (u32)start_idx;
+    return alive;
+}
+
+/**
+ * FAST_CHECKED profile: looks for NaN/Inf in what the job wrote to its f32 registers.
+ * A hit stops the run like a kernel error, blamed on the last instruction writing that register.
+ */
+static void cpu_check_finite(mf_exec_ctx* ctx, const mf_cpu_parallel_batch* batch, u32 count) {
+    const mf_task* task = batch->current_task;
+    const mf_program* prog = batch->program;
+    for (u32 b = 0; b < task->binding_count; ++b) {
+        const mf_bin_task_binding* bind = &prog->bindings[task->binding_offset + b];
+        u16 reg = bind->reg_idx;
+        if (!(bind->flags & MF_BINDING_FLAG_WRITE) || (bind->flags & (MF_BINDING_FLAG_REDUCTION | MF_BINDING_FLAG_SCATTER))) continue;
+        // Filter outputs are only written up to their survivor count
+        if (prog->tensor_flags[reg] & MF_TENSOR_FLAG_DYNAMIC) continue;
+        if (ctx->reg_info[b].dtype != MF_DTYPE_F32 || !ctx->reg_ptrs[b] || ctx->reg_strides[b] < 0) continue;
+
+        // Floats per domain element; a stride of 0 is a register written whole by every job
+        size_t lanes = (size_t)ctx->reg_strides[b] / sizeof(f32);
+        size_t n = lanes ? (size_t)count * lanes : mf_shape_calc_count(ctx->reg_info[b].shape, ctx->reg_info[b].ndim);
+        size_t hit = mf_ops_find_nonfinite((const f32*)ctx->reg_ptrs[b], n);
+        if (hit == n) continue;
+
+        u32 inst = task->inst_count - 1;
+        for (u32 i = task->inst_count; i-- > 0;) {
+            if (prog->code[task->start_inst + i].dest_idx == reg) { inst = i; break; }
+        }
+        ctx->error = MF_ERROR_NON_FINITE;
+        ctx->error_idx = lanes ? (u32)(hit / lanes) : 0;
+        report_crash(ctx, batch, inst);
+        return;
     }
 }
 
 static void cpu_worker_job(u32 job_idx, void* thread_local_data, void* user_data) {
     mf_backend_cpu_worker_state* state = (mf_backend_cpu_worker_state*)thread_local_data;
     mf_cpu_parallel_batch* batch = (mf_cpu_parallel_batch*)user_data;
-    size_t start_idx = (size_t)job_idx * MF_CPU_JOB_SIZE;
-    size_t count = MF_CPU_JOB_SIZE;
+    // Scan tiles go out in start order: a tile only ever waits on tiles already running
+    if (batch->scan_tiles || batch->sort) job_idx = (u32)mf_atomic_add(&batch->scan_next, 1) - 1;
+    // Sort rounds: every round covers all tiles, and starts after the one before
+    u32 round = 0;
+    if (batch->rounds > 1) {
+        u32 tiles = cpu_job_count(batch->total_elements, batch->job_size);
+        round = job_idx / tiles;
+        job_idx %= tiles;
+    }
+    size_t start_idx = (size_t)job_idx * batch->job_size;
+    size_t count = batch->job_size;
     if (start_idx + count > batch->total_elements) count = batch->total_elements - start_idx;
     if (count == 0) return;
     
+    const mf_cpu_task_plan* plan = batch->plan;
     mf_arena_reset(&state->temp_arena);
+    mf_arena_commit(&state->temp_arena, plan->scratch_hint);
     mf_exec_ctx_init(&state->ctx, (mf_allocator*)&state->temp_arena);
     
     state->ctx.batch_size = (u32)count;
@@ -305,8 +1004,9 @@ static void cpu_worker_job(u32 job_idx, void* thread_local_data, void* user_data
     if (batch->main_state) state->ctx.global_error_ptr = batch->main_state->global_error_ptr ? batch->main_state->global_error_ptr : &batch->main_state->error_code;
     state->ctx.linear_offset = (u32)start_idx;
     state->ctx.job_idx = job_idx;
-    state->ctx.sync_pass = batch->sync_pass;
-    state->ctx.sync_data = batch->sync_data;
+    state->ctx.scan_tiles = batch->scan_tiles;
+    state->ctx.sort = batch->sort;
+    state->ctx.job_round = round;
 
     // Coordinate decomposition
     if (batch->ndim > 1) {
@@ -323,133 +1023,898 @@ static void cpu_worker_job(u32 job_idx, void* thread_local_data, void* user_data
     for(int d=0; d<batch->ndim; ++d) state->ctx.domain_shape[d] = batch->domain_shape[d];
     
     prepare_registers(state, batch, start_idx, count);
-    mf_cpu_exec(&state->ctx, batch, batch->inst_count);
+    // The kill switch is polled once per job here; kernels themselves only return codes
+    bool alive = state->ctx.error == MF_ERROR_NONE && !cpu_killed(&state->ctx, batch);
+    for (u32 r = 0; alive && r < plan->run_count; ++r) {
+        const mf_cpu_inst_run* run = &plan->runs[r];
+        if (run->strip && plan->strip_size > 0 && count > plan->strip_size) alive = cpu_exec_strips(state, batch, run, start_idx, (u32)count);
+        else alive = mf_cpu_exec(&state->ctx, batch, run->start, run->count);
+    }
+    // A sort's dest is complete only after its last round, and holds values of its input anyway
+    if (batch->check_finite && alive && !batch->sort) cpu_check_finite(&state->ctx, batch, (u32)count);
+
+    // High-water mark of the task's scratch (the arena only grows within a job)
+    mf_atomic_i32* peak = (mf_atomic_i32*)&plan->scratch_peak;
+    int32_t used = (int32_t)state->temp_arena.pos;
+    for (int32_t seen = mf_atomic_load(peak); used > seen; seen = mf_atomic_load(peak)) {
+        if (mf_atomic_cas(peak, seen, used)) break;
+    }
     
     if (state->ctx.error != MF_ERROR_NONE && batch->main_state) {
         mf_atomic_store(&batch->main_state->error_code, (int32_t)state->ctx.error);
     }
 }
 
-static void mf_backend_cpu_dispatch_batch(mf_backend_cpu_state* state, mf_cpu_parallel_batch* batch, const mf_task* task) {
-    if (task->inst_count == 0) return;
-    batch->current_task = task;
-    batch->start_inst = task->start_inst;
-    batch->inst_count = task->inst_count;
-    u32 total_jobs = (u32)((batch->total_elements + MF_CPU_JOB_SIZE - 1) / MF_CPU_JOB_SIZE);
-    if (batch->total_elements <= MF_CPU_INLINE_THRESHOLD || total_jobs == 1) {
-        mf_backend_cpu_worker_state local_worker;
-        _Alignas(16) u8 local_heap[MF_MB(4)]; 
-        local_worker.thread_idx = 0; local_worker.heap_mem = local_heap; local_worker.heap_size = sizeof(local_heap);
-        mf_arena_init(&local_worker.temp_arena, local_worker.heap_mem, local_worker.heap_size);
-        cpu_worker_job(0, &local_worker, batch);
-    } else if (state->pool) mf_thread_pool_run(state->pool, total_jobs, cpu_worker_job, batch);
+static void mf_backend_cpu_dispatch_batch(mf_backend_cpu_state* state, mf_cpu_parallel_batch* batch, mf_backend_cpu_worker_state* worker) {
+    u32 total_jobs = cpu_job_count(batch->total_elements, batch->job_size);
+    if (total_jobs == 1) {
+        // Already on a pool thread (task graph): reuse its worker state, else borrow the caller's slot.
+        // A single-tile sort runs its rounds one after another.
+        for (u32 r = 0; r < batch->rounds; ++r) {
+            if (worker) cpu_worker_job(r, worker, batch);
+            else if (state->pool) mf_thread_pool_run_local(state->pool, cpu_worker_job, batch);
+        }
+    } else if (state->pool) mf_thread_pool_run(state->pool, total_jobs * batch->rounds, cpu_worker_job, batch);
+}
+
+/**
+ * Lists the program's reductions and gives every thread one accumulator per element
+ * of each reduction register (a single one for whole-stream reductions). A thread's
+ * block is rounded up to whole cache lines and starts on one, so the accumulators
+ * jobs keep writing to are never on a line another thread writes.
+ */
+static void bake_reductions(mf_cpu_baked_kernel* baked, mf_backend_cpu_state* state) {
+    const mf_program* prog = baked->program;
+    u32 count = 0;
+    u32 acc_count = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (u32 t = 0; t < prog->meta.task_count; ++t) {
+            const mf_task* task = &prog->tasks[t];
+            if (task->strategy != MF_STRATEGY_REDUCTION) continue;
+            for (u32 i = 0; i < task->inst_count; ++i) {
+                const mf_instruction* inst = &prog->code[task->start_inst + i];
+                bool reduces = false;
+                for (u32 b = 0; b < task->binding_count; ++b) {
+                    const mf_bin_task_binding* bind = &prog->bindings[task->binding_offset + b];
+                    if (bind->reg_idx == inst->dest_idx) { reduces = (bind->flags & MF_BINDING_FLAG_REDUCTION) != 0; break; }
+                }
+                if (!reduces) continue;
+                if (pass == 1) {
+                    const mf_type_info* info = &prog->tensor_infos[inst->dest_idx];
+                    size_t slots = mf_shape_calc_count(info->shape, info->ndim);
+                    if (slots == 0) slots = 1;
+                    baked->reductions[baked->reduction_count++] = (mf_cpu_reduction){
+                        .task = t, .inst = i, .reg = inst->dest_idx, .opcode = inst->opcode, .offset = acc_count, .slots = (u32)slots };
+                    acc_count += (u32)slots;
+                }
+                else count++;
+            }
+        }
+        if (pass == 0) {
+            if (count == 0) return;
+            baked->reductions = malloc(sizeof(mf_cpu_reduction) * count);
+            if (!baked->reductions) return;
+        }
+    }
+
+    int num_threads = state->pool ? mf_thread_pool_get_thread_count(state->pool) : 1;
+    const size_t per_line = MF_CPU_CACHE_LINE / sizeof(mf_reduce_acc);
+    baked->reduction_stride = (u32)((acc_count + per_line - 1) / per_line * per_line);
+    baked->reduction_mem = calloc(1, sizeof(mf_reduce_acc) * baked->reduction_stride * (size_t)num_threads + MF_CPU_CACHE_LINE);
+    if (!baked->reduction_mem) { baked->reduction_count = 0; return; }
+    uintptr_t base = ((uintptr_t)baked->reduction_mem + MF_CPU_CACHE_LINE - 1) & ~(uintptr_t)(MF_CPU_CACHE_LINE - 1);
+    baked->reduction_accs = (mf_reduce_acc*)base;
+}
+
+/**
+ * Sizes a scatter's partials for the plan's target: one per thread, or a single shared
+ * one if the plan's kernel writes with atomics. Only grows.
+ */
+static bool scatter_reserve(mf_cpu_scatter* sc, const mf_cpu_task_plan* plan, int num_threads) {
+    const mf_instruction* inst = &plan->code[sc->inst];
+    const mf_type_info* info = &plan->reg_info[inst->dest_idx];
+    size_t count = mf_shape_calc_count(info->shape, info->ndim);
+    if (plan->reg_counts[inst->dest_idx] > count) count = plan->reg_counts[inst->dest_idx];
+    size_t bytes = count * mf_ops_scatter_slot_size(sc->opcode, info->dtype);
+
+    sc->shared = plan_scatter_shared(plan, inst, num_threads);
+    sc->stride = (bytes + MF_CPU_CACHE_LINE - 1) / MF_CPU_CACHE_LINE * MF_CPU_CACHE_LINE;
+    size_t needed = sc->stride * (sc->shared ? 1 : (size_t)num_threads);
+    if (needed <= sc->capacity && sc->partials) return true;
+
+    free(sc->mem);
+    sc->mem = malloc(needed + MF_CPU_CACHE_LINE);
+    sc->partials = NULL;
+    sc->capacity = 0;
+    if (!sc->mem) return false;
+    sc->partials = (u8*)(((uintptr_t)sc->mem + MF_CPU_CACHE_LINE - 1) & ~(uintptr_t)(MF_CPU_CACHE_LINE - 1));
+    sc->capacity = needed;
+    return true;
+}
+
+// Lists the program's scatters; partials of static targets are reserved right away
+static void bake_scatters(mf_cpu_baked_kernel* baked, mf_backend_cpu_state* state) {
+    const mf_program* prog = baked->program;
+    u32 count = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (u32 t = 0; t < prog->meta.task_count; ++t) {
+            const mf_task* task = &prog->tasks[t];
+            if (task->strategy != MF_STRATEGY_SCATTER) continue;
+            for (u32 i = 0; i < task->inst_count; ++i) {
+                const mf_instruction* inst = &prog->code[task->start_inst + i];
+                if (inst->opcode != MF_OP_SCATTER && inst->opcode != MF_OP_SCATTER_ADD) continue;
+                if (pass == 1) {
+                    baked->scatters[baked->scatter_count++] = (mf_cpu_scatter){
+                        .task = t, .inst = i, .reg = inst->dest_idx, .base = inst->src3_idx, .opcode = inst->opcode };
+                }
+                else count++;
+            }
+        }
+        if (pass == 0) {
+            if (count == 0) return;
+            baked->scatters = calloc(count, sizeof(mf_cpu_scatter));
+            if (!baked->scatters) return;
+        }
+    }
+
+    int num_threads = state->pool ? mf_thread_pool_get_thread_count(state->pool) : 1;
+    for (u32 s = 0; s < baked->scatter_count; ++s) {
+        mf_cpu_scatter* sc = &baked->scatters[s];
+        if (baked->plans[sc->task].resolved) scatter_reserve(sc, &baked->plans[sc->task], num_threads);
+    }
 }
 
 static void* mf_backend_cpu_bake(void* backend_state, const struct mf_program* program) {
     mf_backend_cpu_state* state = (mf_backend_cpu_state*)backend_state;
     mf_cpu_baked_kernel* baked = calloc(1, sizeof(mf_cpu_baked_kernel));
     baked->program = program;
+    // The engine's profile wins over the program's own; neither set means SAFE
+    baked->profile = state->profile != MF_EXEC_PROFILE_DEFAULT ? state->profile : (mf_exec_profile)program->meta.exec_profile;
+    if (baked->profile == MF_EXEC_PROFILE_DEFAULT || baked->profile >= MF_EXEC_PROFILE_COUNT) baked->profile = MF_EXEC_PROFILE_SAFE;
+    baked->poll_interval = state->poll_interval;
+    baked->next = state->baked_list;
+    state->baked_list = baked;
 
-    // Scratchpad allocation
-    int num_threads = state->pool ? mf_thread_pool_get_thread_count(state->pool) : 1;
-    if (program->meta.reduction_scratch_size > 0 && num_threads > 1) {
-        baked->reduction_scratch_size = num_threads * program->meta.reduction_scratch_size;
-        baked->reduction_scratch = calloc(baked->reduction_scratch_size, sizeof(f32));
+    u32 task_count = program->meta.task_count;
+    bake_reductions(baked, state);
+
+    // Execution plans: one block for all tasks, resolved against the declared shapes
+    // (no resources are bound yet). Dispatch re-resolves a plan in place if the bound
+    // resources turn out to have a different size (see mf_backend_cpu_resize).
+    size_t total_bindings = 0, total_insts = 0;
+    for (u32 t = 0; t < task_count; ++t) {
+        total_bindings += program->tasks[t].binding_count;
+        total_insts += program->tasks[t].inst_count;
+    }
+    size_t total_deps = program->meta.task_dep_count;
+    size_t total_window = total_bindings + task_count;
+    size_t plan_bytes = sizeof(mf_cpu_task_plan) * task_count + sizeof(mf_op_func) * total_insts + 
+                        sizeof(mf_type_info) * total_window + sizeof(mf_instruction) * total_insts +
+                        sizeof(size_t) * total_bindings + sizeof(i32) * total_window + sizeof(u32) * (2 * total_deps + task_count) +
+                        sizeof(mf_cpu_inst_run) * total_insts;
+    u8* mem = calloc(1, plan_bytes > 0 ? plan_bytes : 1);
+    baked->plans = (mf_cpu_task_plan*)mem;
+    mf_op_func* kernels = (mf_op_func*)(mem + sizeof(mf_cpu_task_plan) * task_count);
+    mf_type_info* infos = (mf_type_info*)(kernels + total_insts);
+    mf_instruction* code = (mf_instruction*)(infos + total_window);
+    size_t* counts = (size_t*)(code + total_insts);
+    i32* strides = (i32*)(counts + total_bindings);
+    u32* successors = (u32*)(strides + total_window);
+    u32* ready = successors + total_deps;
+    baked->roots = ready + total_deps;
+    mf_cpu_inst_run* runs = (mf_cpu_inst_run*)(baked->roots + task_count);
+    baked->remaining = (task_count > 0) ? calloc(task_count, sizeof(mf_atomic_i32)) : NULL;
+
+    // Invert the dependency lists into successor lists
+    for (u32 t = 0; t < task_count; ++t) {
+        const mf_task* task = &program->tasks[t];
+        for (u32 d = 0; d < task->dep_count; ++d) baked->plans[program->task_deps[task->dep_offset + d]].successor_count++;
+        if (task->dep_count == 0) baked->roots[baked->root_count++] = t;
+    }
+
+    for (u32 t = 0; t < task_count; ++t) {
+        mf_cpu_task_plan* plan = &baked->plans[t];
+        const mf_task* task = &program->tasks[t];
+        plan->task = task;
+        plan->kernels = kernels; kernels += task->inst_count;
+        plan->window = task->binding_count + 1;
+        plan->reg_info = infos; infos += plan->window;
+        plan->code = code; code += task->inst_count;
+        plan->reg_counts = counts; counts += task->binding_count;
+        plan->strides = strides; strides += plan->window;
+        plan_build_window(plan, program);
+        plan->successors = successors; successors += plan->successor_count;
+        plan->ready = ready; ready += plan->successor_count;
+        plan->successor_count = 0; // Refilled below
+        plan->runs = runs; runs += task->inst_count;
+        plan_build_runs(plan, program);
+
+        const mf_type_info* dom = &program->tensor_infos[task->domain_reg];
+        bool is_static = true;
+        for (int d = 0; d < dom->ndim; ++d) if (dom->shape[d] < 0) is_static = false;
+        if (is_static) plan_resolve(plan, baked, NULL, mf_shape_calc_count(dom->shape, dom->ndim), state);
     }
 
-    if (program->meta.sync_scratch_size > 0) {
-        baked->sync_scratch_size = program->meta.sync_scratch_size;
-        baked->sync_scratch = calloc(baked->sync_scratch_size, sizeof(f32));
+    for (u32 t = 0; t < task_count; ++t) {
+        const mf_task* task = &program->tasks[t];
+        for (u32 d = 0; d < task->dep_count; ++d) {
+            mf_cpu_task_plan* dep = &baked->plans[program->task_deps[task->dep_offset + d]];
+            dep->successors[dep->successor_count++] = t;
+        }
     }
 
+    bake_scatters(baked, state);
     return baked;
 }
 
 static void mf_backend_cpu_free_baked(void* backend_state, void* baked_data) {
-    (void)backend_state;
+    mf_backend_cpu_state* state = (mf_backend_cpu_state*)backend_state;
     mf_cpu_baked_kernel* baked = (mf_cpu_baked_kernel*)baked_data;
     if (baked) {
-        if (baked->reduction_scratch) free(baked->reduction_scratch);
-        if (baked->sync_scratch) free(baked->sync_scratch);
+        for (mf_cpu_baked_kernel** link = &state->baked_list; *link; link = &(*link)->next) {
+            if (*link == baked) { *link = baked->next; break; }
+        }
+        free(baked->reductions);
+        free(baked->reduction_mem);
+        for (u32 s = 0; s < baked->scatter_count; ++s) free(baked->scatters[s].mem);
+        free(baked->scatters);
+        for (u32 t = 0; t < baked->program->meta.task_count; ++t) {
+            free(baked->plans[t].scan_tiles);
+            plan_free_sort(&baked->plans[t]);
+        }
+        free(baked->remaining);
+        free(baked->plans);
         free(baked);
     }
 }
 
-static void mf_backend_cpu_dispatch(void* backend_state, const struct mf_program* program, struct mf_state* main_state, const mf_tensor* domain, uint32_t start_inst, uint32_t inst_count) {
-    mf_backend_cpu_state* state = (mf_backend_cpu_state*)backend_state;
-    mf_cpu_baked_kernel* baked = (mf_cpu_baked_kernel*)main_state->baked_data;
-    if (!domain || !baked) return;
+// Re-plans the tasks whose bound shapes changed, so their scratch grows before the frame
+static void mf_backend_cpu_resize(void* backend_state, const struct mf_program* program, mf_state* state) {
+    mf_cpu_baked_kernel* baked = (mf_cpu_baked_kernel*)state->baked_data;
+    if (!baked) return;
+    for (u32 t = 0; t < program->meta.task_count; ++t) {
+        mf_cpu_task_plan* plan = &baked->plans[t];
+        size_t total_elements = mf_tensor_count(&state->registers[program->tasks[t].domain_reg]);
+        if (total_elements > 0 && !plan_is_current(plan, program, state, total_elements)) {
+            plan_resolve(plan, baked, state, total_elements, (const mf_backend_cpu_state*)backend_state);
+        }
+    }
+}
+
+// --- Task Dispatch ---
+
+/**
+ * Dynamic registers written by a task (Filter outputs): the writer sees their full
+ * capacity (length < 0), the readers only the length it ends up with.
+ * Returns false if the task writes none.
+ */
+static bool cpu_task_set_lengths(const mf_program* prog, mf_state* main_state, const mf_task* task, int32_t length) {
+    bool found = false;
+    for (u32 b = 0; b < task->binding_count; ++b) {
+        const mf_bin_task_binding* bind = &prog->bindings[task->binding_offset + b];
+        if (!(bind->flags & MF_BINDING_FLAG_WRITE) || !(prog->tensor_flags[bind->reg_idx] & MF_TENSOR_FLAG_DYNAMIC)) continue;
+        mf_type_info* info = &main_state->registers[bind->reg_idx].info;
+        if (length >= 0) mf_type_info_init_contiguous(info, info->dtype, &length, 1);
+        else *info = prog->tensor_infos[bind->reg_idx];
+        found = true;
+    }
+    return found;
+}
+
+/**
+ * Sets up one run of a task: resolves its plan, clears its reduction slots, scatter
+ * partials and scan tiles. Returns false if there is nothing to run.
+ */
+static bool cpu_task_begin(mf_backend_cpu_state* state, mf_cpu_baked_kernel* baked, mf_state* main_state, u32 task_idx, mf_cpu_parallel_batch* batch) {
+    const mf_program* program = baked->program;
+    const mf_task* target_task = &program->tasks[task_idx];
+    mf_cpu_task_plan* plan = &baked->plans[task_idx];
+    const mf_tensor* domain = &main_state->registers[target_task->domain_reg];
+
+    bool dynamic = cpu_task_set_lengths(program, main_state, target_task, -1);
     size_t total_elements = mf_tensor_count(domain);
-    if (total_elements == 0) return;
+    if (total_elements == 0 || target_task->inst_count == 0) {
+        if (dynamic) cpu_task_set_lengths(program, main_state, target_task, 0);
+        return false;
+    }
     int num_threads = state->pool ? mf_thread_pool_get_thread_count(state->pool) : 1;
-    mf_cpu_parallel_batch batch = {
-        .program = program, .main_state = main_state, .op_table = state->op_table,
+    *batch = (mf_cpu_parallel_batch){
+        .program = program, .main_state = main_state,
+        .current_task = target_task, .start_inst = target_task->start_inst, .inst_count = target_task->inst_count,
         .total_elements = total_elements, .ndim = domain->info.ndim, .num_threads = num_threads,
-        .reduction_scratch = baked->reduction_scratch, .reduction_scratch_per_thread = program->meta.reduction_scratch_size
+        .baked = baked, .rounds = cpu_task_rounds(target_task),
+        .check_finite = baked->profile == MF_EXEC_PROFILE_FAST_CHECKED, .poll_interval = baked->poll_interval
     };
-    memcpy(batch.domain_shape, domain->info.shape, sizeof(u32) * MF_MAX_DIMS);
+    memcpy(batch->domain_shape, domain->info.shape, sizeof(u32) * MF_MAX_DIMS);
+
+    if (!plan_is_current(plan, program, main_state, total_elements)) {
+        plan_resolve(plan, baked, main_state, total_elements, state);
+    }
+    // For dynamic resources (aliased) and Filter outputs, the metadata jobs see follows the state
+    for (u32 b = 0; b < target_task->binding_count; ++b) {
+        u16 reg = program->bindings[target_task->binding_offset + b].reg_idx;
+        if (reg_follows_state(program, reg)) plan->reg_info[b] = main_state->registers[reg].info;
+    }
+    batch->plan = plan;
+    // Small tasks run inline as one job
+    batch->job_size = total_elements <= MF_CPU_INLINE_THRESHOLD ? (u32)total_elements : plan->job_size;
+    if (!plan->tuner.done) batch->start_time = mf_time_now();
+
+    // Only this task's accumulators are reset (other tasks may be in flight)
+    for (u32 r = 0; r < baked->reduction_count; ++r) {
+        const mf_cpu_reduction* red = &baked->reductions[r];
+        if (red->task != task_idx) continue;
+        mf_dtype src = plan->reg_info[plan->code[red->inst].src1_idx].dtype;
+        for (int t = 0; t < num_threads; ++t) {
+            mf_reduce_acc* accs = &baked->reduction_accs[(size_t)t * baked->reduction_stride + red->offset];
+            for (u32 s = 0; s < red->slots; ++s) mf_ops_reduce_init(red->opcode, src, &accs[s]);
+        }
+    }
+
+    for (u32 s = 0; s < baked->scatter_count; ++s) {
+        mf_cpu_scatter* sc = &baked->scatters[s];
+        if (sc->task != task_idx) continue;
+        if (!scatter_reserve(sc, plan, num_threads)) {
+            MF_LOG_ERROR("Backend: No memory for the partials of a scatter into reg %u", sc->reg);
+            mf_atomic_store(main_state->global_error_ptr ? main_state->global_error_ptr : &main_state->error_code, MF_ERROR_OOM);
+            return false;
+        }
+        memset(sc->partials, 0, sc->stride * (sc->shared ? 1 : (size_t)num_threads));
+    }
+
+    if (target_task->strategy == MF_STRATEGY_SCAN) {
+        // Tiles are sized when the plan resolves; should they still fall short, scan in one job
+        u32 total_jobs = cpu_job_count(total_elements, batch->job_size);
+        if (total_jobs > plan->scan_capacity) { batch->job_size = (u32)total_elements; total_jobs = 1; }
+        if (total_jobs <= plan->scan_capacity) {
+            for (u32 j = 0; j < total_jobs; ++j) mf_atomic_store64(&plan->scan_tiles[j], 0);
+            mf_atomic_store(&batch->scan_next, 0);
+            batch->scan_tiles = plan->scan_tiles;
+        } else if (dynamic) {
+            // A Filter learns its output length from the tiles alone
+            MF_LOG_ERROR("Backend: No scan tiles for a Filter of %zu elements", total_elements);
+            mf_atomic_store(main_state->global_error_ptr ? main_state->global_error_ptr : &main_state->error_code, MF_ERROR_OOM);
+            return false;
+        }
+    }
+
+    if (target_task->strategy == MF_STRATEGY_SORT) {
+        // Sized when the plan resolves, like the scan tiles; short of tiles, sort in one
+        mf_sort_state* sort = &plan->sort;
+        u32 tiles = cpu_job_count(total_elements, batch->job_size);
+        if (tiles > plan->sort_tiles) { batch->job_size = (u32)total_elements; tiles = 1; }
+        if (total_elements > plan->sort_capacity || !sort->status) {
+            MF_LOG_ERROR("Backend: No memory to sort %zu elements", total_elements);
+            mf_atomic_store(main_state->global_error_ptr ? main_state->global_error_ptr : &main_state->error_code, MF_ERROR_OOM);
+            return false;
+        }
+        sort->tile_count = tiles;
+        memset((void*)sort->histogram, 0, sizeof(mf_atomic_i32) * MF_SORT_PASSES * MF_SORT_RADIX);
+        memset((void*)sort->rounds_done, 0, sizeof(mf_atomic_i32) * MF_SORT_ROUNDS);
+        memset((void*)sort->status, 0, sizeof(mf_atomic_i64) * MF_SORT_PASSES * MF_SORT_RADIX * tiles);
+        mf_atomic_store(&batch->scan_next, 0);
+        batch->sort = sort;
+    }
+    return true;
+}
+
+// Merges the threads' reduction accumulators as a binary tree and stores the results
+static void cpu_reduce_merge(const mf_cpu_parallel_batch* batch) {
+    const mf_cpu_baked_kernel* baked = batch->baked;
+    const mf_cpu_task_plan* plan = batch->plan;
+    const u32 task_idx = (u32)(batch->current_task - batch->program->tasks);
+    const size_t stride = baked->reduction_stride;
+
+    for (u32 r = 0; r < baked->reduction_count; ++r) {
+        const mf_cpu_reduction* red = &baked->reductions[r];
+        if (red->task != task_idx) continue;
+        mf_dtype src = plan->reg_info[plan->code[red->inst].src1_idx].dtype;
+        mf_reduce_acc* accs = &baked->reduction_accs[red->offset];
+        for (int step = 1; step < batch->num_threads; step *= 2) {
+            for (int t = 0; t + step < batch->num_threads; t += 2 * step) {
+                mf_reduce_acc* dst = &accs[(size_t)t * stride];
+                const mf_reduce_acc* other = &accs[(size_t)(t + step) * stride];
+                for (u32 s = 0; s < red->slots; ++s) mf_ops_reduce_combine(red->opcode, src, &dst[s], &other[s]);
+            }
+        }
+        mf_tensor* main_t = &batch->main_state->registers[red->reg];
+        if (main_t->buffer && main_t->buffer->data) {
+            u8* out = (u8*)main_t->buffer->data + main_t->byte_offset;
+            size_t elem = mf_dtype_size(main_t->info.dtype);
+            size_t count = mf_tensor_count(main_t);
+            for (u32 s = 0; s < red->slots && s < count; ++s) mf_ops_reduce_store(red->opcode, src, &accs[s], out + s * elem, main_t->info.dtype);
+        }
+    }
+}
+
+/**
+ * Folds the threads' partials of the task's scatters into the first one and stores
+ * it over the base. Like the reduction merge, it runs on the thread ending the task:
+ * private partials only exist for targets small enough to stay in cache.
+ */
+static void cpu_scatter_merge(const mf_cpu_parallel_batch* batch) {
+    const mf_cpu_baked_kernel* baked = batch->baked;
+    const mf_cpu_task_plan* plan = batch->plan;
+    const u32 task_idx = (u32)(batch->current_task - batch->program->tasks);
+
+    for (u32 s = 0; s < baked->scatter_count; ++s) {
+        const mf_cpu_scatter* sc = &baked->scatters[s];
+        if (sc->task != task_idx || !sc->partials) continue;
+        const mf_type_info* info = &plan->reg_info[plan->code[sc->inst].dest_idx];
+        size_t count = mf_shape_calc_count(info->shape, info->ndim);
+        if (!sc->shared) {
+            for (int t = 1; t < batch->num_threads; ++t) mf_ops_scatter_fold(sc->opcode, info->dtype, sc->partials, sc->partials + (size_t)t * sc->stride, count);
+        }
+
+        mf_tensor* main_t = &batch->main_state->registers[sc->reg];
+        const mf_tensor* base_t = &batch->main_state->registers[sc->base];
+        if (!main_t->buffer || !main_t->buffer->data || !base_t->buffer || !base_t->buffer->data) continue;
+        if (mf_tensor_count(main_t) < count) count = mf_tensor_count(main_t);
+        if (mf_tensor_count(base_t) < count) count = mf_tensor_count(base_t);
+        mf_ops_scatter_store(sc->opcode, info->dtype, sc->partials, (const u8*)base_t->buffer->data + base_t->byte_offset,
+                             (u8*)main_t->buffer->data + main_t->byte_offset, count);
+    }
+}
+
+// Merges the per-thread reduction accumulators and scatter partials, publishes Filter lengths and feeds the tuner
+static void cpu_task_end(mf_cpu_parallel_batch* batch) {
+    const mf_task* target_task = batch->current_task;
+    if (batch->scan_tiles) {
+        // The last tile's inclusive prefix is the survivor count
+        u32 last = cpu_job_count(batch->total_elements, batch->job_size) - 1;
+        int32_t length = (int32_t)(u32)mf_atomic_load64(&batch->scan_tiles[last]);
+        cpu_task_set_lengths(batch->program, batch->main_state, target_task, length);
+    }
+
+    mf_cpu_task_plan* plan = (mf_cpu_task_plan*)batch->plan;
+    if (batch->start_time > 0 && !plan->tuner.done && batch->job_size == plan->job_size) {
+        plan_tuner_record(plan, mf_time_now() - batch->start_time, batch->total_elements);
+    }
+
+    if (target_task->strategy == MF_STRATEGY_REDUCTION) cpu_reduce_merge(batch);
+    else if (target_task->strategy == MF_STRATEGY_SCATTER) cpu_scatter_merge(batch);
+}
+
+static void cpu_dispatch_task(mf_backend_cpu_state* state, mf_cpu_baked_kernel* baked, mf_state* main_state, u32 task_idx, mf_backend_cpu_worker_state* worker) {
+    mf_cpu_parallel_batch batch;
+    if (!cpu_task_begin(state, baked, main_state, task_idx, &batch)) return;
+
+    mf_backend_cpu_dispatch_batch(state, &batch, worker);
+    cpu_task_end(&batch);
+}
+
+static void mf_backend_cpu_dispatch(void* backend_state, const struct mf_program* program, struct mf_state* main_state, const mf_tensor* domain, uint32_t start_inst, uint32_t inst_count) {
+    (void)inst_count;
+    mf_backend_cpu_state* state = (mf_backend_cpu_state*)backend_state;
+    mf_cpu_baked_kernel* baked = (mf_cpu_baked_kernel*)main_state->baked_data;
+    if (!domain || !baked) return;
     
     // Find the task that matches this instruction range
-    const mf_task* target_task = NULL;
     for (u32 s = 0; s < program->meta.task_count; ++s) {
         if (program->tasks[s].start_inst == start_inst) {
-            target_task = &program->tasks[s];
-            break;
+            cpu_dispatch_task(state, baked, main_state, s, NULL);
+            return;
         }
     }
 
-    if (!target_task) {
-        MF_LOG_ERROR("Backend: Could not find task starting at %u", start_inst);
+    MF_LOG_ERROR("Backend: Could not find task starting at %u", start_inst);
+}
+
+// --- Task Graph ---
+
+/**
+ * A graph run walks two levels: kernels wait for the kernels they depend on, and
+ * inside a kernel tasks wait for the program's task graph. Whichever thread finishes
+ * the last task of a kernel releases the dependent kernels, so tasks of independent
+ * kernels overlap on the pool. Iterations restart in a loop in cpu_graph_launch: the
+ * last task of one only reports it back up, so nesting does not grow with repeat.
+ */
+typedef struct {
+    mf_backend_cpu_state* state;
+    const mf_backend_kernel* kernels;
+} mf_cpu_graph_run;
+
+typedef struct {
+    const mf_cpu_graph_run* run;
+    u32 kernel;              // MF_CPU_GRAPH_RELEASE: items are kernels to release
+    const u32* items;        // Task or kernel indices
+    mf_atomic_i32 relaunch;  // A job ended an iteration with more to go
+} mf_cpu_graph_list;
+
+#define MF_CPU_GRAPH_RELEASE UINT32_MAX
+
+static void cpu_graph_job(u32 job_idx, void* thread_local_data, void* user_data);
+static void cpu_graph_release(const mf_cpu_graph_run* run, const u32* kernels, u32 count, mf_backend_cpu_worker_state* worker);
+
+static inline mf_atomic_i32* cpu_graph_error(const mf_backend_kernel* kernel) {
+    return kernel->state->global_error_ptr ? kernel->state->global_error_ptr : &kernel->state->error_code;
+}
+
+/**
+ * The task graph only sees registers. A transient resource bound to both an input and
+ * an output register shares one buffer between them, so such programs run in order.
+ */
+static bool graph_has_alias_hazard(const mf_program* prog, const mf_state* state) {
+    for (u32 i = 0; i < prog->meta.binding_count; ++i) {
+        const mf_bin_task_binding* a = &prog->bindings[i];
+        if (!(prog->tensor_flags[a->reg_idx] & MF_TENSOR_FLAG_ALIAS) || !state->registers[a->reg_idx].buffer) continue;
+        for (u32 j = i + 1; j < prog->meta.binding_count; ++j) {
+            const mf_bin_task_binding* b = &prog->bindings[j];
+            if (b->reg_idx == a->reg_idx || !((a->flags | b->flags) & MF_BINDING_FLAG_WRITE)) continue;
+            if (state->registers[b->reg_idx].buffer == state->registers[a->reg_idx].buffer) return true;
+        }
+    }
+    return false;
+}
+
+static bool cpu_graph_run_tasks(const mf_cpu_graph_run* run, u32 kernel, const u32* tasks, u32 count, mf_backend_cpu_worker_state* worker);
+
+static void cpu_graph_launch(const mf_cpu_graph_run* run, u32 kernel_idx, mf_backend_cpu_worker_state* worker) {
+    const mf_backend_kernel* kernel = &run->kernels[kernel_idx];
+    mf_cpu_baked_kernel* baked = (mf_cpu_baked_kernel*)kernel->state->baked_data;
+    u32 task_count = (baked && kernel->repeat > 0) ? kernel->program->meta.task_count : 0;
+
+    if (task_count < 2 || graph_has_alias_hazard(kernel->program, kernel->state)) {
+        // Nothing to overlap inside this kernel: run all iterations in order
+        mf_atomic_i32* error = cpu_graph_error(kernel);
+        for (u32 f = 0; f < kernel->repeat && task_count > 0; ++f) {
+            for (u32 t = 0; t < task_count && mf_atomic_load(error) == 0; ++t) {
+                cpu_dispatch_task(run->state, baked, kernel->state, t, worker);
+            }
+        }
+        cpu_graph_release(run, kernel->successors, kernel->successor_count, worker);
         return;
     }
 
-    if (batch.reduction_scratch && (target_task->strategy == MF_STRATEGY_REDUCTION)) {
-        memset(batch.reduction_scratch, 0, baked->reduction_scratch_size * sizeof(f32));
+    bool relaunch;
+    do {
+        for (u32 t = 0; t < task_count; ++t) mf_atomic_store(&baked->remaining[t], (int32_t)kernel->program->tasks[t].dep_count);
+        mf_atomic_store(&baked->pending, (int32_t)task_count);
+        relaunch = cpu_graph_run_tasks(run, kernel_idx, baked->roots, baked->root_count, worker);
+    } while (relaunch);
+    cpu_graph_release(run, kernel->successors, kernel->successor_count, worker);
+}
+
+// Returns true if it ended an iteration and the kernel has more to run
+static bool cpu_graph_run_task(const mf_cpu_graph_run* run, u32 kernel_idx, u32 task_idx, mf_backend_cpu_worker_state* worker) {
+    const mf_backend_kernel* kernel = &run->kernels[kernel_idx];
+    mf_cpu_baked_kernel* baked = (mf_cpu_baked_kernel*)kernel->state->baked_data;
+    mf_atomic_i32* error = cpu_graph_error(kernel);
+
+    while (true) {
+        if (mf_atomic_load(error) == 0) cpu_dispatch_task(run->state, baked, kernel->state, task_idx, worker);
+
+        // Release successors. The first ready one continues on this thread, the rest fan out.
+        mf_cpu_task_plan* plan = &baked->plans[task_idx];
+        u32 ready_count = 0;
+        for (u32 s = 0; s < plan->successor_count; ++s) {
+            u32 succ = plan->successors[s];
+            if (mf_atomic_add(&baked->remaining[succ], -1) == 0) plan->ready[ready_count++] = succ;
+        }
+
+        // Last task of this iteration: cpu_graph_launch restarts the kernel or releases its successors
+        if (mf_atomic_add(&baked->pending, -1) == 0) return --baked->iterations > 0;
+        if (ready_count == 0) return false;
+        if (ready_count > 1) return cpu_graph_run_tasks(run, kernel_idx, plan->ready, ready_count, worker);
+        task_idx = plan->ready[0];
     }
+}
 
-    if (target_task->strategy == MF_STRATEGY_TWO_PASS_SYNC) {
-        u32 total_jobs = (u32)((batch.total_elements + MF_CPU_JOB_SIZE - 1) / MF_CPU_JOB_SIZE);
-        f32* sync_ptr = baked->sync_scratch;
-        if (total_jobs > baked->sync_scratch_size) sync_ptr = calloc(total_jobs, sizeof(f32));
-        batch.sync_pass = 0; batch.sync_data = sync_ptr;
-        mf_backend_cpu_dispatch_batch(state, &batch, target_task);
-        f32 global_acc = 0;
-        for (u32 j = 0; j < total_jobs; ++j) { f32 chunk_total = sync_ptr[j]; sync_ptr[j] = global_acc; global_acc += chunk_total; }
-        batch.sync_pass = 1;
-        mf_backend_cpu_dispatch_batch(state, &batch, target_task);
-        if (sync_ptr != baked->sync_scratch) free(sync_ptr);
-    } else {
-        mf_backend_cpu_dispatch_batch(state, &batch, target_task);
+static bool cpu_graph_run_tasks(const mf_cpu_graph_run* run, u32 kernel, const u32* tasks, u32 count, mf_backend_cpu_worker_state* worker) {
+    if (count == 0) return false;
+    if (count == 1) return cpu_graph_run_task(run, kernel, tasks[0], worker);
+
+    mf_cpu_graph_list list = { run, kernel, tasks + 1 };
+    mf_atomic_store(&list.relaunch, 0);
+    mf_thread_batch* batch = mf_thread_pool_submit(run->state->pool, count - 1, cpu_graph_job, &list);
+    bool relaunch = cpu_graph_run_task(run, kernel, tasks[0], worker);
+    mf_thread_pool_wait(run->state->pool, batch);
+    return relaunch || mf_atomic_load(&list.relaunch) != 0;
+}
+
+/**
+ * Drops one blocker from each listed kernel and launches those that become ready.
+ * Kernels are few, so every candidate gets a job and the ones still blocked return.
+ */
+static void cpu_graph_release_one(const mf_cpu_graph_run* run, u32 kernel_idx, mf_backend_cpu_worker_state* worker) {
+    mf_cpu_baked_kernel* baked = (mf_cpu_baked_kernel*)run->kernels[kernel_idx].state->baked_data;
+    if (mf_atomic_add(&baked->blocked, -1) == 0) cpu_graph_launch(run, kernel_idx, worker);
+}
+
+static void cpu_graph_release(const mf_cpu_graph_run* run, const u32* kernels, u32 count, mf_backend_cpu_worker_state* worker) {
+    if (count == 0) return;
+    if (count == 1) { cpu_graph_release_one(run, kernels[0], worker); return; }
+
+    mf_cpu_graph_list list = { run, MF_CPU_GRAPH_RELEASE, kernels + 1 };
+    mf_atomic_store(&list.relaunch, 0);
+    mf_thread_batch* batch = mf_thread_pool_submit(run->state->pool, count - 1, cpu_graph_job, &list);
+    cpu_graph_release_one(run, kernels[0], worker);
+    mf_thread_pool_wait(run->state->pool, batch);
+}
+
+static void cpu_graph_job(u32 job_idx, void* thread_local_data, void* user_data) {
+    mf_cpu_graph_list* list = (mf_cpu_graph_list*)user_data;
+    mf_backend_cpu_worker_state* worker = (mf_backend_cpu_worker_state*)thread_local_data;
+    if (list->kernel == MF_CPU_GRAPH_RELEASE) cpu_graph_release_one(list->run, list->items[job_idx], worker);
+    else if (cpu_graph_run_task(list->run, list->kernel, list->items[job_idx], worker)) mf_atomic_store(&list->relaunch, 1);
+}
+
+static void cpu_graph_root_job(u32 job_idx, void* thread_local_data, void* user_data) {
+    const mf_cpu_graph_run* run = (const mf_cpu_graph_run*)user_data;
+    cpu_graph_release_one(run, job_idx, (mf_backend_cpu_worker_state*)thread_local_data);
+}
+
+// --- Frame Region ---
+
+static bool frame_reserve(void** buf, u32* capacity, u32 needed, size_t elem_size) {
+    if (needed <= *capacity) return true;
+    u32 cap = *capacity ? *capacity : 16;
+    while (cap < needed) cap *= 2;
+    void* mem = realloc(*buf, (size_t)cap * elem_size);
+    if (!mem) return false;
+    *buf = mem;
+    *capacity = cap;
+    return true;
+}
+
+/**
+ * Levels the frame into steps. A task starts one step after its latest dependency,
+ * an iteration after the previous one, and a kernel after the kernels it depends on.
+ */
+static bool cpu_frame_build(mf_cpu_frame* frame, const mf_backend_kernel* kernels, u32 kernel_count) {
+    frame->kernels = kernels;
+    frame->kernel_count = kernel_count;
+
+    u32 run_total = 0, max_tasks = 0;
+    for (u32 k = 0; k < kernel_count; ++k) {
+        u32 tasks = kernels[k].program->meta.task_count;
+        run_total += tasks * kernels[k].repeat;
+        if (tasks > max_tasks) max_tasks = tasks;
+    }
+    if (!frame_reserve((void**)&frame->runs, &frame->run_capacity, run_total, sizeof(mf_cpu_frame_run)) ||
+        !frame_reserve((void**)&frame->scratch, &frame->scratch_capacity, max_tasks + kernel_count, sizeof(u32))) return false;
+
+    u32* task_end = frame->scratch;
+    u32* kernel_start = frame->scratch + max_tasks;
+    memset(kernel_start, 0, sizeof(u32) * kernel_count);
+    u32 step_count = 0;
+    frame->run_count = 0;
+
+    for (u32 k = 0; k < kernel_count; ++k) {
+        const mf_backend_kernel* kernel = &kernels[k];
+        const mf_program* prog = kernel->program;
+        bool serial = graph_has_alias_hazard(prog, kernel->state);
+        u32 base = kernel_start[k];
+
+        for (u32 r = 0; r < kernel->repeat; ++r) {
+            u32 next = base;
+            for (u32 t = 0; t < prog->meta.task_count; ++t) {
+                const mf_task* task = &prog->tasks[t];
+                u32 start = base;
+                for (u32 d = 0; d < task->dep_count; ++d) {
+                    u32 dep_end = task_end[prog->task_deps[task->dep_offset + d]] + 1;
+                    if (dep_end > start) start = dep_end;
+                }
+                if (serial && t > 0 && task_end[t - 1] + 1 > start) start = task_end[t - 1] + 1;
+
+                task_end[t] = start;
+                if (start + 1 > next) next = start + 1;
+                frame->runs[frame->run_count++] = (mf_cpu_frame_run){ .kernel = k, .task = t, .step = start };
+            }
+            base = next;
+        }
+
+        for (u32 s = 0; s < kernel->successor_count; ++s) {
+            u32 succ = kernel->successors[s];
+            if (base > kernel_start[succ]) kernel_start[succ] = base;
+        }
+        if (base > step_count) step_count = base;
+    }
+
+    // Group the runs by step
+    if (!frame_reserve((void**)&frame->step_offsets, &frame->step_capacity, step_count + 1, sizeof(u32)) ||
+        !frame_reserve((void**)&frame->step_items, &frame->item_capacity, frame->run_count, sizeof(u32))) return false;
+
+    u32* offsets = frame->step_offsets;
+    memset(offsets, 0, sizeof(u32) * (step_count + 1));
+    for (u32 i = 0; i < frame->run_count; ++i) offsets[frame->runs[i].step + 1]++;
+    for (u32 s = 0; s < step_count; ++s) offsets[s + 1] += offsets[s];
+    for (u32 i = 0; i < frame->run_count; ++i) frame->step_items[offsets[frame->runs[i].step]++] = i;
+    for (u32 s = step_count; s > 0; --s) offsets[s] = offsets[s - 1];
+    offsets[0] = 0;
+
+    frame->step_count = step_count;
+    return true;
+}
+
+// Region pays off when the steps are too small to keep the pool busy on their own
+static bool cpu_frame_is_small(const mf_cpu_frame* frame, int num_threads) {
+    size_t total_jobs = 0;
+    for (u32 i = 0; i < frame->run_count; ++i) {
+        const mf_cpu_frame_run* run = &frame->runs[i];
+        const mf_backend_kernel* kernel = &frame->kernels[run->kernel];
+        const mf_task* task = &kernel->program->tasks[run->task];
+        const mf_cpu_task_plan* plan = &((const mf_cpu_baked_kernel*)kernel->state->baked_data)->plans[run->task];
+        total_jobs += (size_t)cpu_job_count(mf_tensor_count(&kernel->state->registers[task->domain_reg]), plan->resolved ? plan->job_size : MF_CPU_JOB_SIZE) * cpu_task_rounds(task);
+    }
+    return total_jobs > frame->step_count && total_jobs < (size_t)MF_CPU_FRAME_STEP_JOBS * (size_t)num_threads * frame->step_count;
+}
+
+// Thread 0 only, between the barriers: begins the step's runs and lays out their jobs
+static void cpu_frame_prepare(mf_backend_cpu_state* state, mf_cpu_frame* frame, u32 step) {
+    u32 jobs = 0;
+    for (u32 i = frame->step_offsets[step]; i < frame->step_offsets[step + 1]; ++i) {
+        mf_cpu_frame_run* run = &frame->runs[frame->step_items[i]];
+        const mf_backend_kernel* kernel = &frame->kernels[run->kernel];
+        run->active = cpu_task_begin(state, (mf_cpu_baked_kernel*)kernel->state->baked_data, kernel->state, run->task, &run->batch);
+        run->job_offset = jobs;
+        run->job_count = run->active ? cpu_job_count(run->batch.total_elements, run->batch.job_size) * run->batch.rounds : 0;
+        jobs += run->job_count;
+    }
+
+    // Tuner samples are wall times, so only runs that had their step to themselves count
+    if (frame->step_offsets[step + 1] - frame->step_offsets[step] > 1) {
+        for (u32 i = frame->step_offsets[step]; i < frame->step_offsets[step + 1]; ++i) frame->runs[frame->step_items[i]].batch.start_time = 0;
+    }
+    frame->step_jobs = jobs;
+    mf_atomic_store(&frame->next_job, 0);
+
+    frame->abort = false;
+    for (u32 k = 0; k < frame->kernel_count; ++k) {
+        if (mf_atomic_load(cpu_graph_error(&frame->kernels[k])) != 0) frame->abort = true;
+    }
+}
+
+static void cpu_frame_work(mf_cpu_frame* frame, u32 step, mf_backend_cpu_worker_state* worker) {
+    const u32* items = frame->step_items + frame->step_offsets[step];
+    u32 cursor = 0;
+    while (true) {
+        // Claimed jobs only grow on each thread, so the run cursor only moves forward
+        u32 job = (u32)mf_atomic_add(&frame->next_job, 1) - 1;
+        if (job >= frame->step_jobs) return;
+        mf_cpu_frame_run* run = &frame->runs[items[cursor]];
+        while (job >= run->job_offset + run->job_count) run = &frame->runs[items[++cursor]];
+        cpu_worker_job(job - run->job_offset, worker, &run->batch);
+    }
+}
+
+static void cpu_frame_finish(mf_cpu_frame* frame, u32 step) {
+    for (u32 i = frame->step_offsets[step]; i < frame->step_offsets[step + 1]; ++i) {
+        mf_cpu_frame_run* run = &frame->runs[frame->step_items[i]];
+        if (!run->active) continue;
+        cpu_task_end(&run->batch);
+        run->active = false;
+    }
+}
+
+static void cpu_frame_region(int thread_idx, int thread_count, void* thread_local_data, void* user_data) {
+    mf_backend_cpu_state* state = (mf_backend_cpu_state*)user_data;
+    mf_backend_cpu_worker_state* worker = (mf_backend_cpu_worker_state*)thread_local_data;
+    mf_cpu_frame* frame = &state->frame;
+    if (thread_count != frame->barrier.count) mf_thread_barrier_init(&frame->barrier, NULL, thread_count); // Nested: alone
+
+    int32_t sense = 0;
+    for (u32 s = 0; s < frame->step_count; ++s) {
+        if (thread_idx == 0) cpu_frame_prepare(state, frame, s);
+        mf_thread_barrier_wait(&frame->barrier, &sense);
+        if (frame->abort) break;
+        cpu_frame_work(frame, s, worker);
+        mf_thread_barrier_wait(&frame->barrier, &sense);
+        if (thread_idx == 0) cpu_frame_finish(frame, s);
+    }
+
+    if (thread_idx == 0) {
+        // Aborted mid-frame: release the runs the last step began
+        for (u32 i = 0; i < frame->run_count; ++i) {
+            if (frame->runs[i].active) { cpu_task_end(&frame->runs[i].batch); frame->runs[i].active = false; }
+        }
     }
+}
 
-    if (batch.reduction_scratch && (target_task->strategy == MF_STRATEGY_REDUCTION)) {
-        for (u32 i = 0; i < program->meta.tensor_count; ++i) {
-            if (program->tensor_flags[i] & MF_TENSOR_FLAG_REDUCTION) {
-                f32 final_val = 0;
-                for (int t = 0; t < num_threads; ++t) final_val += batch.reduction_scratch[t * batch.reduction_scratch_per_thread + i];
-                mf_tensor* main_t = &main_state->registers[i];
-                if (main_t->buffer && main_t->buffer->data) {
-                    *((f32*)main_t->buffer->data + main_t->byte_offset / sizeof(f32)) = final_val;
+static void mf_backend_cpu_dispatch_graph(void* backend_state, const mf_backend_kernel* kernels, uint32_t kernel_count) {
+    mf_backend_cpu_state* state = (mf_backend_cpu_state*)backend_state;
+    int num_threads = state->pool ? mf_thread_pool_get_thread_count(state->pool) : 1;
+
+    bool overlap = false;
+    for (u32 k = 0; k < kernel_count; ++k) {
+        if (!kernels[k].state->baked_data) return;
+        if (kernels[k].dep_count == 0 && k > 0) overlap = true;
+        if (kernels[k].program->meta.task_count > 1) overlap = true;
+    }
+
+    if (num_threads >= 2 && state->schedule != MF_CPU_SCHEDULE_GRAPH && cpu_frame_build(&state->frame, kernels, kernel_count) &&
+        (state->schedule == MF_CPU_SCHEDULE_FRAME || cpu_frame_is_small(&state->frame, num_threads))) {
+        mf_thread_barrier_init(&state->frame.barrier, state->pool, num_threads);
+        mf_thread_pool_region(state->pool, cpu_frame_region, state);
+        return;
+    }
+
+    if (num_threads < 2 || !overlap) {
+        // Nothing to overlap: plain in-order dispatch
+        for (u32 k = 0; k < kernel_count; ++k) {
+            const mf_backend_kernel* kernel = &kernels[k];
+            mf_atomic_i32* error = cpu_graph_error(kernel);
+            for (u32 f = 0; f < kernel->repeat; ++f) {
+                for (u32 t = 0; t < kernel->program->meta.task_count; ++t) {
+                    if (mf_atomic_load(error) != 0) return;
+                    cpu_dispatch_task(state, (mf_cpu_baked_kernel*)kernel->state->baked_data, kernel->state, t, NULL);
                 }
             }
         }
+        return;
     }
+
+    // Every kernel starts blocked by its dependencies plus one launch token, which
+    // the root jobs drop. Kernels without dependencies start right away.
+    for (u32 k = 0; k < kernel_count; ++k) {
+        mf_cpu_baked_kernel* baked = (mf_cpu_baked_kernel*)kernels[k].state->baked_data;
+        mf_atomic_store(&baked->blocked, (int32_t)kernels[k].dep_count + 1);
+        baked->iterations = kernels[k].repeat;
+    }
+
+    mf_cpu_graph_run run = { state, kernels };
+    mf_thread_pool_run(state->pool, kernel_count, cpu_graph_root_job, &run);
 }
 
 static void mf_backend_cpu_shutdown(void* backend_state) {
     mf_backend_cpu_state* state = (mf_backend_cpu_state*)backend_state;
     if (!state) return;
     if (state->pool) mf_thread_pool_destroy(state->pool);
+    free(state->frame.runs);
+    free(state->frame.step_items);
+    free(state->frame.step_offsets);
+    free(state->frame.scratch);
     free(state);
 }
 
-void mf_backend_cpu_init(mf_backend* backend, int num_threads) {
+void mf_backend_cpu_init_desc(mf_backend* backend, const mf_backend_cpu_desc* desc) {
     memset(backend, 0, sizeof(mf_backend));
     mf_backend_cpu_state* state = calloc(1, sizeof(mf_backend_cpu_state));
-    mf_thread_pool_desc pool_desc = { .num_threads = num_threads, .init_fn = worker_init, .cleanup_fn = worker_cleanup };
+    mf_thread_pool_desc pool_desc = { .num_threads = desc->num_threads, .init_fn = worker_init, .cleanup_fn = worker_cleanup };
     state->pool = mf_thread_pool_create(&pool_desc);
+    state->schedule = desc->schedule;
+    state->autotune = desc->autotune;
+    state->pairwise_sum = desc->pairwise_sum;
+    state->strip_size = desc->strip_size;
+    state->profile = desc->profile;
+    state->poll_interval = desc->poll_interval > 0 ? (u32)desc->poll_interval : 0;
     mf_ops_fill_table(state->op_table);
+    mf_ops_fill_table_fast(state->op_table_fast);
     backend->state = state; backend->bake = mf_backend_cpu_bake;
     backend->free_baked = mf_backend_cpu_free_baked; backend->shutdown = mf_backend_cpu_shutdown;
+    backend->resize = mf_backend_cpu_resize;
     backend->dispatch = mf_backend_cpu_dispatch;
-}
\ No newline at end of file
+    backend->dispatch_graph = mf_backend_cpu_dispatch_graph;
+}
+
+void mf_backend_cpu_init(mf_backend* backend, int num_threads) {
+    mf_backend_cpu_desc desc = { .num_threads = num_threads, .schedule = MF_CPU_SCHEDULE_AUTO };
+    mf_backend_cpu_init_desc(backend, &desc);
+}
+
+void mf_backend_cpu_get_stats(const mf_backend* backend, mf_backend_cpu_stats_cb cb, void* user_data) {
+    if (!backend || !backend->state || !cb) return;
+    const mf_backend_cpu_state* state = (const mf_backend_cpu_state*)backend->state;
+    for (const mf_cpu_baked_kernel* baked = state->baked_list; baked; baked = baked->next) {
+        for (u32 t = 0; t < baked->program->meta.task_count; ++t) {
+            const mf_cpu_task_plan* plan = &baked->plans[t];
+            if (!plan->resolved) continue;
+            mf_backend_cpu_task_stats stats = {
+                .program = baked->program, .task_idx = t,
+                .total_elements = plan->total_elements, .job_size = plan->job_size,
+                .job_count = cpu_job_count(plan->total_elements, plan->job_size) * cpu_task_rounds(plan->task),
+                .footprint = plan->footprint, .strip_size = plan->strip_size,
+                .scratch_hint = plan->scratch_hint, .scratch_peak = (size_t)mf_atomic_load((mf_atomic_i32*)&plan->scratch_peak),
+                .tuned = plan->tuner.done
+            };
+            if (plan->tuner.trial > 0) {
+                f64 best = -1.0;
+                for (u32 c = 0; c < MF_CPU_TUNE_CANDIDATES; ++c) {
+                    if (plan->tuner.best[c] >= 0 && (best < 0 || plan->tuner.best[c] < best)) best = plan->tuner.best[c];
+                }
+                stats.ns_per_element = best > 0 ? best * 1e9 : 0.0;
+            }
+            cb(&stats, user_data);
+        }
+    }
+}
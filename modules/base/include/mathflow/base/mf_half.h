@@ -0,0 +1,82 @@
+#ifndef MF_HALF_H
+#define MF_HALF_H
+
+#include <mathflow/base/mf_types.h>
+#include <string.h>
+
+/**
+ * Half-Precision Storage
+ * F16 and BF16 are stored as u16 and computed as f32. Narrowing rounds to
+ * nearest even, overflow goes to infinity and NaNs stay (quiet) NaNs, the same
+ * as the F16C instructions, so scalar and vector conversions agree bit for bit.
+ */
+
+static inline u32 mf_f32_bits(f32 v) { u32 u; memcpy(&u, &v, 4); return u; }
+static inline f32 mf_f32_from_bits(u32 u) { f32 v; memcpy(&v, &u, 4); return v; }
+
+static inline u16 mf_f16_from_f32(f32 v) {
+    u32 x = mf_f32_bits(v);
+    u16 sign = (u16)((x >> 16) & 0x8000u);
+    x &= 0x7FFFFFFFu;
+    if (x >= 0x47800000u) {
+        // Inf/NaN, or too large: NaNs keep their top payload bits
+        if (x > 0x7F800000u) return (u16)(sign | 0x7E00u | ((x >> 13) & 0x3FFu));
+        return (u16)(sign | 0x7C00u);
+    }
+    if (x < 0x38800000u) {
+        // Subnormal or zero: let the FPU round the shifted mantissa (0.5f is the magic)
+        u32 r = mf_f32_bits(mf_f32_from_bits(x) + 0.5f) - 0x3F000000u;
+        return (u16)(sign | r);
+    }
+    u32 odd = (x >> 13) & 1u;
+    x += 0xC8000FFFu + odd; // Rebias (-112 << 23) and round half to even
+    return (u16)(sign | (x >> 13));
+}
+
+static inline f32 mf_f16_to_f32(u16 h) {
+    u32 sign = (u32)(h & 0x8000u) << 16;
+    u32 exp = (h >> 10) & 0x1Fu;
+    u32 mant = h & 0x3FFu;
+    if (exp == 0) {
+        f32 v = (f32)mant * (1.0f / 16777216.0f); // mant * 2^-24, exact
+        return mf_f32_from_bits(mf_f32_bits(v) | sign);
+    }
+    if (exp == 31) return mf_f32_from_bits(sign | 0x7F800000u | (mant << 13) | (mant ? 0x400000u : 0u));
+    return mf_f32_from_bits(sign | ((exp + 112u) << 23) | (mant << 13));
+}
+
+static inline u16 mf_bf16_from_f32(f32 v) {
+    u32 x = mf_f32_bits(v);
+    if ((x & 0x7FFFFFFFu) > 0x7F800000u) return (u16)((x >> 16) | 0x40u);
+    x += 0x7FFFu + ((x >> 16) & 1u);
+    return (u16)(x >> 16);
+}
+
+static inline f32 mf_bf16_to_f32(u16 h) {
+    return mf_f32_from_bits((u32)h << 16);
+}
+
+// Element i of a buffer of any numeric dtype, as f32
+static inline f32 mf_dtype_load_f32(const void* data, mf_dtype dtype, size_t i) {
+    switch (dtype) {
+        case MF_DTYPE_F32:  return ((const f32*)data)[i];
+        case MF_DTYPE_I32:  return (f32)((const i32*)data)[i];
+        case MF_DTYPE_U8:   return (f32)((const u8*)data)[i];
+        case MF_DTYPE_F16:  return mf_f16_to_f32(((const u16*)data)[i]);
+        case MF_DTYPE_BF16: return mf_bf16_to_f32(((const u16*)data)[i]);
+        default: return 0.0f;
+    }
+}
+
+static inline void mf_dtype_store_f32(void* data, mf_dtype dtype, size_t i, f32 v) {
+    switch (dtype) {
+        case MF_DTYPE_F32:  ((f32*)data)[i] = v; break;
+        case MF_DTYPE_I32:  ((i32*)data)[i] = (i32)v; break;
+        case MF_DTYPE_U8:   ((u8*)data)[i] = (u8)v; break;
+        case MF_DTYPE_F16:  ((u16*)data)[i] = mf_f16_from_f32(v); break;
+        case MF_DTYPE_BF16: ((u16*)data)[i] = mf_bf16_from_f32(v); break;
+        default: break;
+    }
+}
+
+#endif // MF_HALF_H
@@ -17,18 +17,34 @@ struct mf_allocator {
 
 // --- Arena Allocator (Linear / Frame Memory) ---
 // Fast, no free(), reset() only.
+// A reserved arena (mf_arena_init_reserve) owns a virtual address range and commits
+// it on demand, so only the pages that were ever used take up memory.
 
 typedef struct mf_arena {
     mf_allocator base; // Inheritance
     u8* memory;
     size_t size;
     size_t pos;
+    size_t committed;  // Usable bytes (== size unless reserved)
+    size_t peak;       // High-water mark of pos
+    bool reserved;
 } mf_arena;
 
 void mf_arena_init(mf_arena* arena, void* backing_buffer, size_t size);
+bool mf_arena_init_reserve(mf_arena* arena, size_t reserve_size);
 void* mf_arena_alloc(mf_allocator* self, size_t size); // Implements interface
 void  mf_arena_reset(mf_arena* arena);
 
+/**
+ * Makes sure the first `size` bytes are usable (commits ahead for reserved arenas).
+ */
+bool  mf_arena_commit(mf_arena* arena, size_t size);
+
+/**
+ * Returns the range of a reserved arena to the system. No-op for other arenas.
+ */
+void  mf_arena_release(mf_arena* arena);
+
 #define MF_ARENA_PUSH(arena, type, count) (type*)mf_arena_alloc((mf_allocator*)arena, sizeof(type) * (count))
 
 // --- Heap Allocator (General Purpose) ---
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef _WIN32
     #ifndef WIN32_LEAN_AND_MEAN
@@ -16,6 +17,9 @@
     
     // Simple atomic for counter
     typedef volatile LONG mf_atomic_i32;
+    typedef volatile LONG64 mf_atomic_i64;
+
+    #define MF_THREAD_LOCAL __declspec(thread)
 
 #else
     #include <pthread.h>
@@ -27,6 +31,9 @@
     typedef pthread_cond_t mf_cond_t;
     
     typedef atomic_int mf_atomic_i32;
+    typedef _Atomic(int64_t) mf_atomic_i64;
+
+    #define MF_THREAD_LOCAL _Thread_local
 #endif
 
 // Thread Function Prototype
@@ -36,6 +43,12 @@ typedef void* (*mf_thread_func)(void* arg);
 int mf_thread_create(mf_thread_t* thread, mf_thread_func func, void* arg);
 int mf_thread_join(mf_thread_t thread);
 int mf_cpu_count(void);
+void mf_thread_yield(void);
+
+/**
+ * Spin-wait hint (PAUSE / YIELD instruction). Use inside busy loops.
+ */
+void mf_cpu_relax(void);
 
 // --- Mutex API ---
 void mf_mutex_init(mf_mutex_t* mutex);
@@ -51,9 +64,43 @@ void mf_cond_broadcast(mf_cond_t* cond);
 void mf_cond_destroy(mf_cond_t* cond);
 
 // --- Atomic API ---
+// All operations are sequentially consistent.
 int32_t mf_atomic_inc(mf_atomic_i32* var);
+int32_t mf_atomic_add(mf_atomic_i32* var, int32_t val); // Returns the new value
 int32_t mf_atomic_load(mf_atomic_i32* var);
 void mf_atomic_store(mf_atomic_i32* var, int32_t val);
+bool mf_atomic_cas(mf_atomic_i32* var, int32_t expected, int32_t desired);
+
+int64_t mf_atomic_load64(mf_atomic_i64* var);
+void mf_atomic_store64(mf_atomic_i64* var, int64_t val);
+bool mf_atomic_cas64(mf_atomic_i64* var, int64_t expected, int64_t desired);
+
+// --- Virtual Memory API ---
+
+/**
+ * Reserves an address range without backing it with memory. Returns NULL on failure.
+ */
+void* mf_vm_reserve(size_t size);
+
+/**
+ * Makes [addr, addr + size) of a reserved range readable and writable.
+ * Both must be multiples of mf_vm_page_size().
+ */
+bool mf_vm_commit(void* addr, size_t size);
+
+/**
+ * Returns a whole reserved range (committed or not) to the system.
+ */
+void mf_vm_release(void* addr, size_t size);
+
+size_t mf_vm_page_size(void);
+
+// --- Time API ---
+
+/**
+ * Monotonic clock in seconds. Only differences between calls are meaningful.
+ */
+double mf_time_now(void);
 
 // --- File System API ---
 
@@ -4,11 +4,31 @@
 #include <mathflow/base/mf_types.h>
 #include <mathflow/base/mf_platform.h>
 
+/**
+ * Work-stealing thread pool.
+ * Every worker owns a Chase-Lev deque of job ranges. A submitted range is split
+ * lazily in halves: the owner keeps the front half, idle workers steal the back
+ * half. The submitting thread takes part in the work while it waits, so a pool
+ * of N threads runs N-1 background threads plus the caller (thread_idx 0).
+ * Jobs may submit and wait on nested batches.
+ *
+ * A region (mf_thread_pool_region) instead runs one callback on every thread at
+ * once; its threads step through shared work separated by mf_thread_barrier.
+ */
 typedef struct mf_thread_pool mf_thread_pool;
 
+/**
+ * @brief Handle of an in-flight batch (see mf_thread_pool_submit).
+ */
+typedef struct mf_thread_batch mf_thread_batch;
+
+// Max jobs in a single submitted batch (mf_thread_pool_run splits larger counts).
+#define MF_THREAD_POOL_MAX_JOBS ((1u << 28) - 1)
+
 /**
  * @brief Callback for thread-local initialization.
- * Called once per worker thread when the pool starts.
+ * Called once per worker thread when the pool starts. Slot 0 belongs to the
+ * submitting thread and is initialized on the thread that creates the pool.
  * @return Pointer to thread-local data, passed to job_func.
  */
 typedef void* (*mf_thread_init_func)(int thread_idx, void* user_data);
@@ -27,8 +47,27 @@ typedef void (*mf_thread_cleanup_func)(void* thread_local_data, void* user_data)
  */
 typedef void (*mf_thread_job_func)(u32 job_idx, void* thread_local_data, void* user_data);
 
+/**
+ * @brief Body of a parallel region.
+ * @param thread_idx Index of this thread within the region [0..thread_count-1].
+ * @param thread_count Number of threads taking part.
+ * @param thread_local_data Data returned by mf_thread_init_func for this thread.
+ */
+typedef void (*mf_thread_region_func)(int thread_idx, int thread_count, void* thread_local_data, void* user_data);
+
+/**
+ * @brief Sense-reversing spin barrier for the threads of a region.
+ * Each thread keeps its own sense flag (initially 0) and passes it to every wait.
+ */
+typedef struct mf_thread_barrier {
+    mf_atomic_i32 arrived;
+    mf_atomic_i32 sense;
+    int32_t count;
+    u32 spin_rounds;
+} mf_thread_barrier;
+
 typedef struct mf_thread_pool_desc {
-    int num_threads;             ///< Number of workers. 0 for auto (CPU count).
+    int num_threads;             ///< Number of workers, including the caller. 0 for auto (CPU count).
     mf_thread_init_func init_fn;    ///< Optional.
     mf_thread_cleanup_func cleanup_fn; ///< Optional.
     void* user_data;             ///< Passed to init/cleanup.
@@ -59,7 +98,50 @@ void mf_thread_pool_run(
 );
 
 /**
- * @brief Returns the number of workers in the pool.
+ * @brief Runs a single job on the calling thread, with the thread-local data of its slot.
+ * Threads outside the pool use slot 0 (serialized like any other submitting thread).
+ */
+void mf_thread_pool_run_local(mf_thread_pool* pool, mf_thread_job_func job_fn, void* user_data);
+
+/**
+ * @brief Queues a batch of jobs and returns immediately.
+ * The submitting thread must later call mf_thread_pool_wait on the handle.
+ * Called from inside a job, the batch goes to the current worker's deque (nested submission).
+ * @return Handle, or NULL if the batch was executed inline (no free batch slot).
+ */
+mf_thread_batch* mf_thread_pool_submit(
+    mf_thread_pool* pool,
+    u32 job_count,
+    mf_thread_job_func job_fn,
+    void* user_data
+);
+
+/**
+ * @brief Executes pending jobs on the calling thread until the batch is finished.
+ * Jobs from other batches may run on this thread in the meantime.
+ */
+void mf_thread_pool_wait(mf_thread_pool* pool, mf_thread_batch* batch);
+
+/**
+ * @brief Runs fn once on every thread of the pool and blocks until all return.
+ * The caller takes part as thread 0. Called from inside a job or region (or on a
+ * single-threaded pool), fn runs only on the calling thread with thread_count 1.
+ */
+void mf_thread_pool_region(mf_thread_pool* pool, mf_thread_region_func fn, void* user_data);
+
+/**
+ * @brief Prepares a barrier for thread_count threads.
+ * Waiting threads spin like idle pool workers, then yield; they never park.
+ */
+void mf_thread_barrier_init(mf_thread_barrier* barrier, mf_thread_pool* pool, int thread_count);
+
+/**
+ * @brief Blocks until all threads of the barrier have arrived.
+ */
+void mf_thread_barrier_wait(mf_thread_barrier* barrier, int32_t* local_sense);
+
+/**
+ * @brief Returns the number of workers in the pool (including the caller slot).
  */
 int mf_thread_pool_get_thread_count(mf_thread_pool* pool);
 
@@ -58,6 +58,8 @@ typedef enum {
     MF_DTYPE_F32,   // Standard float
     MF_DTYPE_I32,   // Integer / String ID
     MF_DTYPE_U8,    // Byte / Bool
+    MF_DTYPE_F16,   // IEEE half (storage only, computed as f32)
+    MF_DTYPE_BF16,  // bfloat16 (storage only, computed as f32)
     MF_DTYPE_COUNT
 } mf_dtype;
 
@@ -75,10 +77,17 @@ static inline size_t mf_dtype_size(mf_dtype type) {
         case MF_DTYPE_F32: return 4;
         case MF_DTYPE_I32: return 4;
         case MF_DTYPE_U8:  return 1;
+        case MF_DTYPE_F16: return 2;
+        case MF_DTYPE_BF16: return 2;
         default: return 0;
     }
 }
 
+// Half dtypes only exist in memory; loads widen to f32 and stores narrow (see mf_half.h)
+static inline bool mf_dtype_is_half(mf_dtype type) {
+    return type == MF_DTYPE_F16 || type == MF_DTYPE_BF16;
+}
+
 static inline void mf_type_info_init_contiguous(mf_type_info* info, mf_dtype dtype, const int32_t* shape, uint8_t ndim) {
     info->dtype = dtype;
     info->ndim = ndim;
@@ -97,7 +106,7 @@ static inline void mf_type_info_init_contiguous(mf_type_info* info, mf_dtype dty
 
 /**
  * @brief Parses a string into an mf_dtype.
- * Case-insensitive, supports: "f32", "i32", "u8", "bool".
+ * Case-insensitive, supports: "f32", "i32", "u8", "bool", "f16", "half", "bf16".
  */
 mf_dtype mf_dtype_from_str(const char* s);
 
@@ -1,5 +1,6 @@
 #include <mathflow/base/mf_memory.h>
 #include <mathflow/base/mf_log.h>
+#include <mathflow/base/mf_platform.h>
 #include <string.h>
 #include <stdio.h> // For debug prints if needed
 
@@ -7,14 +8,31 @@
 
 #define ALIGN_UP(n, align) (((n) + (align) - 1) & ~((align) - 1))
 #define MF_ALIGNMENT 16 // Align to 16 bytes for SIMD friendliness
+#define MF_ARENA_COMMIT_STEP (64 * 1024) // Reserved arenas grow by at least this much
 
 // --- Arena Allocator Implementation ---
 
+bool mf_arena_commit(mf_arena* arena, size_t size) {
+    if (size <= arena->committed) return true;
+    if (!arena->reserved || size > arena->size) return false;
+
+    size_t step = MF_ARENA_COMMIT_STEP;
+    size_t page = mf_vm_page_size();
+    if (step < page) step = page;
+    size_t target = ALIGN_UP(size, step);
+    if (target < arena->committed * 2) target = ALIGN_UP(arena->committed * 2, step); // Geometric growth
+    if (target > arena->size) target = arena->size;
+
+    if (!mf_vm_commit(arena->memory + arena->committed, target - arena->committed)) return false;
+    arena->committed = target;
+    return true;
+}
+
 void* mf_arena_alloc(mf_allocator* self, size_t size) {
     mf_arena* arena = (mf_arena*)self;
     size_t aligned_size = ALIGN_UP(size, MF_ALIGNMENT);
     
-    if (arena->pos + aligned_size > arena->size) {
+    if (arena->pos + aligned_size > arena->committed && !mf_arena_commit(arena, arena->pos + aligned_size)) {
         MF_LOG_ERROR("Arena OOM: Requested %zu bytes (aligned to %zu), but only %zu/%zu left.", 
             size, aligned_size, arena->size - arena->pos, arena->size);
         return NULL; // OOM
@@ -22,6 +40,7 @@ void* mf_arena_alloc(mf_allocator* self, size_t size) {
 
     void* ptr = arena->memory + arena->pos;
     arena->pos += aligned_size;
+    if (arena->pos > arena->peak) arena->peak = arena->pos;
     return ptr;
 }
 
@@ -49,6 +68,25 @@ void mf_arena_init(mf_arena* arena, void* backing_buffer, size_t size) {
     arena->memory = (u8*)backing_buffer;
     arena->size = size;
     arena->pos = 0;
+    arena->committed = size;
+    arena->peak = 0;
+    arena->reserved = false;
+}
+
+bool mf_arena_init_reserve(mf_arena* arena, size_t reserve_size) {
+    size_t page = mf_vm_page_size();
+    reserve_size = ALIGN_UP(reserve_size, page);
+    void* memory = mf_vm_reserve(reserve_size);
+    mf_arena_init(arena, memory, memory ? reserve_size : 0);
+    arena->committed = 0;
+    arena->reserved = (memory != NULL);
+    return memory != NULL;
+}
+
+void mf_arena_release(mf_arena* arena) {
+    if (!arena->reserved) return;
+    mf_vm_release(arena->memory, arena->size);
+    mf_arena_init(arena, NULL, 0);
 }
 
 void mf_arena_reset(mf_arena* arena) {
@@ -43,6 +43,14 @@ int mf_cpu_count(void) {
     return sysinfo.dwNumberOfProcessors;
 }
 
+void mf_thread_yield(void) {
+    SwitchToThread();
+}
+
+void mf_cpu_relax(void) {
+    YieldProcessor();
+}
+
 void mf_mutex_init(mf_mutex_t* mutex) {
     InitializeCriticalSection(mutex);
 }
@@ -84,6 +92,10 @@ int32_t mf_atomic_inc(mf_atomic_i32* var) {
     return InterlockedIncrement(var);
 }
 
+int32_t mf_atomic_add(mf_atomic_i32* var, int32_t val) {
+    return InterlockedAdd(var, val);
+}
+
 int32_t mf_atomic_load(mf_atomic_i32* var) {
     return *var; // Simple load on x86/x64 is atomic aligned
 }
@@ -92,6 +104,49 @@ void mf_atomic_store(mf_atomic_i32* var, int32_t val) {
     InterlockedExchange(var, val);
 }
 
+bool mf_atomic_cas(mf_atomic_i32* var, int32_t expected, int32_t desired) {
+    return InterlockedCompareExchange(var, desired, expected) == expected;
+}
+
+int64_t mf_atomic_load64(mf_atomic_i64* var) {
+    return InterlockedCompareExchange64(var, 0, 0);
+}
+
+void mf_atomic_store64(mf_atomic_i64* var, int64_t val) {
+    InterlockedExchange64(var, val);
+}
+
+bool mf_atomic_cas64(mf_atomic_i64* var, int64_t expected, int64_t desired) {
+    return InterlockedCompareExchange64(var, desired, expected) == expected;
+}
+
+void* mf_vm_reserve(size_t size) {
+    return VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+bool mf_vm_commit(void* addr, size_t size) {
+    return VirtualAlloc(addr, size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+}
+
+void mf_vm_release(void* addr, size_t size) {
+    (void)size;
+    if (addr) VirtualFree(addr, 0, MEM_RELEASE);
+}
+
+size_t mf_vm_page_size(void) {
+    SYSTEM_INFO sysinfo;
+    GetSystemInfo(&sysinfo);
+    return sysinfo.dwPageSize;
+}
+
+double mf_time_now(void) {
+    static LARGE_INTEGER freq = {0};
+    LARGE_INTEGER now;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart / (double)freq.QuadPart;
+}
+
 // --- FS Windows ---
 
 bool mf_fs_mkdir(const char* path) {
@@ -126,8 +181,11 @@ bool mf_fs_clear_dir(const char* path) {
 #else
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/mman.h>
 #include <dirent.h>
 #include <errno.h>
+#include <time.h>
+#include <sched.h>
 
 // --- Linux/POSIX Implementation ---
 
@@ -144,6 +202,18 @@ int mf_cpu_count(void) {
     return (nprocs < 1) ? 1 : (int)nprocs;
 }
 
+void mf_thread_yield(void) {
+    sched_yield();
+}
+
+void mf_cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
 void mf_mutex_init(mf_mutex_t* mutex) {
     pthread_mutex_init(mutex, NULL);
 }
@@ -184,6 +254,10 @@ int32_t mf_atomic_inc(mf_atomic_i32* var) {
     return atomic_fetch_add(var, 1) + 1;
 }
 
+int32_t mf_atomic_add(mf_atomic_i32* var, int32_t val) {
+    return atomic_fetch_add(var, val) + val;
+}
+
 int32_t mf_atomic_load(mf_atomic_i32* var) {
     return atomic_load(var);
 }
@@ -192,6 +266,46 @@ void mf_atomic_store(mf_atomic_i32* var, int32_t val) {
     atomic_store(var, val);
 }
 
+bool mf_atomic_cas(mf_atomic_i32* var, int32_t expected, int32_t desired) {
+    return atomic_compare_exchange_strong(var, &expected, desired);
+}
+
+int64_t mf_atomic_load64(mf_atomic_i64* var) {
+    return atomic_load(var);
+}
+
+void mf_atomic_store64(mf_atomic_i64* var, int64_t val) {
+    atomic_store(var, val);
+}
+
+bool mf_atomic_cas64(mf_atomic_i64* var, int64_t expected, int64_t desired) {
+    return atomic_compare_exchange_strong(var, &expected, desired);
+}
+
+void* mf_vm_reserve(size_t size) {
+    void* addr = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return (addr == MAP_FAILED) ? NULL : addr;
+}
+
+bool mf_vm_commit(void* addr, size_t size) {
+    return mprotect(addr, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+void mf_vm_release(void* addr, size_t size) {
+    if (addr) munmap(addr, size);
+}
+
+size_t mf_vm_page_size(void) {
+    long page = sysconf(_SC_PAGESIZE);
+    return (page < 1) ? 4096 : (size_t)page;
+}
+
+double mf_time_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
 // --- FS POSIX ---
 
 bool mf_fs_mkdir(const char* path) {
@@ -2,24 +2,77 @@
 #include <stdlib.h>
 #include <stdbool.h>
 
+// --- Configuration ---
+
+#define MF_POOL_DEQUE_SIZE   256   // Entries per worker deque (power of two)
+#define MF_POOL_MAX_BATCHES  64    // Batches in flight (incl. nested)
+#define MF_POOL_CACHE_LINE   64
+
+// Idle policy: exponential PAUSE spinning, then yielding, then parking on the condvar.
+#define MF_POOL_SPIN_ROUNDS  32
+#define MF_POOL_YIELD_ROUNDS 8
+
+// Deque entry: [batch slot:8][begin:28][end:28]
+#define MF_POOL_RANGE_BITS   28
+#define MF_POOL_RANGE_MASK   ((1ull << MF_POOL_RANGE_BITS) - 1)
+
+typedef enum {
+    MF_POOL_EMPTY,
+    MF_POOL_FOUND,
+    MF_POOL_CONTENDED   // Lost a steal race; work may still be available
+} mf_pool_steal_result;
+
+struct mf_thread_batch {
+    mf_atomic_i32 in_use;
+    mf_atomic_i32 pending;      // Jobs not finished yet
+    u32 base;                   // Added to every job index
+    mf_thread_job_func job_fn;
+    void* user_data;
+};
+
+typedef struct mf_pool_worker {
+    // Chase-Lev deque. Thieves advance 'top', the owner pushes/pops at 'bottom'.
+    mf_atomic_i64 top;
+    char pad0[MF_POOL_CACHE_LINE - sizeof(mf_atomic_i64)];
+    mf_atomic_i64 bottom;
+    char pad1[MF_POOL_CACHE_LINE - sizeof(mf_atomic_i64)];
+    mf_atomic_i64 entries[MF_POOL_DEQUE_SIZE];
+
+    struct mf_thread_pool* pool;
+    void* local_data;
+    int idx;
+    u32 rng;
+    int32_t region_gen;         // Last region this worker took part in
+
+    // Caller slot (idx 0) only: the external thread currently holding it
+    struct mf_pool_worker* prev_tls;
+    int hold_count;
+} mf_pool_worker;
+
 struct mf_thread_pool {
     int num_threads;
-    mf_thread_t* threads;
-    
-    // Synchronization
+    mf_pool_worker* workers;    // [num_threads], slot 0 is the submitting thread
+    mf_thread_t* threads;       // [num_threads - 1]
+
+    mf_thread_batch batches[MF_POOL_MAX_BATCHES];
+
+    mf_atomic_i32 running;
+    mf_atomic_i32 sleepers;
+    u32 spin_rounds;            // 0 when oversubscribed: spinning would steal the core from a busy worker
+
+    // Parallel region: bumping region_gen invites every background worker once
+    mf_thread_region_func region_fn;
+    void* region_user_data;
+    mf_atomic_i32 region_gen;
+    mf_atomic_i32 region_pending; // Background workers still inside the region
+
+    // Parking
     mf_mutex_t mutex;
-    mf_cond_t work_cond; 
-    mf_cond_t done_cond;
-    
-    bool running;
-    
-    // Batch State
-    u32 total_jobs;
-    mf_atomic_i32 next_job_idx;
-    mf_atomic_i32 completed_count;
-    
-    mf_thread_job_func job_fn;
-    void* job_user_data;
+    mf_cond_t wake_cond;
+    u32 epoch;                  // Guarded by mutex. Bumped on every wakeup.
+
+    // Serializes external threads competing for slot 0
+    mf_mutex_t caller_mutex;
 
     // Callbacks
     mf_thread_init_func init_fn;
@@ -27,139 +80,422 @@ struct mf_thread_pool {
     void* init_user_data;
 };
 
-typedef struct {
-    mf_thread_pool* pool;
-    int thread_idx;
-} worker_arg;
+static MF_THREAD_LOCAL mf_pool_worker* tls_worker = NULL;
+
+// --- Deque ---
+
+static bool deque_push(mf_pool_worker* w, u64 entry) {
+    int64_t b = mf_atomic_load64(&w->bottom);
+    int64_t t = mf_atomic_load64(&w->top);
+    if (b - t >= MF_POOL_DEQUE_SIZE) return false;
+    mf_atomic_store64(&w->entries[b & (MF_POOL_DEQUE_SIZE - 1)], (int64_t)entry);
+    mf_atomic_store64(&w->bottom, b + 1);
+    return true;
+}
+
+static bool deque_pop(mf_pool_worker* w, u64* out) {
+    int64_t b = mf_atomic_load64(&w->bottom) - 1;
+    mf_atomic_store64(&w->bottom, b);
+    int64_t t = mf_atomic_load64(&w->top);
+    if (t > b) {
+        mf_atomic_store64(&w->bottom, b + 1);
+        return false;
+    }
+
+    *out = (u64)mf_atomic_load64(&w->entries[b & (MF_POOL_DEQUE_SIZE - 1)]);
+    if (t == b) {
+        // Last entry: race against thieves
+        bool won = mf_atomic_cas64(&w->top, t, t + 1);
+        mf_atomic_store64(&w->bottom, b + 1);
+        return won;
+    }
+    return true;
+}
+
+static mf_pool_steal_result deque_steal(mf_pool_worker* w, u64* out) {
+    int64_t t = mf_atomic_load64(&w->top);
+    int64_t b = mf_atomic_load64(&w->bottom);
+    if (t >= b) return MF_POOL_EMPTY;
+
+    u64 entry = (u64)mf_atomic_load64(&w->entries[t & (MF_POOL_DEQUE_SIZE - 1)]);
+    if (!mf_atomic_cas64(&w->top, t, t + 1)) return MF_POOL_CONTENDED;
+    *out = entry;
+    return MF_POOL_FOUND;
+}
+
+static bool pool_has_work(mf_thread_pool* pool) {
+    for (int i = 0; i < pool->num_threads; ++i) {
+        mf_pool_worker* w = &pool->workers[i];
+        if (mf_atomic_load64(&w->bottom) > mf_atomic_load64(&w->top)) return true;
+    }
+    return false;
+}
+
+// --- Scheduling ---
+
+static inline u64 pool_entry(u32 slot, u32 begin, u32 end) {
+    return ((u64)slot << (2 * MF_POOL_RANGE_BITS)) | ((u64)begin << MF_POOL_RANGE_BITS) | (u64)end;
+}
+
+static inline u32 pool_rand(mf_pool_worker* w) {
+    u32 x = w->rng;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    w->rng = x;
+    return x;
+}
+
+static void pool_notify(mf_thread_pool* pool, bool all) {
+    // Pairs with the sleepers increment in pool_park (both sequentially consistent):
+    // either we see the sleeper, or it sees the new work / finished batch.
+    if (mf_atomic_load(&pool->sleepers) == 0) return;
+    mf_mutex_lock(&pool->mutex);
+    pool->epoch++;
+    if (all) mf_cond_broadcast(&pool->wake_cond);
+    else mf_cond_signal(&pool->wake_cond);
+    mf_mutex_unlock(&pool->mutex);
+}
+
+static inline bool pool_region_waiting(mf_thread_pool* pool, const mf_pool_worker* w) {
+    return w->idx != 0 && mf_atomic_load(&pool->region_gen) != w->region_gen;
+}
+
+static void pool_park(mf_thread_pool* pool, mf_pool_worker* w, mf_atomic_i32* pending) {
+    mf_mutex_lock(&pool->mutex);
+    u32 epoch = pool->epoch;
+    mf_atomic_inc(&pool->sleepers);
+    while (epoch == pool->epoch && mf_atomic_load(&pool->running) &&
+           !(pending && mf_atomic_load(pending) == 0) && !pool_has_work(pool) && !pool_region_waiting(pool, w)) {
+        mf_cond_wait(&pool->wake_cond, &pool->mutex);
+    }
+    mf_atomic_add(&pool->sleepers, -1);
+    mf_mutex_unlock(&pool->mutex);
+}
+
+// 'pending' is the counter the caller waits on (NULL for background workers)
+static u32 pool_idle(mf_thread_pool* pool, mf_pool_worker* w, u32 round, mf_atomic_i32* pending) {
+    if (round < pool->spin_rounds) {
+        u32 spins = 1u << (round < 6 ? round : 6);
+        for (u32 i = 0; i < spins; ++i) mf_cpu_relax();
+    } else if (round < pool->spin_rounds + MF_POOL_YIELD_ROUNDS) {
+        mf_thread_yield();
+    } else {
+        pool_park(pool, w, pending);
+        return 0;
+    }
+    return round + 1;
+}
+
+static mf_pool_steal_result pool_find_work(mf_thread_pool* pool, mf_pool_worker* w, u64* out) {
+    if (deque_pop(w, out)) return MF_POOL_FOUND;
+
+    int n = pool->num_threads;
+    mf_pool_steal_result result = MF_POOL_EMPTY;
+    u32 start = pool_rand(w) % (u32)n;
+    for (int k = 0; k < n; ++k) {
+        mf_pool_worker* victim = &pool->workers[(start + (u32)k) % (u32)n];
+        if (victim == w) continue;
+        mf_pool_steal_result r = deque_steal(victim, out);
+        if (r == MF_POOL_FOUND) return r;
+        if (r == MF_POOL_CONTENDED) result = r;
+    }
+    return result;
+}
+
+static void pool_execute(mf_thread_pool* pool, mf_pool_worker* w, u64 entry) {
+    u32 slot = (u32)(entry >> (2 * MF_POOL_RANGE_BITS));
+    u32 begin = (u32)((entry >> MF_POOL_RANGE_BITS) & MF_POOL_RANGE_MASK);
+    u32 end = (u32)(entry & MF_POOL_RANGE_MASK);
+    mf_thread_batch* batch = &pool->batches[slot];
+
+    // Lazy binary splitting: publish the back half for thieves, keep the front half.
+    while (end - begin > 1 && pool->num_threads > 1) {
+        u32 mid = begin + (end - begin) / 2;
+        if (!deque_push(w, pool_entry(slot, mid, end))) break;
+        pool_notify(pool, false);
+        end = mid;
+    }
+
+    for (u32 i = begin; i < end; ++i) {
+        batch->job_fn(batch->base + i, w->local_data, batch->user_data);
+    }
+
+    // The batch may be recycled by its waiter right after this; don't touch it again.
+    if (mf_atomic_add(&batch->pending, -(int32_t)(end - begin)) == 0) {
+        pool_notify(pool, true);
+    }
+}
+
+// Runs pending jobs on this thread until the counter drops to zero
+static void pool_help_until(mf_thread_pool* pool, mf_pool_worker* w, mf_atomic_i32* pending) {
+    u32 idle = 0;
+    u64 entry;
+    while (mf_atomic_load(pending) > 0) {
+        mf_pool_steal_result r = pool_find_work(pool, w, &entry);
+        if (r == MF_POOL_FOUND) {
+            pool_execute(pool, w, entry);
+            idle = 0;
+        } else if (r == MF_POOL_EMPTY) {
+            idle = pool_idle(pool, w, idle, pending);
+        }
+    }
+}
+
+// --- Caller Slot ---
+
+static mf_pool_worker* pool_enter(mf_thread_pool* pool) {
+    mf_pool_worker* w = tls_worker;
+    if (!w || w->pool != pool) {
+        // External thread: take over slot 0 until all its batches are waited on
+        mf_mutex_lock(&pool->caller_mutex);
+        w = &pool->workers[0];
+        w->prev_tls = tls_worker;
+        tls_worker = w;
+    }
+    if (w->idx == 0) w->hold_count++;
+    return w;
+}
+
+static void pool_leave(mf_thread_pool* pool, mf_pool_worker* w) {
+    if (w->idx == 0 && --w->hold_count == 0) {
+        tls_worker = w->prev_tls;
+        mf_mutex_unlock(&pool->caller_mutex);
+    }
+}
+
+static mf_thread_batch* pool_acquire_batch(mf_thread_pool* pool) {
+    for (u32 i = 0; i < MF_POOL_MAX_BATCHES; ++i) {
+        mf_thread_batch* batch = &pool->batches[i];
+        if (mf_atomic_load(&batch->in_use) == 0 && mf_atomic_cas(&batch->in_use, 0, 1)) return batch;
+    }
+    return NULL;
+}
+
+static mf_thread_batch* pool_submit(mf_thread_pool* pool, u32 base, u32 job_count, mf_thread_job_func job_fn, void* user_data) {
+    mf_pool_worker* w = pool_enter(pool);
+    mf_thread_batch* batch = (job_count <= MF_THREAD_POOL_MAX_JOBS) ? pool_acquire_batch(pool) : NULL;
+
+    if (batch) {
+        u32 slot = (u32)(batch - pool->batches);
+        batch->base = base;
+        batch->job_fn = job_fn;
+        batch->user_data = user_data;
+        mf_atomic_store(&batch->pending, (int32_t)job_count);
+        if (deque_push(w, pool_entry(slot, 0, job_count))) {
+            pool_notify(pool, false);
+            return batch;
+        }
+        mf_atomic_store(&batch->in_use, 0);
+    }
+
+    // Out of batch slots or deque space (deep nesting): run inline
+    for (u32 i = 0; i < job_count; ++i) job_fn(base + i, w->local_data, user_data);
+    pool_leave(pool, w);
+    return NULL;
+}
+
+// --- Worker Thread ---
 
 static void* worker_entry(void* arg) {
-    worker_arg* warg = (worker_arg*)arg;
-    mf_thread_pool* pool = warg->pool;
-    int thread_idx = warg->thread_idx;
-    free(warg);
+    mf_pool_worker* w = (mf_pool_worker*)arg;
+    mf_thread_pool* pool = w->pool;
+    tls_worker = w;
 
-    void* thread_local_data = NULL;
     if (pool->init_fn) {
-        thread_local_data = pool->init_fn(thread_idx, pool->init_user_data);
+        w->local_data = pool->init_fn(w->idx, pool->init_user_data);
     }
 
-    while (true) {
-        mf_mutex_lock(&pool->mutex);
-        while (pool->running && 
-               (mf_atomic_load(&pool->next_job_idx) >= (int32_t)pool->total_jobs)) {
-            mf_cond_wait(&pool->work_cond, &pool->mutex);
-        }
-        
-        if (!pool->running) {
-            mf_mutex_unlock(&pool->mutex);
-            break;
+    u32 idle = 0;
+    u64 entry;
+    while (mf_atomic_load(&pool->running)) {
+        int32_t gen = mf_atomic_load(&pool->region_gen);
+        if (gen != w->region_gen) {
+            w->region_gen = gen;
+            pool->region_fn(w->idx, pool->num_threads, w->local_data, pool->region_user_data);
+            if (mf_atomic_add(&pool->region_pending, -1) == 0) pool_notify(pool, true);
+            idle = 0;
+            continue;
         }
-        mf_mutex_unlock(&pool->mutex);
-        
-        while (true) {
-            int32_t job_id = mf_atomic_inc(&pool->next_job_idx) - 1;
-            
-            if (job_id >= (int32_t)pool->total_jobs) {
-                break;
-            }
-            
-            pool->job_fn((u32)job_id, thread_local_data, pool->job_user_data);
-            
-            int32_t finished = mf_atomic_inc(&pool->completed_count);
-            if (finished == (int32_t)pool->total_jobs) {
-                mf_mutex_lock(&pool->mutex);
-                mf_cond_signal(&pool->done_cond);
-                mf_mutex_unlock(&pool->mutex);
-            }
+
+        mf_pool_steal_result r = pool_find_work(pool, w, &entry);
+        if (r == MF_POOL_FOUND) {
+            pool_execute(pool, w, entry);
+            idle = 0;
+        } else if (r == MF_POOL_EMPTY) {
+            idle = pool_idle(pool, w, idle, NULL);
         }
     }
-    
+
     if (pool->cleanup_fn) {
-        pool->cleanup_fn(thread_local_data, pool->init_user_data);
+        pool->cleanup_fn(w->local_data, pool->init_user_data);
     }
-    
+    tls_worker = NULL;
     return NULL;
 }
 
+// --- Public API ---
+
 mf_thread_pool* mf_thread_pool_create(const mf_thread_pool_desc* desc) {
-    mf_thread_pool* p = malloc(sizeof(mf_thread_pool));
-    
+    mf_thread_pool* p = calloc(1, sizeof(mf_thread_pool));
+    if (!p) return NULL;
+
     int n = desc->num_threads;
     if (n <= 0) {
         n = mf_cpu_count();
         if (n < 1) n = 1;
     }
-    
+
     p->num_threads = n;
-    p->running = true;
-    p->threads = malloc(sizeof(mf_thread_t) * n);
-    
+    p->spin_rounds = (n <= mf_cpu_count()) ? MF_POOL_SPIN_ROUNDS : 0;
+    p->workers = calloc((size_t)n, sizeof(mf_pool_worker));
+    p->threads = (n > 1) ? malloc(sizeof(mf_thread_t) * (size_t)(n - 1)) : NULL;
+    if (!p->workers || (n > 1 && !p->threads)) {
+        free(p->workers);
+        free(p->threads);
+        free(p);
+        return NULL;
+    }
+
     mf_mutex_init(&p->mutex);
-    mf_cond_init(&p->work_cond);
-    mf_cond_init(&p->done_cond);
-    
-    p->total_jobs = 0;
-    mf_atomic_store(&p->next_job_idx, 0); 
-    mf_atomic_store(&p->completed_count, 0);
-    
+    mf_cond_init(&p->wake_cond);
+    mf_mutex_init(&p->caller_mutex);
+    mf_atomic_store(&p->running, 1);
+    mf_atomic_store(&p->sleepers, 0);
+
     p->init_fn = desc->init_fn;
     p->cleanup_fn = desc->cleanup_fn;
     p->init_user_data = desc->user_data;
-    p->job_fn = NULL;
-    p->job_user_data = NULL;
-    
+
     for (int i = 0; i < n; ++i) {
-        worker_arg* warg = malloc(sizeof(worker_arg));
-        warg->pool = p;
-        warg->thread_idx = i;
-        mf_thread_create(&p->threads[i], worker_entry, warg);
+        mf_pool_worker* w = &p->workers[i];
+        w->pool = p;
+        w->idx = i;
+        w->rng = 0x9E3779B9u * (u32)(i + 1);
+    }
+
+    // Slot 0 is driven by whichever thread submits; its data is created here.
+    if (p->init_fn) {
+        p->workers[0].local_data = p->init_fn(0, p->init_user_data);
     }
-    
+
+    for (int i = 1; i < n; ++i) {
+        mf_thread_create(&p->threads[i - 1], worker_entry, &p->workers[i]);
+    }
+
     return p;
 }
 
 void mf_thread_pool_destroy(mf_thread_pool* pool) {
     if (!pool) return;
-    
+
     mf_mutex_lock(&pool->mutex);
-    pool->running = false;
-    mf_cond_broadcast(&pool->work_cond);
+    mf_atomic_store(&pool->running, 0);
+    pool->epoch++;
+    mf_cond_broadcast(&pool->wake_cond);
     mf_mutex_unlock(&pool->mutex);
-    
-    for (int i = 0; i < pool->num_threads; ++i) {
-        mf_thread_join(pool->threads[i]);
+
+    for (int i = 1; i < pool->num_threads; ++i) {
+        mf_thread_join(pool->threads[i - 1]);
+    }
+
+    if (pool->cleanup_fn) {
+        pool->cleanup_fn(pool->workers[0].local_data, pool->init_user_data);
     }
-    
+
     free(pool->threads);
+    free(pool->workers);
     mf_mutex_destroy(&pool->mutex);
-    mf_cond_destroy(&pool->work_cond);
-    mf_cond_destroy(&pool->done_cond);
+    mf_cond_destroy(&pool->wake_cond);
+    mf_mutex_destroy(&pool->caller_mutex);
     free(pool);
 }
 
+mf_thread_batch* mf_thread_pool_submit(
+    mf_thread_pool* pool,
+    u32 job_count,
+    mf_thread_job_func job_fn,
+    void* user_data
+) {
+    if (job_count == 0) return NULL;
+    return pool_submit(pool, 0, job_count, job_fn, user_data);
+}
+
+void mf_thread_pool_wait(mf_thread_pool* pool, mf_thread_batch* batch) {
+    if (!batch) return;
+    mf_pool_worker* w = tls_worker;
+    pool_help_until(pool, w, &batch->pending);
+    mf_atomic_store(&batch->in_use, 0);
+    pool_leave(pool, w);
+}
+
 void mf_thread_pool_run(
     mf_thread_pool* pool,
     u32 job_count,
     mf_thread_job_func job_fn,
     void* user_data
 ) {
-    if (job_count == 0) return;
-    
-    mf_mutex_lock(&pool->mutex);
-    
-    pool->job_fn = job_fn;
-    pool->job_user_data = user_data;
-    pool->total_jobs = job_count;
-    mf_atomic_store(&pool->next_job_idx, 0);
-    mf_atomic_store(&pool->completed_count, 0);
-    
-    mf_cond_broadcast(&pool->work_cond);
-    
-    while (mf_atomic_load(&pool->completed_count) < (int32_t)job_count) {
-        mf_cond_wait(&pool->done_cond, &pool->mutex);
-    }
-    
-    mf_mutex_unlock(&pool->mutex);
+    for (u32 base = 0; base < job_count; base += MF_THREAD_POOL_MAX_JOBS) {
+        u32 count = job_count - base;
+        if (count > MF_THREAD_POOL_MAX_JOBS) count = MF_THREAD_POOL_MAX_JOBS;
+        mf_thread_batch* batch = pool_submit(pool, base, count, job_fn, user_data);
+        mf_thread_pool_wait(pool, batch);
+    }
+}
+
+void mf_thread_pool_run_local(mf_thread_pool* pool, mf_thread_job_func job_fn, void* user_data) {
+    mf_pool_worker* w = pool_enter(pool);
+    job_fn(0, w->local_data, user_data);
+    pool_leave(pool, w);
+}
+
+void mf_thread_pool_region(mf_thread_pool* pool, mf_thread_region_func fn, void* user_data) {
+    mf_pool_worker* w = pool_enter(pool);
+
+    // Nested (inside a job or another region): the other threads may be busy for good
+    bool nested = w->idx != 0 || w->hold_count > 1;
+    if (nested || pool->num_threads == 1) {
+        fn(0, 1, w->local_data, user_data);
+        pool_leave(pool, w);
+        return;
+    }
+
+    pool->region_fn = fn;
+    pool->region_user_data = user_data;
+    mf_atomic_store(&pool->region_pending, pool->num_threads - 1);
+    mf_atomic_add(&pool->region_gen, 1);
+    pool_notify(pool, true);
+
+    fn(0, pool->num_threads, w->local_data, user_data);
+    pool_help_until(pool, w, &pool->region_pending);
+    pool_leave(pool, w);
+}
+
+void mf_thread_barrier_init(mf_thread_barrier* barrier, mf_thread_pool* pool, int thread_count) {
+    mf_atomic_store(&barrier->arrived, 0);
+    mf_atomic_store(&barrier->sense, 0);
+    barrier->count = thread_count;
+    barrier->spin_rounds = pool ? pool->spin_rounds : MF_POOL_SPIN_ROUNDS;
+}
+
+void mf_thread_barrier_wait(mf_thread_barrier* barrier, int32_t* local_sense) {
+    int32_t sense = 1 - *local_sense;
+    *local_sense = sense;
+    if (mf_atomic_add(&barrier->arrived, 1) == barrier->count) {
+        // Last to arrive: reset for the next phase and release everyone
+        mf_atomic_store(&barrier->arrived, 0);
+        mf_atomic_store(&barrier->sense, sense);
+        return;
+    }
+
+    u32 round = 0;
+    while (mf_atomic_load(&barrier->sense) != sense) {
+        if (round < barrier->spin_rounds) {
+            u32 spins = 1u << (round < 6 ? round : 6);
+            for (u32 i = 0; i < spins; ++i) mf_cpu_relax();
+            round++;
+        } else {
+            mf_thread_yield();
+        }
+    }
 }
 
 int mf_thread_pool_get_thread_count(mf_thread_pool* pool) {
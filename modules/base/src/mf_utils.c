@@ -288,6 +288,8 @@ mf_dtype mf_dtype_from_str(const char* s) {
     if (strcasecmp(s, "f32") == 0) return MF_DTYPE_F32;
     if (strcasecmp(s, "i32") == 0) return MF_DTYPE_I32;
     if (strcasecmp(s, "u8") == 0 || strcasecmp(s, "bool") == 0) return MF_DTYPE_U8;
+    if (strcasecmp(s, "f16") == 0 || strcasecmp(s, "half") == 0) return MF_DTYPE_F16;
+    if (strcasecmp(s, "bf16") == 0) return MF_DTYPE_BF16;
     
     return MF_DTYPE_F32;
 }
@@ -29,7 +29,7 @@ void mf_compiler_diag_report(mf_compiler_diag* diag, mf_source_loc loc, const ch
 typedef enum {
     MF_NODE_UNKNOWN = 0,
     
-#define MF_OP(suffix, name, op_suffix, cat, strat, in_mask, out_mask, out_rule, shape_rule, access_rule, p1, p2, p3, p4, ktype, kernel, karity) MF_NODE_##suffix,
+#define MF_OP(suffix, name, op_suffix, cat, strat, in_mask, out_mask, out_rule, shape_rule, access_rule, p1, p2, p3, p4, ktype, kernel, vkernel, karity) MF_NODE_##suffix,
     MF_OP_LIST
 #undef MF_OP
 
@@ -105,6 +105,7 @@ typedef struct {
     u8 vsync;
     u8 fullscreen;
     u8 resizable;
+    u8 exec_profile; // mf_exec_profile ("runtime": {"profile": ...})
 } mf_graph_ir;
 
 // --- Manifest Interface ---
@@ -6,6 +6,73 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+// --- Task Dependency Graph ---
+
+static inline bool bits_test(const u64* bits, u32 i) { return (bits[i >> 6] >> (i & 63)) & 1; }
+static inline void bits_set(u64* bits, u32 i) { bits[i >> 6] |= 1ull << (i & 63); }
+
+static bool bits_intersect(const u64* a, const u64* b, u32 words) {
+    for (u32 w = 0; w < words; ++w) if (a[w] & b[w]) return true;
+    return false;
+}
+
+/**
+ * Task j depends on an earlier task i if one of them writes a register the other
+ * touches (RAW, WAR, WAW). Registers are recycled by liveness, so WAR/WAW matter.
+ * Edges already implied by another dependency are dropped.
+ */
+static void emit_task_deps(mf_program* prog, mf_arena* arena) {
+    u32 task_count = prog->meta.task_count;
+    prog->task_deps = NULL;
+    prog->meta.task_dep_count = 0;
+    if (task_count < 2) return;
+
+    u32 reg_words = (prog->meta.tensor_count + 63) / 64;
+    u32 task_words = (task_count + 63) / 64;
+    u64* touched = MF_ARENA_PUSH(arena, u64, (size_t)task_count * reg_words);
+    u64* written = MF_ARENA_PUSH(arena, u64, (size_t)task_count * reg_words);
+    u64* ancestors = MF_ARENA_PUSH(arena, u64, (size_t)task_count * task_words);
+    memset(touched, 0, sizeof(u64) * task_count * reg_words);
+    memset(written, 0, sizeof(u64) * task_count * reg_words);
+    memset(ancestors, 0, sizeof(u64) * task_count * task_words);
+
+    for (u32 t = 0; t < task_count; ++t) {
+        const mf_task* task = &prog->tasks[t];
+        for (u32 b = 0; b < task->binding_count; ++b) {
+            const mf_bin_task_binding* bind = &prog->bindings[task->binding_offset + b];
+            bits_set(&touched[t * reg_words], bind->reg_idx);
+            if (bind->flags & MF_BINDING_FLAG_WRITE) bits_set(&written[t * reg_words], bind->reg_idx);
+        }
+    }
+
+    u32* deps = MF_ARENA_PUSH(arena, u32, (size_t)task_count * (task_count - 1) / 2);
+    u32 dep_count = 0;
+
+    for (u32 j = 0; j < task_count; ++j) {
+        mf_task* task = &prog->tasks[j];
+        u64* anc_j = &ancestors[j * task_words];
+        task->dep_offset = dep_count;
+        task->dep_count = 0;
+
+        // Nearest first, so anything reachable through a closer dependency is already known
+        for (u32 i = j; i-- > 0; ) {
+            if (bits_test(anc_j, i)) continue;
+            bool conflict = bits_intersect(&written[i * reg_words], &touched[j * reg_words], reg_words) ||
+                            bits_intersect(&touched[i * reg_words], &written[j * reg_words], reg_words);
+            if (!conflict) continue;
+
+            deps[dep_count++] = i;
+            task->dep_count++;
+            const u64* anc_i = &ancestors[i * task_words];
+            for (u32 w = 0; w < task_words; ++w) anc_j[w] |= anc_i[w];
+            bits_set(anc_j, i);
+        }
+    }
+
+    prog->task_deps = deps;
+    prog->meta.task_dep_count = dep_count;
+}
+
 bool mf_codegen_emit(mf_program* prog, mf_graph_ir* ir, mf_ir_node** sorted, size_t sorted_count, mf_arena* arena) {
     u16 max_reg = 0;
     for (size_t i = 0; i < sorted_count; ++i) {
@@ -47,7 +114,6 @@ bool mf_codegen_emit(mf_program* prog, mf_graph_ir* ir, mf_ir_node** sorted, siz
     u32 current_symbol = 0;
     u32 current_domain_node_idx = UINT32_MAX;
     u8 current_strategy = MF_STRATEGY_DEFAULT;
-    bool needs_sync_scratch = false;
 
     for (size_t i = 0; i < sorted_count; ++i) {
         mf_ir_node* node = sorted[i];
@@ -81,6 +147,9 @@ bool mf_codegen_emit(mf_program* prog, mf_graph_ir* ir, mf_ir_node** sorted, siz
             *t_info = node->out_info;
         }
 
+        // Filter output: the task writing it sets its length at run time
+        if (node->type == MF_NODE_COMPRESS) prog->tensor_flags[r_idx] |= MF_TENSOR_FLAG_DYNAMIC;
+
         if (node->builtin_id != MF_BUILTIN_NONE) {
             prog->builtin_ids[r_idx] = (uint8_t)node->builtin_id;
             prog->builtin_axes[r_idx] = (uint8_t)node->builtin_axis;
@@ -116,14 +185,15 @@ bool mf_codegen_emit(mf_program* prog, mf_graph_ir* ir, mf_ir_node** sorted, siz
 
         // --- 4. Task Management ---
         if (emitted) {
-            bool is_sync = (meta->strategy == MF_STRATEGY_TWO_PASS_SYNC);
+            bool is_scan = (meta->strategy == MF_STRATEGY_SCAN);
+            bool is_sort = (meta->strategy == MF_STRATEGY_SORT);
             bool is_reduction = (meta->strategy == MF_STRATEGY_REDUCTION);
+            bool is_scatter = (meta->strategy == MF_STRATEGY_SCATTER);
             bool domain_changed = (current_domain_node_idx == UINT32_MAX || node->domain_node_idx != current_domain_node_idx);
             
             if (is_reduction && r_idx < MF_MAX_REGISTERS) prog->tensor_flags[r_idx] |= MF_TENSOR_FLAG_REDUCTION;
-            if (is_sync) needs_sync_scratch = true;
 
-            bool needs_split = domain_changed || is_sync || (current_strategy != meta->strategy);
+            bool needs_split = domain_changed || is_scan || is_sort || (current_strategy != meta->strategy);
 
             if (needs_split && task_count > 0) {
                 mf_task* prev_task = &tasks[task_count - 1];
@@ -131,6 +201,7 @@ bool mf_codegen_emit(mf_program* prog, mf_graph_ir* ir, mf_ir_node** sorted, siz
             }
 
             if (needs_split || task_count == 0) {
+                memset(&tasks[task_count], 0, sizeof(mf_task));
                 tasks[task_count].start_inst = start_instr_idx;
                 tasks[task_count].strategy = meta->strategy;
                 u32 dom_node_idx = (node->domain_node_idx == UINT32_MAX) ? node_idx : node->domain_node_idx;
@@ -156,6 +227,8 @@ bool mf_codegen_emit(mf_program* prog, mf_graph_ir* ir, mf_ir_node** sorted, siz
                 for (u32 b = 0; b < curr_task->binding_count; ++b) {
                     if (bindings[curr_task->binding_offset + b].reg_idx == r) {
                         if (is_reduction && k == 0) bindings[curr_task->binding_offset + b].flags |= MF_BINDING_FLAG_REDUCTION;
+                        if (is_scatter && k == 0) bindings[curr_task->binding_offset + b].flags |= MF_BINDING_FLAG_SCATTER;
+                        if (k == 0) bindings[curr_task->binding_offset + b].flags |= MF_BINDING_FLAG_WRITE;
                         found = true; break;
                     }
                 }
@@ -164,6 +237,8 @@ bool mf_codegen_emit(mf_program* prog, mf_graph_ir* ir, mf_ir_node** sorted, siz
                     b->reg_idx = r;
                     b->byte_stride = 0; // Filled by backend or during serialization
                     b->flags = (is_reduction && k == 0) ? MF_BINDING_FLAG_REDUCTION : 0;
+                    if (is_scatter && k == 0) b->flags |= MF_BINDING_FLAG_SCATTER;
+                    if (k == 0) b->flags |= MF_BINDING_FLAG_WRITE;
                     curr_task->binding_count++;
                 }
             }
@@ -181,13 +256,19 @@ bool mf_codegen_emit(mf_program* prog, mf_graph_ir* ir, mf_ir_node** sorted, siz
     prog->meta.task_count = task_count;
     prog->meta.binding_count = total_binding_count;
 
-    u32 reduction_reg_count = 0;
+    // One accumulator per element of a reduction register (segmented reductions have several)
+    u32 reduction_acc_count = 0;
     for (int r = 0; r < (int)prog->meta.tensor_count; ++r) {
-        if (prog->tensor_flags[r] & MF_TENSOR_FLAG_REDUCTION) reduction_reg_count = MF_MAX_REGISTERS; 
+        if (!(prog->tensor_flags[r] & MF_TENSOR_FLAG_REDUCTION)) continue;
+        const mf_type_info* info = &prog->tensor_infos[r];
+        size_t slots = mf_shape_calc_count(info->shape, info->ndim);
+        reduction_acc_count += (u32)(slots > 0 ? slots : 1);
     }
 
-    prog->meta.reduction_scratch_size = reduction_reg_count;
-    prog->meta.sync_scratch_size = needs_sync_scratch ? 1024 : 0; 
+    prog->meta.reduction_scratch_size = reduction_acc_count;
+    prog->meta.exec_profile = ir->exec_profile;
+
+    emit_task_deps(prog, arena);
 
     return true;
 }
\ No newline at end of file
@@ -61,13 +61,27 @@ mf_program* mf_compile(mf_graph_ir* ir, mf_arena* arena, mf_compiler_diag* diag)
         return NULL;
     }
 
-    // 2a. Register Allocation (Liveness Analysis)
-    if (!mf_pass_liveness(ir, sorted, sorted_count, diag)) {
+    // 2a. Domain Splitting (Multi-Domain Support)
+    if (!mf_pass_domain_split(ir, diag)) {
         return NULL;
     }
 
-    // 2b. Domain Splitting (Multi-Domain Support)
-    if (!mf_pass_domain_split(ir, diag)) {
+    // 2a.5 Half Storage: readers that compute get widening Copies
+    bool storage_changed = false;
+    if (!mf_pass_storage(ir, arena, &storage_changed, diag)) {
+        return NULL;
+    }
+    if (storage_changed) {
+        sorted = mf_topo_sort(ir, arena, &sorted_count);
+        if (!sorted) {
+            mf_source_loc loc = {0};
+            mf_compiler_diag_report(diag, loc, "Sorting failed after storage pass.");
+            return NULL;
+        }
+    }
+
+    // 2b. Register Allocation (Liveness Analysis, per domain)
+    if (!mf_pass_liveness(ir, sorted, sorted_count, diag)) {
         return NULL;
     }
 
@@ -109,6 +123,11 @@ static size_t _write_program(const mf_program* prog, FILE* f) {
         fwrite(prog->bindings, sizeof(mf_bin_task_binding), prog->meta.binding_count, f);
     }
 
+    // 4.6 Task Dependencies
+    if (prog->meta.task_dep_count > 0) {
+        fwrite(prog->task_deps, sizeof(uint32_t), prog->meta.task_dep_count, f);
+    }
+
     // 5. Tensor Metadata
     for (u32 i = 0; i < prog->meta.tensor_count; ++i) {
         mf_type_info* info = &prog->tensor_infos[i];
@@ -165,6 +184,7 @@ bool mf_compile_save_cartridge(const char* path, const mf_graph_ir* ir, const mf
         cart.vsync = ir->vsync;
         cart.fullscreen = ir->fullscreen;
         cart.resizable = ir->resizable;
+        cart.exec_profile = ir->exec_profile;
     } else {
         strncpy(cart.app_title, "MathFlow Cartridge", MF_MAX_TITLE_NAME - 1);
         cart.window_width = 800;
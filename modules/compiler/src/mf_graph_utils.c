@@ -2,6 +2,13 @@
 #include <mathflow/base/mf_json.h>
 #include <string.h>
 
+static u8 parse_exec_profile(const char* s) {
+    if (strcmp(s, "safe") == 0) return MF_EXEC_PROFILE_SAFE;
+    if (strcmp(s, "fast") == 0) return MF_EXEC_PROFILE_FAST;
+    if (strcmp(s, "fast_checked") == 0) return MF_EXEC_PROFILE_FAST_CHECKED;
+    return MF_EXEC_PROFILE_DEFAULT;
+}
+
 void mf_ir_parse_window_settings(const mf_json_value* root, mf_graph_ir* out_ir) {
     if (!root || root->type != MF_JSON_VAL_OBJECT) return;
 
@@ -37,6 +44,9 @@ void mf_ir_parse_window_settings(const mf_json_value* root, mf_graph_ir* out_ir)
     if (runtime && runtime->type == MF_JSON_VAL_OBJECT) {
         const mf_json_value* threads = mf_json_get_field(runtime, "threads");
         if (threads && threads->type == MF_JSON_VAL_NUMBER) out_ir->num_threads = (u32)threads->as.n;
+
+        const mf_json_value* profile = mf_json_get_field(runtime, "profile");
+        if (profile && profile->type == MF_JSON_VAL_STRING) out_ir->exec_profile = parse_exec_profile(profile->as.s);
     }
 }
 
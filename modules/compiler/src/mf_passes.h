@@ -51,8 +51,18 @@ bool mf_pass_domain_split(mf_graph_ir* ir, mf_compiler_diag* diag);
 // Fuses (Mul + Add) into FMA instructions.
 bool mf_pass_fuse(mf_graph_ir* ir, mf_compiler_diag* diag);
 
+// --- Pass: Half Storage ---
+// F16/BF16 registers are only read by nodes that move elements (Copy, Output, memory ops).
+// Any other reader gets a widening Copy to f32 in its domain, so loads stay fused in its task.
+// Adds nodes and links: the caller re-sorts when it returns true in *changed.
+bool mf_pass_storage(mf_graph_ir* ir, mf_arena* arena, bool* changed, mf_compiler_diag* diag);
+
+// Nodes whose output may stay in a half dtype (they never compute on the values)
+bool mf_node_keeps_storage(mf_node_type type);
+
 // --- Pass: Register Allocation (Liveness Analysis) ---
 // Minimizes the number of registers by reusing them for non-overlapping lifetimes.
+// Runs after domain splitting: registers are never shared between domains.
 bool mf_pass_liveness(mf_graph_ir* ir, mf_ir_node** sorted, size_t count, mf_compiler_diag* diag);
 
 #endif // MF_PASSES_H
@@ -78,9 +78,16 @@ bool mf_pass_analyze(mf_graph_ir* ir, mf_ir_node** sorted_nodes, size_t count, m
 
             case MF_SHAPE_MATMUL:
                 if (!inputs[0] || !inputs[1]) { MF_REPORT_NODE(diag, node, "Missing inputs for matmul"); return false; }
-                out->ndim = 2;
-                out->shape[0] = inputs[0]->out_info.shape[inputs[0]->out_info.ndim - 2];
-                out->shape[1] = inputs[1]->out_info.shape[inputs[1]->out_info.ndim - 1];
+                {
+                    // Leading dims are a batch of matrices, taken from whichever input has them
+                    const mf_type_info* a = &inputs[0]->out_info;
+                    const mf_type_info* b = &inputs[1]->out_info;
+                    const mf_type_info* batch = (b->ndim > a->ndim) ? b : a;
+                    out->ndim = batch->ndim >= 2 ? batch->ndim : 2;
+                    for (int k = 0; k + 2 < out->ndim; ++k) out->shape[k] = batch->shape[k];
+                    out->shape[out->ndim - 2] = a->ndim >= 2 ? a->shape[a->ndim - 2] : 1;
+                    out->shape[out->ndim - 1] = b->ndim >= 1 ? b->shape[b->ndim - 1] : 1;
+                }
                 break;
 
             case MF_SHAPE_TRANSPOSE: if (!inputs[0]) { MF_REPORT_NODE(diag, node, "Missing input for transpose"); return false; } *out = inputs[0]->out_info; if (out->ndim >= 2) { int32_t t = out->shape[out->ndim-2]; out->shape[out->ndim-2] = out->shape[out->ndim-1]; out->shape[out->ndim-1] = t; } break;
@@ -90,6 +97,28 @@ bool mf_pass_analyze(mf_graph_ir* ir, mf_ir_node** sorted_nodes, size_t count, m
             case MF_SHAPE_RESHAPE: if (!inputs[1] || !inputs[1]->const_data) { MF_REPORT_NODE(diag, node, "Reshape needs constant shape input"); return false; } { int cnt = (int)mf_shape_calc_count(inputs[1]->const_info.shape, inputs[1]->const_info.ndim); out->ndim = (uint8_t)cnt; for(int k=0; k<cnt && k<MF_MAX_DIMS; ++k) out->shape[k] = (inputs[1]->const_info.dtype == MF_DTYPE_F32) ? (int)((f32*)inputs[1]->const_data)[k] : ((int*)inputs[1]->const_data)[k]; } break;
             case MF_SHAPE_SLICE: if (!inputs[1] || !inputs[1]->const_data) { MF_REPORT_NODE(diag, node, "Slice needs constant range input"); return false; } out->ndim = 1; out->shape[0] = (inputs[1]->const_info.dtype == MF_DTYPE_F32) ? (int)((f32*)inputs[1]->const_data)[1] : ((int*)inputs[1]->const_data)[1]; break;
             case MF_SHAPE_SCALAR: out->ndim = 0; out->shape[0] = 1; break;
+            case MF_SHAPE_SEGMENTS:
+                {
+                    const mf_ir_node* segs = inputs[meta->arity - 1];
+                    if (!segs || !segs->const_data) { MF_REPORT_NODE(diag, node, "%s needs a constant segment count", meta->name); return false; }
+                    int n = (segs->const_info.dtype == MF_DTYPE_F32) ? (int)((f32*)segs->const_data)[0] : ((int*)segs->const_data)[0];
+                    if (n <= 0) { MF_REPORT_NODE(diag, node, "Segment count must be positive in '%s' (got %d)", node->id, n); return false; }
+                    out->ndim = 1; out->shape[0] = n;
+                }
+                break;
+            case MF_SHAPE_SCATTER: if (inputs[2]) { out->ndim = inputs[2]->out_info.ndim; memcpy(out->shape, inputs[2]->out_info.shape, sizeof(int32_t)*MF_MAX_DIMS); } else { MF_REPORT_NODE(diag, node, "%s needs a base to write into", meta->name); return false; } break;
+            case MF_SHAPE_REDUCE_AXIS:
+                if (!inputs[0] || !inputs[1] || !inputs[1]->const_data) { MF_REPORT_NODE(diag, node, "%s needs an input and a constant axis", meta->name); return false; }
+                {
+                    const mf_type_info* in = &inputs[0]->out_info;
+                    int axis = (inputs[1]->const_info.dtype == MF_DTYPE_F32) ? (int)((f32*)inputs[1]->const_data)[0] : ((int*)inputs[1]->const_data)[0];
+                    if (axis < 0) axis += in->ndim;
+                    if (axis < 0 || axis >= in->ndim) { MF_REPORT_NODE(diag, node, "Axis %d out of range for a %dD input in '%s'", axis, in->ndim, node->id); return false; }
+                    out->ndim = (uint8_t)(in->ndim - 1);
+                    for (int k = 0; k < out->ndim; ++k) out->shape[k] = in->shape[k < axis ? k : k + 1];
+                    if (out->ndim == 0) out->shape[0] = 1;
+                }
+                break;
         }
 
         // 2. Resolve DType
@@ -105,6 +134,11 @@ bool mf_pass_analyze(mf_graph_ir* ir, mf_ir_node** sorted_nodes, size_t count, m
         if (dtype == MF_DTYPE_UNKNOWN) {
             dtype = (out->dtype != MF_DTYPE_UNKNOWN) ? out->dtype : MF_DTYPE_F32;
         }
+        // Requested storage: a Copy converts to its dtype, an Output keeps a declared half dtype
+        if (node->type == MF_NODE_COPY && node->const_info.dtype != MF_DTYPE_UNKNOWN) dtype = node->const_info.dtype;
+        if (node->type == MF_NODE_OUTPUT && mf_dtype_is_half(node->const_info.dtype)) dtype = node->const_info.dtype;
+        // Half is storage only: arithmetic produces f32 (mf_pass_storage widens its operands)
+        if (mf_dtype_is_half(dtype) && !mf_node_keeps_storage(node->type)) dtype = MF_DTYPE_F32;
         out->dtype = dtype;
 
         // 3. Strides & Spatial Analysis
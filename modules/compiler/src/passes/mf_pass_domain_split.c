@@ -1,6 +1,8 @@
-#include "mf_passes.h"
+#include "../mf_passes.h"
+#include "../mf_compiler_internal.h"
 #include <mathflow/base/mf_log.h>
 #include <mathflow/base/mf_shape.h>
+#include <mathflow/isa/mf_op_defs.h>
 #include <string.h>
 
 static bool shapes_equal(const mf_type_info* a, const mf_type_info* b) {
@@ -11,9 +13,54 @@ static bool shapes_equal(const mf_type_info* a, const mf_type_info* b) {
     return true;
 }
 
+// Reductions and scatters run over the elements they consume, not over the shape they produce
+static bool runs_over_input(const mf_ir_node* node) {
+    if (node->type <= MF_NODE_UNKNOWN || node->type >= MF_NODE_COUNT) return false;
+    mf_dispatch_strategy strategy = MF_OP_METADATA[node->type].strategy;
+    return strategy == MF_STRATEGY_REDUCTION || strategy == MF_STRATEGY_SCATTER;
+}
+
+static void mark_domain(mf_graph_ir* ir, u32 node_idx, u32 domain_idx);
+
+/**
+ * A reduction takes the domain of its input, whatever domain reached it: the input
+ * starts a domain of its own (or keeps the one it already has). Further inputs of
+ * that shape (segment ids, scatter indices) join it.
+ */
+static void mark_reduction_domain(mf_graph_ir* ir, u32 node_idx) {
+    mf_ir_node* node = &ir->nodes[node_idx];
+    if (node->domain_node_idx != UINT32_MAX) return;
+    node->domain_node_idx = node_idx; // Visited; a reduction without input runs alone
+
+    for (size_t i = 0; i < ir->link_count; ++i) {
+        // The first port is the reduced stream (segment ids and counts are not)
+        if (ir->links[i].dst_node_idx != node_idx || ir->links[i].dst_port != 0) continue;
+        u32 src = ir->links[i].src_node_idx;
+        mark_domain(ir, src, src);
+        // The input's domain, unless the input is not that shape (a reduction itself)
+        u32 dom = ir->nodes[src].domain_node_idx;
+        bool same = (dom != UINT32_MAX) && shapes_equal(&ir->nodes[src].out_info, &ir->nodes[dom].out_info);
+        node->domain_node_idx = same ? dom : src;
+        break;
+    }
+
+    // Segment ids and scatter indices run alongside the stream
+    for (size_t i = 0; i < ir->link_count; ++i) {
+        if (ir->links[i].dst_node_idx != node_idx || ir->links[i].dst_port == 0) continue;
+        u32 src = ir->links[i].src_node_idx;
+        if (shapes_equal(&ir->nodes[src].out_info, &ir->nodes[node->domain_node_idx].out_info)) mark_domain(ir, src, node->domain_node_idx);
+        else mark_domain(ir, src, src);
+    }
+}
+
 static void mark_domain(mf_graph_ir* ir, u32 node_idx, u32 domain_idx) {
     mf_ir_node* node = &ir->nodes[node_idx];
     
+    if (runs_over_input(node)) {
+        mark_reduction_domain(ir, node_idx);
+        return;
+    }
+
     if (node->domain_node_idx != UINT32_MAX) {
         if (node->domain_node_idx != domain_idx) {
             // Node is used by multiple domains. 
@@ -36,11 +83,33 @@ static void mark_domain(mf_graph_ir* ir, u32 node_idx, u32 domain_idx) {
 
     node->domain_node_idx = domain_idx;
 
-    // Recurse to inputs
+    // Recurse to inputs. Ops that read more than their own element (MatMul, Dot, axis
+    // reductions, ...) need an input of another shape whole: it starts its own domain.
+    bool elementwise = node->type >= MF_NODE_COUNT || MF_OP_METADATA[node->type].access_pattern == MF_ACCESS_LINEAR ||
+                       MF_OP_METADATA[node->type].access_pattern == MF_ACCESS_SPECIAL;
     for (size_t i = 0; i < ir->link_count; ++i) {
-        if (ir->links[i].dst_node_idx == node_idx) {
-            mark_domain(ir, ir->links[i].src_node_idx, domain_idx);
-        }
+        if (ir->links[i].dst_node_idx != node_idx) continue;
+        u32 src = ir->links[i].src_node_idx;
+        if (elementwise || shapes_equal(&ir->nodes[src].out_info, &ir->nodes[domain_idx].out_info)) mark_domain(ir, src, domain_idx);
+        else mark_domain(ir, src, src);
+    }
+}
+
+/**
+ * A Filter's output is only as long as its survivors, which is known at run time.
+ * Nodes downstream of it (same shape) take the Filter as their domain, so their tasks
+ * run over the compacted length. A nested Filter starts its own domain.
+ */
+static void mark_filter_domain(mf_graph_ir* ir, u32 node_idx, u32 filter_idx) {
+    for (size_t i = 0; i < ir->link_count; ++i) {
+        if (ir->links[i].src_node_idx != node_idx) continue;
+        u32 dst = ir->links[i].dst_node_idx;
+        mf_ir_node* node = &ir->nodes[dst];
+        // A reduction of the compacted stream runs over the survivors too
+        bool reduces = runs_over_input(node);
+        if (node->domain_node_idx == filter_idx || (!reduces && !shapes_equal(&node->out_info, &ir->nodes[filter_idx].out_info))) continue;
+        node->domain_node_idx = filter_idx;
+        if (node->type != MF_NODE_COMPRESS && !reduces) mark_filter_domain(ir, dst, filter_idx);
     }
 }
 
@@ -74,5 +143,10 @@ bool mf_pass_domain_split(mf_graph_ir* ir, mf_compiler_diag* diag) {
         }
     }
 
+    // 3. Filters re-domain everything they feed
+    for (size_t i = 0; i < ir->node_count; ++i) {
+        if (ir->nodes[i].type == MF_NODE_COMPRESS) mark_filter_domain(ir, (u32)i, (u32)i);
+    }
+
     return true;
 }
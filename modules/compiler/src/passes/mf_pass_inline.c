@@ -259,6 +259,18 @@ static bool expand_graph_step(mf_graph_ir* src, mf_graph_ir* dst, mf_arena* aren
         dst->links[li++] = cur->l;
     }
 
+    // A subgraph Input bound by its caller is no resource: it copies the caller's value
+    for (size_t i = 0; i < dst->link_count; ++i) {
+        mf_ir_node* bound = &dst->nodes[dst->links[i].dst_node_idx];
+        if (bound->type != MF_NODE_INPUT) continue;
+        dst->links[i].dst_port = 0;
+        dst->links[i].dst_port_name = "in";
+        bound->type = MF_NODE_COPY;
+        bound->const_info.dtype = MF_DTYPE_UNKNOWN; // Keep the caller's dtype
+        bound->provider = NULL;
+        bound->builtin_id = MF_BUILTIN_NONE;
+    }
+
     return true;
 }
 
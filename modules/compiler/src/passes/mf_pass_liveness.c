@@ -53,7 +53,7 @@ bool mf_pass_liveness(mf_graph_ir* ir, mf_ir_node** sorted, size_t count, mf_com
 
         // Special handling for persistent nodes (Inputs, Constants, Outputs)
         // AND for nodes that change shape (to avoid buffer overflow in aliased registers)
-        bool change_shape = (node->type == MF_NODE_JOIN || node->type == MF_NODE_RESHAPE || node->type == MF_NODE_SLICE);
+        bool change_shape = (node->type == MF_NODE_JOIN || node->type == MF_NODE_RESHAPE || node->type == MF_NODE_SLICE || node->type == MF_NODE_COMPRESS);
         bool persistent = (node->type == MF_NODE_INPUT || node->type == MF_NODE_CONST || node->type == MF_NODE_OUTPUT || change_shape);
 
         if (persistent) {
@@ -76,6 +76,8 @@ bool mf_pass_liveness(mf_graph_ir* ir, mf_ir_node** sorted, size_t count, mf_com
                     for (u32 j = 0; j < i; ++j) {
                         if (sorted[j]->out_reg_idx == r) {
                             if (sorted[j]->out_info.dtype != node->out_info.dtype) { compatible = false; break; }
+                            // Sharing a register across domains would chain otherwise independent tasks
+                            if (sorted[j]->domain_node_idx != node->domain_node_idx) { compatible = false; break; }
                             size_t old_cnt = mf_shape_calc_count(sorted[j]->out_info.shape, sorted[j]->out_info.ndim);
                             size_t new_cnt = mf_shape_calc_count(node->out_info.shape, node->out_info.ndim);
                             if (old_cnt != new_cnt) { compatible = false; break; }
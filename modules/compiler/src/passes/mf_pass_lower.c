@@ -3,6 +3,7 @@
 #include <mathflow/base/mf_utils.h>
 #include <mathflow/base/mf_log.h>
 #include <mathflow/base/mf_shape.h>
+#include <mathflow/base/mf_half.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -64,11 +65,16 @@ static void parse_const_tensor(const mf_json_value* val, const mf_json_value* no
             if (dtype == MF_DTYPE_F32) ((f32*)*out_data)[i] = (f32)item->as.n;
             else if (dtype == MF_DTYPE_I32) ((i32*)*out_data)[i] = (i32)item->as.n;
             else if (dtype == MF_DTYPE_U8) ((u8*)*out_data)[i] = (u8)item->as.n;
+            else if (mf_dtype_is_half(dtype)) mf_dtype_store_f32(*out_data, dtype, i, (f32)item->as.n);
         }
     } else if (val->type == MF_JSON_VAL_NUMBER) {
-        if (dtype == MF_DTYPE_F32) ((f32*)*out_data)[0] = (f32)val->as.n;
-        else if (dtype == MF_DTYPE_I32) ((i32*)*out_data)[0] = (i32)val->as.n;
-        else if (dtype == MF_DTYPE_U8) ((u8*)*out_data)[0] = (u8)val->as.n;
+        // A single number fills the whole shape (e.g. a zeroed Scatter target)
+        for (size_t i = 0; i < count; ++i) {
+            if (dtype == MF_DTYPE_F32) ((f32*)*out_data)[i] = (f32)val->as.n;
+            else if (dtype == MF_DTYPE_I32) ((i32*)*out_data)[i] = (i32)val->as.n;
+            else if (dtype == MF_DTYPE_U8) ((u8*)*out_data)[i] = (u8)val->as.n;
+            else if (mf_dtype_is_half(dtype)) mf_dtype_store_f32(*out_data, dtype, i, (f32)val->as.n);
+        }
     }
 }
 
@@ -151,6 +157,12 @@ static bool parse_node_attributes(mf_ir_node* dst, const mf_json_value* data, co
             if (v_val) parse_const_tensor(v_val, data, &dst->const_info, &dst->const_data, arena);
             break;
         }
+        case MF_NODE_COPY: {
+            // Optional target dtype: Copy converts, e.g. to keep an intermediate in F16
+            const mf_json_value* v_dtype = mf_json_get_field(data, "dtype");
+            if (v_dtype && v_dtype->type == MF_JSON_VAL_STRING) dst->const_info.dtype = mf_dtype_from_str(v_dtype->as.s);
+            break;
+        }
         case MF_NODE_CALL: {
             const mf_json_value* v_path = mf_json_get_field(data, "path");
             if (v_path && v_path->type == MF_JSON_VAL_STRING) {
@@ -168,6 +180,75 @@ static bool parse_node_attributes(mf_ir_node* dst, const mf_json_value* data, co
     return true;
 }
 
+// Reductions along one dimension: {"axis": k} on ReduceSum/Min/Max/Mean
+static mf_node_type get_axis_variant(mf_node_type type) {
+    switch (type) {
+        case MF_NODE_REDUCE_SUM:  return MF_NODE_REDUCE_SUM_AXIS;
+        case MF_NODE_REDUCE_MIN:  return MF_NODE_REDUCE_MIN_AXIS;
+        case MF_NODE_REDUCE_MAX:  return MF_NODE_REDUCE_MAX_AXIS;
+        case MF_NODE_REDUCE_MEAN: return MF_NODE_REDUCE_MEAN_AXIS;
+        default:                  return MF_NODE_UNKNOWN;
+    }
+}
+
+static const mf_json_value* get_axis_attribute(const mf_ir_node* node, const mf_ast_node* src) {
+    if (!src->data || get_axis_variant(node->type) == MF_NODE_UNKNOWN) return NULL;
+    const mf_json_value* v_axis = mf_json_get_field(src->data, "axis");
+    return (v_axis && v_axis->type == MF_JSON_VAL_NUMBER) ? v_axis : NULL;
+}
+
+/**
+ * Turns reductions with an axis attribute into their axis variant. The axis reaches
+ * the kernel like a Reshape's shape does: as a constant (appended, i32 scalar) on the
+ * "axis" port.
+ */
+static bool lower_axis_attributes(const mf_ast_graph* ast, mf_graph_ir* ir, mf_arena* arena) {
+    size_t count = 0;
+    for (size_t i = 0; i < ast->node_count; ++i) {
+        if (get_axis_attribute(&ir->nodes[i], &ast->nodes[i])) count++;
+    }
+    if (count == 0) return true;
+
+    mf_ir_node* nodes = MF_ARENA_PUSH(arena, mf_ir_node, ir->node_count + count);
+    mf_ir_link* links = MF_ARENA_PUSH(arena, mf_ir_link, ir->link_count + count);
+    if (!nodes || !links) return false;
+    memcpy(nodes, ir->nodes, sizeof(mf_ir_node) * ir->node_count);
+    memset(nodes + ir->node_count, 0, sizeof(mf_ir_node) * count);
+    if (ir->link_count) memcpy(links, ir->links, sizeof(mf_ir_link) * ir->link_count);
+    ir->nodes = nodes;
+    ir->links = links;
+    ir->node_cap = ir->node_count + count;
+    ir->link_cap = ir->link_count + count;
+
+    for (size_t i = 0; i < ast->node_count; ++i) {
+        mf_ir_node* node = &ir->nodes[i];
+        const mf_json_value* v_axis = get_axis_attribute(node, &ast->nodes[i]);
+        if (!v_axis) continue;
+        node->type = get_axis_variant(node->type);
+
+        u32 axis_idx = (u32)ir->node_count++;
+        mf_ir_node* axis = &ir->nodes[axis_idx];
+        axis->id = mf_arena_sprintf(arena, "%s.axis", node->id);
+        axis->type = MF_NODE_CONST;
+        axis->loc = node->loc;
+        axis->domain_node_idx = UINT32_MAX;
+        int32_t shape[MF_MAX_DIMS] = {0};
+        mf_type_info_init_contiguous(&axis->const_info, MF_DTYPE_I32, shape, 0);
+        axis->const_data = MF_ARENA_PUSH(arena, i32, 1);
+        if (!axis->const_data) return false;
+        *(i32*)axis->const_data = (i32)v_axis->as.n;
+
+        mf_ir_link* link = &ir->links[ir->link_count++];
+        memset(link, 0, sizeof(mf_ir_link));
+        link->src_node_idx = axis_idx;
+        link->src_port_name = "out";
+        link->dst_node_idx = (u32)i;
+        link->dst_port = get_port_index(node->type, "axis");
+        link->dst_port_name = "axis";
+    }
+    return true;
+}
+
 // --- Main Pass ---
 
 bool mf_pass_lower(mf_ast_graph* ast, mf_graph_ir* out_ir, mf_arena* arena, const char* base_path, mf_compiler_diag* diag) {
@@ -299,5 +380,11 @@ bool mf_pass_lower(mf_ast_graph* ast, mf_graph_ir* out_ir, mf_arena* arena, cons
         }
     }
 
+    // 4. Process Axis Attributes (after the links: the variants keep the reduced input's port)
+    if (!lower_axis_attributes(ast, out_ir, arena)) {
+        MF_REPORT(diag, NULL, "Lowering Pass: Out of memory for axis constants");
+        return false;
+    }
+
     return true;
 }
\ No newline at end of file
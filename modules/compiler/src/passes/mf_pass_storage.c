@@ -0,0 +1,120 @@
+#include "../mf_passes.h"
+#include "../mf_compiler_internal.h"
+#include <mathflow/base/mf_log.h>
+#include <mathflow/isa/mf_op_defs.h>
+#include <string.h>
+
+bool mf_node_keeps_storage(mf_node_type type) {
+    switch (type) {
+        case MF_NODE_INPUT:
+        case MF_NODE_CONST:
+        case MF_NODE_OUTPUT:
+        case MF_NODE_COPY:
+            return true;
+        default:
+            return type < MF_NODE_COUNT && MF_OP_METADATA[type].category == MF_OP_CAT_MEMORY;
+    }
+}
+
+// Memory ops move their data operand only; indices, masks and ranges are read as numbers
+static bool link_keeps_storage(const mf_ir_node* dst, const mf_ir_link* link) {
+    if (!mf_node_keeps_storage(dst->type)) return false;
+    const char* data_port = MF_OP_METADATA[dst->type].ports[0];
+    return data_port && link->dst_port_name && strcmp(link->dst_port_name, data_port) == 0;
+}
+
+static bool shapes_equal(const mf_type_info* a, const mf_type_info* b) {
+    if (a->ndim != b->ndim) return false;
+    for (int i = 0; i < a->ndim; ++i) if (a->shape[i] != b->shape[i]) return false;
+    return true;
+}
+
+static bool link_needs_widening(const mf_graph_ir* ir, const mf_ir_link* link) {
+    if (link->src_node_idx >= ir->node_count || link->dst_node_idx >= ir->node_count) return false;
+    const mf_ir_node* src = &ir->nodes[link->src_node_idx];
+    const mf_ir_node* dst = &ir->nodes[link->dst_node_idx];
+    if (dst->type == MF_NODE_UNKNOWN) return false;
+    return mf_dtype_is_half(src->out_info.dtype) && !link_keeps_storage(dst, link);
+}
+
+bool mf_pass_storage(mf_graph_ir* ir, mf_arena* arena, bool* changed, mf_compiler_diag* diag) {
+    *changed = false;
+    if (!ir) {
+        MF_REPORT(diag, NULL, "Storage Pass: IR is NULL");
+        return false;
+    }
+
+    size_t widen_count = 0;
+    for (size_t l = 0; l < ir->link_count; ++l) {
+        if (link_needs_widening(ir, &ir->links[l])) widen_count++;
+    }
+    if (widen_count == 0) return true;
+
+    // At most one new node and one new link per widened link
+    size_t first_new = ir->node_count;
+    mf_ir_node* nodes = MF_ARENA_PUSH(arena, mf_ir_node, ir->node_count + widen_count);
+    mf_ir_link* links = MF_ARENA_PUSH(arena, mf_ir_link, ir->link_count + widen_count);
+    u32* widen_src = MF_ARENA_PUSH(arena, u32, widen_count); // Source of each new Copy
+    if (!nodes || !links || !widen_src) {
+        MF_REPORT(diag, NULL, "Storage Pass: Out of memory");
+        return false;
+    }
+    memcpy(nodes, ir->nodes, sizeof(mf_ir_node) * ir->node_count);
+    memcpy(links, ir->links, sizeof(mf_ir_link) * ir->link_count);
+    ir->nodes = nodes;
+    ir->node_cap = ir->node_count + widen_count;
+    ir->links = links;
+    ir->link_cap = ir->link_count + widen_count;
+
+    size_t link_count = ir->link_count;
+    for (size_t l = 0; l < link_count; ++l) {
+        mf_ir_link* link = &ir->links[l];
+        if (!link_needs_widening(ir, link)) continue;
+
+        const mf_ir_node* src = &ir->nodes[link->src_node_idx];
+        const mf_ir_node* dst = &ir->nodes[link->dst_node_idx];
+        u32 domain = dst->domain_node_idx;
+        // Widen in the reader's task when the source lines up with its domain, else on its own
+        bool fused = (domain != UINT32_MAX) && shapes_equal(&src->out_info, &ir->nodes[domain].out_info);
+
+        // One widening Copy per source and domain
+        u32 widen_idx = UINT32_MAX;
+        for (size_t n = first_new; n < ir->node_count; ++n) {
+            const mf_ir_node* w = &ir->nodes[n];
+            if (widen_src[n - first_new] != link->src_node_idx) continue;
+            if (fused ? (w->domain_node_idx == domain) : (w->domain_node_idx == (u32)n)) { widen_idx = (u32)n; break; }
+        }
+
+        if (widen_idx == UINT32_MAX) {
+            widen_idx = (u32)ir->node_count++;
+            mf_ir_node* w = &ir->nodes[widen_idx];
+            memset(w, 0, sizeof(mf_ir_node));
+            w->type = MF_NODE_COPY;
+            w->id = "unknown";
+            w->loc = dst->loc;
+            w->const_info.dtype = MF_DTYPE_F32;
+            w->out_info = src->out_info;
+            w->out_info.dtype = MF_DTYPE_F32;
+            w->is_spatial = src->is_spatial;
+            w->domain_node_idx = fused ? domain : widen_idx;
+            widen_src[widen_idx - first_new] = link->src_node_idx;
+
+            mf_ir_link* in = &ir->links[ir->link_count];
+            in->src_node_idx = link->src_node_idx;
+            in->src_port = link->src_port;
+            in->src_port_name = link->src_port_name;
+            in->dst_node_idx = widen_idx;
+            in->dst_port = 0;
+            in->dst_port_name = "in";
+            ir->link_count++;
+            MF_LOG_DEBUG("Widening half register of '%s' for '%s'", src->id, dst->id);
+        }
+
+        link->src_node_idx = widen_idx;
+        link->src_port = 0;
+        link->src_port_name = "out";
+    }
+
+    *changed = true;
+    return true;
+}
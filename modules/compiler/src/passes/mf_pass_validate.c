@@ -72,6 +72,15 @@ bool mf_pass_validate(mf_graph_ir* ir, mf_ir_node** sorted_nodes, size_t count,
                     MF_REPORT_NODE(diag, node, "Shape Error: Output of '%s' must match Input 1 (%s vs %s)", node->id, s_out, s_in);
                     success = false;
                 }
+                // SortByKey: one value per key
+                if (meta->strategy == MF_STRATEGY_SORT && info1 && info2 &&
+                    mf_shape_calc_count(info1->shape, info1->ndim) != mf_shape_calc_count(info2->shape, info2->ndim)) {
+                    char s1[64], s2[64];
+                    mf_shape_format(info1, s1, sizeof(s1));
+                    mf_shape_format(info2, s2, sizeof(s2));
+                    MF_REPORT_NODE(diag, node, "Sort Error: Keys and values of '%s' differ in size (%s vs %s)", node->id, s1, s2);
+                    success = false;
+                }
                 break;
 
             case MF_SHAPE_MATMUL:
@@ -79,14 +88,49 @@ bool mf_pass_validate(mf_graph_ir* ir, mf_ir_node** sorted_nodes, size_t count,
                     if (info1->ndim < 2 || info2->ndim < 2) {
                         MF_REPORT_NODE(diag, node, "MatMul Error: Inputs must be at least 2D in '%s' (got %dD and %dD)", node->id, info1->ndim, info2->ndim);
                         success = false;
-                    } else if (info1->shape[1] != info2->shape[0]) {
+                    } else if (info1->shape[info1->ndim - 1] != info2->shape[info2->ndim - 2]) {
                         MF_REPORT_NODE(diag, node, "MatMul Error: Inner dimensions mismatch [%d] vs [%d] in '%s'", 
-                            info1->shape[1], info2->shape[0], node->id);
+                            info1->shape[info1->ndim - 1], info2->shape[info2->ndim - 2], node->id);
+                        success = false;
+                    } else if (info1->ndim > 2 && info2->ndim > 2 &&
+                               (info1->ndim != info2->ndim || memcmp(info1->shape, info2->shape, sizeof(int32_t) * (info1->ndim - 2)) != 0)) {
+                        char s1[64], s2[64];
+                        mf_shape_format(info1, s1, sizeof(s1));
+                        mf_shape_format(info2, s2, sizeof(s2));
+                        MF_REPORT_NODE(diag, node, "MatMul Error: Batch dimensions mismatch in '%s' (%s vs %s)", node->id, s1, s2);
                         success = false;
                     }
                 }
                 break;
 
+            case MF_SHAPE_SEGMENTS:
+                // One segment id per element
+                if (meta->arity == 3 && info1 && info2 &&
+                    mf_shape_calc_count(info1->shape, info1->ndim) != mf_shape_calc_count(info2->shape, info2->ndim)) {
+                    char s1[64], s2[64];
+                    mf_shape_format(info1, s1, sizeof(s1));
+                    mf_shape_format(info2, s2, sizeof(s2));
+                    MF_REPORT_NODE(diag, node, "Segment Error: Data and ids of '%s' differ in size (%s vs %s)", node->id, s1, s2);
+                    success = false;
+                }
+                break;
+
+            case MF_SHAPE_SCATTER:
+                // One index per value, and a target of the values' dtype
+                if (info1 && info2 &&
+                    mf_shape_calc_count(info1->shape, info1->ndim) != mf_shape_calc_count(info2->shape, info2->ndim)) {
+                    char s1[64], s2[64];
+                    mf_shape_format(info1, s1, sizeof(s1));
+                    mf_shape_format(info2, s2, sizeof(s2));
+                    MF_REPORT_NODE(diag, node, "Scatter Error: Values and indices of '%s' differ in size (%s vs %s)", node->id, s1, s2);
+                    success = false;
+                }
+                if (info1 && inputs[2] && inputs[2]->out_info.dtype != info1->dtype) {
+                    MF_REPORT_NODE(diag, node, "Scatter Error: Base and values of '%s' differ in dtype", node->id);
+                    success = false;
+                }
+                break;
+
             case MF_SHAPE_DOT:
                 if (info1 && info2) {
                     if (info1->shape[info1->ndim-1] != info2->shape[info2->ndim-1]) {
@@ -50,6 +50,7 @@ mf_engine*      mf_engine_create(const mf_engine_desc* desc);
 void            mf_engine_destroy(mf_engine* engine);
 void            mf_engine_reset(mf_engine* engine);
 mf_arena*       mf_engine_get_arena(mf_engine* engine);
+const mf_backend* mf_engine_get_backend(mf_engine* engine);
 
 // --- Setup ---
 
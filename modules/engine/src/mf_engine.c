@@ -132,7 +132,9 @@ void mf_engine_reset(mf_engine* engine) {
     mf_arena_reset(&engine->arena);
     if (engine->heap_buffer) mf_heap_init(&engine->heap, engine->heap_buffer, engine->heap.size);
     engine->kernel_count = 0;
+    engine->graph = NULL;
     engine->resource_count = 0;
+    engine->shapes_dirty = false;
     mf_atomic_store(&engine->error_code, 0);
 }
 
@@ -140,17 +142,19 @@ mf_arena* mf_engine_get_arena(mf_engine* engine) {
     return engine ? &engine->arena : NULL;
 }
 
+const mf_backend* mf_engine_get_backend(mf_engine* engine) {
+    return engine ? &engine->backend : NULL;
+}
+
 void mf_engine_dispatch(mf_engine* engine) {
     if (!engine || mf_atomic_load(&engine->error_code) != 0) return;
 
     u8 front = engine->front_idx;
     u8 back  = engine->back_idx;
 
+    // 1. Resource Binding (buffers do not change while the frame runs)
     for (u32 k_idx = 0; k_idx < engine->kernel_count; ++k_idx) {
         mf_kernel_inst* ker = &engine->kernels[k_idx];
-        if (mf_atomic_load(&engine->error_code) != 0) break;
-        
-        // 1. Resource Binding
         for (u32 b = 0; b < ker->binding_count; ++b) {
             mf_kernel_binding* bind = &ker->bindings[b];
             mf_resource_inst* res = &engine->resources[bind->global_res];
@@ -159,11 +163,18 @@ void mf_engine_dispatch(mf_engine* engine) {
             t->buffer = (bind->flags & MF_SYMBOL_FLAG_OUTPUT) ? res->buffers[back] : res->buffers[front];
             t->byte_offset = 0;
         }
-        
-        // 3. Execution
-        for (u32 f = 0; f < ker->frequency; ++f) {
-            if (engine->backend.dispatch) {
-                ker->state.global_error_ptr = &engine->error_code;
+        ker->state.global_error_ptr = &engine->error_code;
+        if (engine->shapes_dirty && engine->backend.resize) engine->backend.resize(engine->backend.state, ker->program, &ker->state);
+    }
+    engine->shapes_dirty = false;
+
+    // 2. Execution
+    if (engine->backend.dispatch_graph && engine->graph) {
+        engine->backend.dispatch_graph(engine->backend.state, engine->graph, engine->kernel_count);
+    } else if (engine->backend.dispatch) {
+        for (u32 k_idx = 0; k_idx < engine->kernel_count; ++k_idx) {
+            mf_kernel_inst* ker = &engine->kernels[k_idx];
+            for (u32 f = 0; f < ker->frequency; ++f) {
                 for (u32 t = 0; t < ker->program->meta.task_count; ++t) {
                     mf_task* task = &ker->program->tasks[t];
                     const mf_tensor* task_domain = &ker->state.registers[task->domain_reg];
@@ -219,6 +230,7 @@ bool mf_engine_resize_resource(mf_engine* engine, const char* name, const int32_
         res->size_bytes = new_bytes;
     }
     res->desc.info = new_info;
+    engine->shapes_dirty = true;
     return true;
 }
 
@@ -62,10 +62,12 @@ struct mf_engine {
     u32               resource_count;
     mf_kernel_inst*   kernels;
     u32               kernel_count;
+    mf_backend_kernel* graph; // [kernel_count] Kernel dependencies, built at bind time
 
     // Buffer Synchronization
     u8 front_idx;             // Index for Read
     u8 back_idx;              // Index for Write
+    bool shapes_dirty;        // Resources bound or resized since the last dispatch
     
     // Status
     mf_atomic_i32 error_code; // Global Kill Switch (Atomic)
@@ -112,6 +112,69 @@ static void apply_initial_data(mf_engine* engine) {
     }
 }
 
+/**
+ * Inputs read the front buffer and outputs write the back one, so across kernels only
+ * two writers of a resource or any pairing on a transient (single-buffered) one collide.
+ */
+static bool kernels_conflict(const mf_engine* engine, const mf_kernel_inst* a, const mf_kernel_inst* b) {
+    for (u32 i = 0; i < a->binding_count; ++i) {
+        const mf_kernel_binding* ba = &a->bindings[i];
+        bool transient = (engine->resources[ba->global_res].flags & MF_RESOURCE_FLAG_TRANSIENT) != 0;
+        bool a_writes = (ba->flags & MF_SYMBOL_FLAG_OUTPUT) != 0;
+        for (u32 j = 0; j < b->binding_count; ++j) {
+            const mf_kernel_binding* bb = &b->bindings[j];
+            if (bb->global_res != ba->global_res) continue;
+            bool b_writes = (bb->flags & MF_SYMBOL_FLAG_OUTPUT) != 0;
+            if (a_writes ? (b_writes || transient) : (b_writes && transient)) return true;
+        }
+    }
+    return false;
+}
+
+static void build_kernel_graph(mf_engine* engine) {
+    u32 n = engine->kernel_count;
+    engine->graph = NULL;
+    if (n == 0) return;
+
+    // Ancestor bitsets let each kernel skip edges already implied by a nearer dependency
+    u32 words = (n + 63) / 64;
+    u64* ancestors = MF_ARENA_PUSH(&engine->arena, u64, (size_t)n * words);
+    u32* deps = MF_ARENA_PUSH(&engine->arena, u32, (size_t)n * n);
+    u32* dep_counts = MF_ARENA_PUSH(&engine->arena, u32, n);
+    mf_backend_kernel* graph = MF_ARENA_PUSH(&engine->arena, mf_backend_kernel, n);
+    if (!ancestors || !deps || !dep_counts || !graph) return;
+    memset(ancestors, 0, sizeof(u64) * n * words);
+
+    for (u32 j = 0; j < n; ++j) {
+        u64* anc_j = ancestors + (size_t)j * words;
+        dep_counts[j] = 0;
+        for (u32 i = j; i-- > 0;) {
+            if (anc_j[i / 64] & (1ull << (i % 64))) continue;
+            if (!kernels_conflict(engine, &engine->kernels[i], &engine->kernels[j])) continue;
+            deps[(size_t)j * n + dep_counts[j]++] = i;
+            const u64* anc_i = ancestors + (size_t)i * words;
+            for (u32 w = 0; w < words; ++w) anc_j[w] |= anc_i[w];
+            anc_j[i / 64] |= 1ull << (i % 64);
+        }
+    }
+
+    u32* cursor = MF_ARENA_PUSH(&engine->arena, u32, (size_t)n * n);
+    if (!cursor) return;
+    for (u32 i = 0; i < n; ++i) {
+        graph[i].program = engine->kernels[i].program;
+        graph[i].state = &engine->kernels[i].state;
+        graph[i].repeat = engine->kernels[i].frequency;
+        graph[i].dep_count = dep_counts[i];
+        graph[i].successors = cursor;
+        for (u32 j = i + 1; j < n; ++j) {
+            for (u32 d = 0; d < dep_counts[j]; ++d) if (deps[(size_t)j * n + d] == i) *cursor++ = j;
+        }
+        graph[i].successor_count = (u32)(cursor - graph[i].successors);
+    }
+
+    engine->graph = graph;
+}
+
 static void mf_engine_finalize_setup(mf_engine* engine) {
     analyze_transience(engine);
     allocate_resources(engine);
@@ -120,6 +183,8 @@ static void mf_engine_finalize_setup(mf_engine* engine) {
     for (u32 k = 0; k < engine->kernel_count; ++k) {
         mf_state_reset(&engine->kernels[k].state, engine->kernels[k].program, &engine->arena, &engine->backend);
     }
+    build_kernel_graph(engine);
+    engine->shapes_dirty = true;
 }
 
 // --- Public API ---
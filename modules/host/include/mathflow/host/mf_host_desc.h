@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include <mathflow/engine/mf_pipeline.h>
+#include <mathflow/isa/mf_program.h>
 
 typedef enum {
     MF_ASSET_IMAGE,
@@ -33,6 +34,10 @@ typedef struct mf_host_desc {
     // Optional: Number of worker threads (0 = Auto)
     int num_threads;
 
+    // Optional: Execution profile forced on every program (DEFAULT = each program's own).
+    // Set before mf_app_load_config to override the app's setting (e.g. SAFE for debug runs).
+    mf_exec_profile exec_profile;
+
     // Logging Interval (in seconds) for TRACE logs and screenshots. 0 = Disable periodic logging.
     float log_interval;
     
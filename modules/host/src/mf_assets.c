@@ -3,6 +3,7 @@
 #include <mathflow/base/mf_log.h>
 #include <mathflow/base/mf_utils.h>
 #include <mathflow/base/mf_shape.h>
+#include <mathflow/base/mf_half.h>
 #include "mf_host_internal.h"
 #include "mf_loader.h"
 #include <string.h>
@@ -45,6 +46,7 @@ bool mf_loader_load_image(mf_engine* engine, const char* name, const char* path)
     size_t p = (size_t)w * h * d;
     if (t->info.dtype == MF_DTYPE_F32) { f32* dst = (f32*)t->buffer->data; for (size_t i = 0; i < p; ++i) dst[i] = (f32)data[i] / 255.0f; }
     else if (t->info.dtype == MF_DTYPE_U8) memcpy(t->buffer->data, data, p);
+    else if (mf_dtype_is_half(t->info.dtype)) { for (size_t i = 0; i < p; ++i) mf_dtype_store_f32(t->buffer->data, t->info.dtype, i, (f32)data[i] / 255.0f); }
     stbi_image_free(data); mf_engine_sync_resource(engine, name); return true;
 }
 
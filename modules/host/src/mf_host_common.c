@@ -75,7 +75,7 @@ int mf_host_app_init(mf_host_app* app, const mf_host_desc* desc) {
     mf_engine_desc engine_desc = {0};
     engine_desc.arena_size = 64 * 1024 * 1024; 
     engine_desc.heap_size = 1024 * 1024 * 1024; 
-    mf_loader_init_backend(&engine_desc.backend, desc->num_threads);
+    mf_loader_init_backend(&engine_desc.backend, desc->num_threads, desc->exec_profile);
 
     app->engine = mf_engine_create(&engine_desc);
     if (!app->engine) return -2;
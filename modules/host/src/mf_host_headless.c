@@ -1,5 +1,6 @@
 #include <mathflow/host/mf_host_headless.h>
 #include <mathflow/engine/mf_engine.h>
+#include <mathflow/backend_cpu/mf_backend_cpu.h>
 #include <mathflow/isa/mf_tensor.h>
 #include <mathflow/base/mf_log.h>
 #include "mf_host_internal.h"
@@ -12,6 +13,13 @@ static void debug_print_resource_callback(const char* name, mf_tensor* t, void*
     mf_tensor_print(name, t);
 }
 
+static void trace_job_stats_callback(const mf_backend_cpu_task_stats* stats, void* user_data) {
+    (void)user_data;
+    MF_LOG_TRACE("Jobs: task %u: %zu elements -> %u x %u (%u B/elem, strip %u, scratch %zu/%zu B)%s", stats->task_idx, stats->total_elements,
+                 stats->job_count, stats->job_size, stats->footprint, stats->strip_size, stats->scratch_peak, stats->scratch_hint,
+                 stats->tuned ? "" : " [tuning]");
+}
+
 int mf_host_run_headless(const mf_host_desc* desc, int frames) {
     if (!desc) return 1;
 
@@ -39,6 +47,7 @@ int mf_host_run_headless(const mf_host_desc* desc, int frames) {
     
     MF_LOG_INFO("--- Final State ---\n");
     mf_engine_iterate_resources(app.engine, debug_print_resource_callback, NULL);
+    mf_backend_cpu_get_stats(mf_engine_get_backend(app.engine), trace_job_stats_callback, NULL);
 
     mf_host_app_cleanup(&app);
     return 0;
@@ -2,6 +2,7 @@
 #include <mathflow/engine/mf_engine.h>
 #include <mathflow/base/mf_platform.h>
 #include <mathflow/base/mf_log.h>
+#include <mathflow/base/mf_half.h>
 #include "mf_host_internal.h"
 #include "mf_loader.h"
 
@@ -18,12 +19,22 @@ static void convert_to_pixels(mf_tensor* tensor, void* pixels, int pitch, int te
     void* data_ptr = mf_tensor_data(tensor);
     if (!tensor || !data_ptr) return;
     
-    f32* src = (f32*)data_ptr;
     u8* dst = (u8*)pixels;
     
     int total_pixels = tex_w * tex_h;
     int channels = tensor->info.ndim >= 3 ? tensor->info.shape[tensor->info.ndim - 1] : 1;
 
+    // Half-precision images are widened once per frame
+    f32* src = (f32*)data_ptr;
+    f32* widened = NULL;
+    if (mf_dtype_is_half(tensor->info.dtype)) {
+        size_t count = (size_t)total_pixels * (size_t)(channels >= 4 ? 4 : channels);
+        widened = malloc(count * sizeof(f32));
+        if (!widened) return;
+        for (size_t i = 0; i < count; ++i) widened[i] = mf_dtype_load_f32(data_ptr, tensor->info.dtype, i);
+        src = widened;
+    }
+
     for (int i = 0; i < total_pixels; ++i) {
         float r, g, b, a;
         if (channels >= 4) {
@@ -52,6 +63,7 @@ static void convert_to_pixels(mf_tensor* tensor, void* pixels, int pitch, int te
         dst[i*4 + 2] = (u8)(b * 255.0f);
         dst[i*4 + 3] = (u8)(a * 255.0f);
     }
+    free(widened);
 }
 
 int mf_host_run(const mf_host_desc* desc) {
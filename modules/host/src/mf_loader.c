@@ -16,9 +16,10 @@
 static char g_current_cartridge_path[512] = {0};
 static mf_cartridge_header g_current_cart = {0};
 
-void mf_loader_init_backend(mf_backend* backend, int num_threads) {
+void mf_loader_init_backend(mf_backend* backend, int num_threads, mf_exec_profile profile) {
     if (!backend) return;
-    mf_backend_cpu_init(backend, num_threads);
+    mf_backend_cpu_desc desc = { .num_threads = num_threads, .schedule = MF_CPU_SCHEDULE_AUTO, .profile = profile };
+    mf_backend_cpu_init_desc(backend, &desc);
 }
 
 static mf_program* _load_program_from_mem(const u8* data, size_t len, mf_arena* arena) {
@@ -57,6 +58,13 @@ static mf_program* _load_program_from_mem(const u8* data, size_t len, mf_arena*
         offset += sizeof(mf_bin_task_binding) * head->binding_count;
     } else prog->bindings = NULL;
 
+    // 4.5 Task Dependencies
+    if (head->task_dep_count > 0) {
+        prog->task_deps = MF_ARENA_PUSH(arena, uint32_t, head->task_dep_count);
+        memcpy(prog->task_deps, data + offset, sizeof(uint32_t) * head->task_dep_count);
+        offset += sizeof(uint32_t) * head->task_dep_count;
+    } else prog->task_deps = NULL;
+
     // 5. Tensor Descriptors (Metadata block)
     mf_bin_tensor_desc* descs = (mf_bin_tensor_desc*)(data + offset);
     offset += sizeof(mf_bin_tensor_desc) * head->tensor_count;
@@ -151,6 +159,7 @@ int mf_app_load_config(const char* path, mf_host_desc* out_desc) {
         out_desc->vsync = g_current_cart.vsync;
         out_desc->fullscreen = g_current_cart.fullscreen;
         out_desc->num_threads = (int)g_current_cart.num_threads;
+        if (out_desc->exec_profile == MF_EXEC_PROFILE_DEFAULT) out_desc->exec_profile = (mf_exec_profile)g_current_cart.exec_profile;
         out_desc->has_pipeline = true;
         
         u32 prog_count = 0;
@@ -186,6 +195,7 @@ int mf_app_load_config(const char* path, mf_host_desc* out_desc) {
         out_desc->vsync = manifest.app_ir.vsync;
         out_desc->fullscreen = manifest.app_ir.fullscreen;
         out_desc->num_threads = manifest.app_ir.num_threads;
+        if (out_desc->exec_profile == MF_EXEC_PROFILE_DEFAULT) out_desc->exec_profile = (mf_exec_profile)manifest.app_ir.exec_profile;
         out_desc->has_pipeline = true;
         out_desc->pipeline.kernel_count = manifest.kernel_count;
         out_desc->pipeline.kernels = calloc(manifest.kernel_count, sizeof(mf_pipeline_kernel));
@@ -17,7 +17,7 @@
  */
 
 // --- Backend Setup ---
-void mf_loader_init_backend(mf_backend* backend, int num_threads);
+void mf_loader_init_backend(mf_backend* backend, int num_threads, mf_exec_profile profile);
 
 // --- Manifest Parsing ---
 int mf_app_load_config(const char* mfapp_path, mf_host_desc* out_desc);
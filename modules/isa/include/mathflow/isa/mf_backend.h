@@ -29,9 +29,41 @@ typedef void (*mf_backend_dispatch_func)(
     uint32_t inst_count
 );
 
+/**
+ * @brief One kernel of a pipeline graph (see mf_backend_dispatch_graph_func).
+ */
+typedef struct mf_backend_kernel {
+    const struct mf_program* program;
+    mf_state* state;
+    uint32_t repeat;              // Runs per dispatch (kernel frequency)
+    uint32_t dep_count;           // Earlier kernels that must finish first
+    const uint32_t* successors;   // Later kernels waiting on this one
+    uint32_t successor_count;
+} mf_backend_kernel;
+
+/**
+ * @brief Runs a pipeline of kernels (optional).
+ * Kernels wait for their dependencies and tasks for the program's task graph, so
+ * independent kernels and tasks may run concurrently. Kernel dependencies always
+ * point to earlier entries, so array order is a valid serial order.
+ * When absent, the runtime dispatches tasks one by one in order.
+ */
+typedef void (*mf_backend_dispatch_graph_func)(
+    void* backend_state,
+    const mf_backend_kernel* kernels,
+    uint32_t kernel_count
+);
+
 // Bake function to prepare a program for execution (pre-calculates plans, etc.)
 typedef void* (*mf_backend_bake_func)(void* backend_state, const struct mf_program* program);
 
+/**
+ * @brief Resources of a baked program changed shape (optional).
+ * Called with the new resources bound, before the next dispatch, so the backend can
+ * re-plan and size its scratch outside the frame.
+ */
+typedef void (*mf_backend_resize_func)(void* backend_state, const struct mf_program* program, mf_state* state);
+
 // Cleanup function for baked program data
 typedef void (*mf_backend_free_baked_func)(void* backend_state, void* baked_data);
 
@@ -46,7 +78,9 @@ typedef struct {
     
     mf_backend_bake_func bake;
     mf_backend_free_baked_func free_baked;
+    mf_backend_resize_func resize;
     mf_backend_dispatch_func dispatch;
+    mf_backend_dispatch_graph_func dispatch_graph;
     mf_backend_shutdown_func shutdown;
 } mf_backend;
 
@@ -17,7 +17,8 @@ typedef enum {
     MF_ERROR_SHAPE_MISMATCH = 2, 
     MF_ERROR_INVALID_OP = 3,
     MF_ERROR_RUNTIME = 4,
-    MF_ERROR_OUT_OF_BOUNDS = 5
+    MF_ERROR_OUT_OF_BOUNDS = 5,
+    MF_ERROR_NON_FINITE = 6     // NaN/Inf result (FAST_CHECKED profile)
 } mf_exec_error;
 
 static inline const char* mf_exec_error_to_str(mf_exec_error err) {
@@ -28,19 +29,58 @@ static inline const char* mf_exec_error_to_str(mf_exec_error err) {
         case MF_ERROR_INVALID_OP:     return "INVALID_OPCODE";
         case MF_ERROR_RUNTIME:        return "RUNTIME_GENERIC_ERROR";
         case MF_ERROR_OUT_OF_BOUNDS:  return "OUT_OF_BOUNDS";
+        case MF_ERROR_NON_FINITE:     return "NON_FINITE";
         default:                      return "UNKNOWN_ERROR";
     }
 }
 
+/**
+ * @brief Partial result of a reduction (MF_STRATEGY_REDUCTION).
+ * A reduction's dest register points at the accumulator of the running thread (an array
+ * of one per segment for segmented reductions): jobs fold their elements into it, the
+ * owner merges the partials and stores the result (mf_ops_reduce_combine,
+ * mf_ops_reduce_store). F32 sources accumulate in f64, I32 in i64.
+ */
+typedef struct {
+    union { f64 f; i64 i; } value;
+    i64 count;                     // Elements folded (Sum, Mean, Min, Max, Segment*), or the flat index of value (ArgMin, ArgMax; -1 = none)
+} mf_reduce_acc;
+
+#define MF_SORT_RADIX  256                 // 8-bit digits
+#define MF_SORT_PASSES 4                   // 32-bit keys
+#define MF_SORT_ROUNDS (MF_SORT_PASSES + 1)
+
+/**
+ * @brief Shared state of a parallel LSD radix sort (MF_STRATEGY_SORT), owned by the backend.
+ * A sort task runs MF_SORT_ROUNDS rounds of jobs over the same tiles. Round 0 turns the
+ * keys into ordered bits and counts the digits of every pass. Round 1 + p moves the
+ * elements by digit p: a tile finds where its digits go by look-back over per-digit
+ * status words of the tiles before it, as a scan does. Jobs are numbered in the order
+ * they start, so a job only ever waits on jobs that are already running.
+ */
+typedef struct {
+    u32 tile_count;
+    mf_atomic_i32* histogram;      // [MF_SORT_PASSES * MF_SORT_RADIX] Digit counts of all keys
+    mf_atomic_i32* rounds_done;    // [MF_SORT_ROUNDS] Tiles finished per round
+    mf_atomic_i64* status;         // [MF_SORT_PASSES * tile_count * MF_SORT_RADIX] Look-back words
+    u32* keys[2];                  // Ping-pong ordered key bits
+    u32* payload[2];               // Ping-pong element indices (ArgSort) or value bits (SortByKey), NULL for Sort
+} mf_sort_state;
+
 /**
  * @brief Light-weight execution context (Ephemeral).
  * Created on the stack or per-thread. Points to data in mf_state or tiled buffers.
+ *
+ * Registers are seen through a window: the instructions a kernel receives index
+ * these arrays, which the owner sizes to what the running task binds (the CPU
+ * backend renumbers each task's registers densely at bake).
  */
 struct mf_exec_ctx {
-    // Flat Execution Registry (Zero-Overhead Access)
-    void* reg_ptrs[MF_MAX_REGISTERS];           // Base pointers for registers
-    int32_t reg_strides[MF_MAX_REGISTERS];      // Pre-calculated byte strides for current task
-    mf_type_info reg_info[MF_MAX_REGISTERS];    // Metadata for registers
+    // Register Window (Zero-Overhead Access)
+    void** reg_ptrs;               // [reg_count] Base pointers for registers
+    int32_t* reg_strides;          // [reg_count] Pre-calculated byte strides for current task
+    mf_type_info* reg_info;        // [reg_count] Metadata for registers (cold, read-only for kernels)
+    u32 reg_count;
     
     // Optional allocator for temporary allocations during execution
     mf_allocator* allocator; 
@@ -60,10 +100,13 @@ struct mf_exec_ctx {
     mf_exec_error error;
     mf_atomic_i32* global_error_ptr;
     
-    // Sync Support (for multi-pass ops like CumSum)
-    int sync_pass;
-    void* sync_data;
-    u32 job_idx;
+    // Scan Support (single-pass prefix ops like CumSum)
+    mf_atomic_i64* scan_tiles;     // [job count] Look-back status words (NULL = scan the batch alone)
+    u32 job_idx;                   // Tile index; scan jobs are numbered in the order they start
+
+    // Sort Support
+    mf_sort_state* sort;           // NULL unless a sort task
+    u32 job_round;                 // Round of a sort job (tiles repeat every round)
 
     // User Data
     void* user_data;
@@ -81,6 +124,16 @@ static inline void mf_exec_ctx_init(mf_exec_ctx* ctx, mf_allocator* allocator) {
     ctx->global_error_ptr = NULL;
 }
 
+/**
+ * @brief Points the context at caller-owned register arrays of `count` entries.
+ */
+static inline void mf_exec_ctx_set_window(mf_exec_ctx* ctx, void** ptrs, int32_t* strides, mf_type_info* info, u32 count) {
+    ctx->reg_ptrs = ptrs;
+    ctx->reg_strides = strides;
+    ctx->reg_info = info;
+    ctx->reg_count = count;
+}
+
 static inline bool mf_exec_ctx_resize_tensor(mf_exec_ctx* ctx, mf_tensor* tensor, const int32_t* new_shape, uint8_t new_ndim) {
     if (!tensor) return false;
     
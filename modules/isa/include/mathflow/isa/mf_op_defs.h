@@ -18,8 +18,10 @@ typedef enum {
 #define MF_TYPE_MASK_F32 (1 << MF_DTYPE_F32)
 #define MF_TYPE_MASK_I32 (1 << MF_DTYPE_I32)
 #define MF_TYPE_MASK_U8  (1 << MF_DTYPE_U8)
-#define MF_TYPE_MASK_NUMERIC (MF_TYPE_MASK_F32 | MF_TYPE_MASK_I32)
+#define MF_TYPE_MASK_HALF ((1 << MF_DTYPE_F16) | (1 << MF_DTYPE_BF16)) // Storage only, read as f32
+#define MF_TYPE_MASK_NUMERIC (MF_TYPE_MASK_F32 | MF_TYPE_MASK_I32 | MF_TYPE_MASK_HALF)
 #define MF_TYPE_MASK_ALL     (MF_TYPE_MASK_NUMERIC | MF_TYPE_MASK_U8)
+#define MF_TYPE_MASK_WORD    (MF_TYPE_MASK_F32 | MF_TYPE_MASK_I32) // 32-bit elements (Scatter)
 #define MF_TYPE_MASK_LOGIC   (MF_TYPE_MASK_U8)
 
 typedef enum {
@@ -43,6 +45,9 @@ typedef enum {
     MF_SHAPE_RESHAPE,       // Shape follows constant value
     MF_SHAPE_SLICE,         // 1D slice
     MF_SHAPE_SCALAR,        // Output is a single value (ndim=0)
+    MF_SHAPE_REDUCE_AXIS,   // Input shape without the dim given by constant value (S2)
+    MF_SHAPE_SEGMENTS,      // 1D, length given by constant value (last port)
+    MF_SHAPE_SCATTER,       // Shape of the target written into (S3)
 } mf_shape_rule;
 
 typedef enum {
@@ -56,7 +61,9 @@ typedef enum {
 typedef enum {
     MF_STRATEGY_DEFAULT,         // Simple parallel execution
     MF_STRATEGY_REDUCTION,       // Partial result per thread -> Final merge
-    MF_STRATEGY_TWO_PASS_SYNC,   // Two passes with a barrier (e.g. CumSum)
+    MF_STRATEGY_SCAN,            // Single pass, jobs chain their prefixes by look-back (e.g. CumSum)
+    MF_STRATEGY_SCATTER,         // Random writes into a target: per-thread partials or atomics -> Final merge
+    MF_STRATEGY_SORT,            // Rounds of jobs over the same tiles, one per radix pass (mf_sort_state)
 } mf_dispatch_strategy;
 
 #include "mf_ops_db.inc"
@@ -29,6 +29,8 @@ typedef enum {
 typedef struct {
     const char* name;
     const char* ports[4]; // Names of input ports (src1, src2, src3, src4)
+    mf_op_category category;
+    mf_access_pattern access;
 } mf_runtime_op_metadata;
 
 /**
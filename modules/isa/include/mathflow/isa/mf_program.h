@@ -6,7 +6,7 @@
 #include "mf_tensor.h"
 
 #define MF_BINARY_MAGIC   0x4D464C57 // "MFLW"
-#define MF_BINARY_VERSION 20         // Phase 9: The Cartridge Model (Container Format)
+#define MF_BINARY_VERSION 23         // Dynamic-length registers
 
 #define MF_MAX_SYMBOL_NAME 64
 #define MF_MAX_TITLE_NAME 128
@@ -31,9 +31,21 @@ typedef enum {
 #define MF_TENSOR_FLAG_GENERATOR  (1 << 2)
 #define MF_TENSOR_FLAG_ALIAS      (1 << 3) // Bound to external resource (Input/Output)
 #define MF_TENSOR_FLAG_SPATIAL    (1 << 4) // Needs domain-sized buffer
+#define MF_TENSOR_FLAG_DYNAMIC    (1 << 5) // Length set at run time by the task writing it (Filter)
 
 // Binding Flags
 #define MF_BINDING_FLAG_REDUCTION (1 << 0)
+#define MF_BINDING_FLAG_WRITE     (1 << 1) // Register is written by the task
+#define MF_BINDING_FLAG_SCATTER   (1 << 2) // Target of a scatter: jobs write anywhere in it
+
+// Execution Profiles (how kernels treat NaN/Inf results)
+typedef enum {
+    MF_EXEC_PROFILE_DEFAULT = 0,      // Not set: the next level decides (SAFE if none does)
+    MF_EXEC_PROFILE_SAFE,             // Every kernel stores non-finite results as 0
+    MF_EXEC_PROFILE_FAST,             // Results are stored as computed
+    MF_EXEC_PROFILE_FAST_CHECKED,     // FAST, then each job's written registers are scanned: a non-finite value stops the run
+    MF_EXEC_PROFILE_COUNT
+} mf_exec_profile;
 
 // --- Cartridge Container (Level 0) ---
 
@@ -57,7 +69,7 @@ typedef struct {
     u8 vsync;              // 1 = Enabled
     u8 fullscreen;         // 1 = Enabled
     u8 resizable;          // 1 = Enabled
-    u8 reserved_flags[1];
+    u8 exec_profile;       // mf_exec_profile for every program (0 = each program's own)
 
     u32 section_count;
     mf_section_header sections[MF_MAX_SECTIONS];
@@ -97,6 +109,9 @@ typedef struct {
     
     uint32_t binding_offset; // Offset into global binding table
     uint32_t binding_count;  // Number of registers used in this task
+
+    uint32_t dep_offset;     // Offset into the task dependency table
+    uint32_t dep_count;      // Number of earlier tasks that must finish before this one
 } mf_task;
 
 // Metadata for a single tensor in the binary file
@@ -122,10 +137,11 @@ typedef struct {
     u32 task_count;        // Number of execution tasks
     u32 binding_count;     // Total number of register bindings
     
-    u32 reduction_scratch_size; // Elements needed for reductions
-    u32 sync_scratch_size;      // Elements needed for sync operations
+    u32 reduction_scratch_size; // Reduction accumulators per thread (one per element of a reduction register)
+    u32 task_dep_count;         // Total number of task dependency edges
+    u32 exec_profile;           // mf_exec_profile (0 = engine default)
     
-    u32 reserved[8];       
+    u32 reserved[7];       
 } mf_bin_header;
 
 // In-memory representation of a single program
@@ -145,6 +161,7 @@ typedef struct mf_program {
     mf_bin_symbol* symbols;
     mf_task* tasks;
     mf_bin_task_binding* bindings;
+    uint32_t* task_deps;   // Task indices, referenced by mf_task::dep_offset/dep_count
 } mf_program;
 
 #endif // MF_PROGRAM_H
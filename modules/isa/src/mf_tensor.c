@@ -1,5 +1,6 @@
 #include <mathflow/isa/mf_tensor.h>
 #include <mathflow/base/mf_log.h>
+#include <mathflow/base/mf_half.h>
 #include <string.h>
 
 void mf_tensor_init(mf_tensor* tensor, mf_buffer* buf, const mf_type_info* info, size_t offset) {
@@ -219,6 +220,13 @@ void mf_tensor_print(const char* name, const mf_tensor* t) {
         }
         if (count > limit) printf("... (+%zu)", count - limit);
         printf("}\n");
+    } else if (mf_dtype_is_half(t->info.dtype)) {
+        printf("%s: {", t->info.dtype == MF_DTYPE_F16 ? "F16" : "BF16");
+        for(size_t i=0; i<limit; ++i) {
+            printf("%.2f%s", mf_dtype_load_f32(data_ptr, t->info.dtype, i), i < limit-1 ? ", " : "");
+        }
+        if (count > limit) printf("... (+%zu)", count - limit);
+        printf("}\n");
     } else if (t->info.dtype == MF_DTYPE_U8) {
         u8* p = (u8*)data_ptr;
         printf("Bool: {");
@@ -9,10 +9,73 @@
 
 /**
  * @brief Function signature for a MathFlow Operation Kernel (CPU Interpreter).
+ * Returns MF_ERROR_NONE, or the failure with ctx->error_idx set to the first bad element.
  */
-typedef void (*mf_op_func)(struct mf_exec_ctx* ctx, const struct mf_instruction* inst);
+typedef mf_exec_error (*mf_op_func)(struct mf_exec_ctx* ctx, const struct mf_instruction* inst);
 
 // Registers all available operations to the table.
 void mf_ops_fill_table(mf_op_func* table);
 
+// Same as mf_ops_fill_table, but vectorized kernels are replaced by their scalar reference loops.
+// Used to validate and benchmark the SIMD paths.
+void mf_ops_fill_table_reference(mf_op_func* table);
+
+// Same as mf_ops_fill_table, but elementwise kernels store NaN/Inf results as computed
+// instead of as 0 (FAST execution profiles, see mf_exec_profile).
+void mf_ops_fill_table_fast(mf_op_func* table);
+
+/**
+ * @brief Resolves a kernel specialized for fixed operand strides.
+ * @param byte_strides Byte strides of {dest, src1, src2, src3} for the whole dispatch.
+ * @return Specialized kernel (e.g. op_ADD_vs for contiguous + broadcast), or NULL
+ *         if the opcode has no specializations for this layout.
+ */
+mf_op_func mf_ops_find_specialized(u16 opcode, const i32* byte_strides);
+
+// Unsanitized form of mf_ops_find_specialized (pairs with mf_ops_fill_table_fast).
+mf_op_func mf_ops_find_specialized_fast(u16 opcode, const i32* byte_strides);
+
+/**
+ * @brief Resolves a kernel for the operand dtypes of an instruction.
+ * @param dtypes Dtypes of {dest, src1, src2, src3}; entries past the op's arity are ignored.
+ * @return Kernel for that signature (e.g. op_ADD_i32, op_LESS_i32_f32), or NULL
+ *         if the opcode's default kernel applies (all f32) or has no such variant.
+ */
+mf_op_func mf_ops_find_typed(u16 opcode, const mf_dtype* dtypes);
+
+/**
+ * @brief Resolves the pairwise-summation kernel of a reduction.
+ * Slower than the default blocked lane accumulation, but the rounding error of a job
+ * grows with log2 of its size instead of with the block length.
+ * @return Kernel, or NULL if the opcode and source dtype have none (only f32 sums do).
+ */
+mf_op_func mf_ops_find_pairwise(u16 opcode, mf_dtype src_dtype);
+
+// Reduction accumulators (see mf_reduce_acc). src_dtype is the dtype of the reduced register.
+void mf_ops_reduce_init(u16 opcode, mf_dtype src_dtype, mf_reduce_acc* acc);
+void mf_ops_reduce_combine(u16 opcode, mf_dtype src_dtype, mf_reduce_acc* acc, const mf_reduce_acc* other);
+// Writes the final value of a merged accumulator as one element of dest_dtype.
+void mf_ops_reduce_store(u16 opcode, mf_dtype src_dtype, const mf_reduce_acc* acc, void* dest, mf_dtype dest_dtype);
+
+/**
+ * Scatter partials (MF_STRATEGY_SCATTER). A scatter's dest register points at a partial
+ * target of mf_ops_scatter_slot_size() bytes per element, zeroed before the jobs run.
+ * The owner folds the threads' partials together and stores the result over the base.
+ */
+size_t mf_ops_scatter_slot_size(u16 opcode, mf_dtype dtype);
+// Kernel writing into one partial shared by all threads (atomic adds or compare-and-swap), or NULL.
+mf_op_func mf_ops_find_atomic(u16 opcode);
+void mf_ops_scatter_fold(u16 opcode, mf_dtype dtype, void* acc, const void* partial, size_t count);
+// dest = base updated by the folded partial (sums added, written elements replaced).
+void mf_ops_scatter_store(u16 opcode, mf_dtype dtype, const void* acc, const void* base, void* dest, size_t count);
+
+/**
+ * @brief Vectorized scan for NaN/Inf values.
+ * @return Index of the first non-finite element, or count if all are finite.
+ */
+size_t mf_ops_find_nonfinite(const f32* data, size_t count);
+
+// Name of the vector instruction set the kernels were built for ("AVX2", "SSE2", "NEON", "Scalar").
+const char* mf_ops_simd_name(void);
+
 #endif // MF_OPS_CORE_H
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <mathflow/isa/mf_instruction.h>
 #include <mathflow/base/mf_math.h>
 #include "mf_ops_internal.h"
+#include "mf_simd.h"
 #include <math.h>
 #include <string.h>
 #include <mathflow/isa/mf_exec_ctx.h>
@@ -19,9 +20,14 @@
 // --- Macros: Optimized Kernel Definitions ---
 
 #define MF_SAFE_F32(x) (isfinite((float)(x)) ? (f32)(x) : 0.0f)
+#define MF_RAW_F32(x)  ((f32)(x))
 
-#define MF_KERNEL_AUTO(NAME, EXPR, ARITY) \
-void op_##NAME(mf_exec_ctx* ctx, const struct mf_instruction* inst) { \
+/**
+ * Elementwise loop over arbitrary strides. STORE is MF_SAFE_F32 or MF_RAW_F32
+ * (FAST execution profiles, see mf_ops_fill_table_fast).
+ */
+#define MF_KERNEL_AUTO_STORE(NAME, EXPR, ARITY, STORE) \
+mf_exec_error op_##NAME(mf_exec_ctx* ctx, const struct mf_instruction* inst) { \
     const size_t sz = ctx->batch_size; \
     u8* d_ptr = (u8*)ctx->reg_ptrs[inst->dest_idx]; \
     u8* a_ptr = (u8*)ctx->reg_ptrs[inst->src1_idx]; \
@@ -35,12 +41,229 @@ void op_##NAME(mf_exec_ctx* ctx, const struct mf_instruction* inst) { \
         const f32 va = *(f32*)a_ptr; \
         const f32 vb = (ARITY >= 2) ? *(f32*)b_ptr : 0.0f; \
         const f32 vc = (ARITY >= 3) ? *(f32*)c_ptr : 0.0f; \
-        *(f32*)d_ptr = MF_SAFE_F32(EXPR); \
+        *(f32*)d_ptr = STORE(EXPR); \
         a_ptr += st1; \
         if (ARITY >= 2) b_ptr += st2; \
         if (ARITY >= 3) c_ptr += st3; \
         d_ptr += st0; \
     } \
+    return MF_ERROR_NONE; \
+}
+
+// Generates op_NAME (sanitized) and op_NAME_fast
+#define MF_KERNEL_AUTO(NAME, EXPR, ARITY) \
+    MF_KERNEL_AUTO_STORE(NAME, EXPR, ARITY, MF_SAFE_F32) \
+    MF_KERNEL_AUTO_STORE(NAME##_fast, EXPR, ARITY, MF_RAW_F32)
+
+// --- Macros: Dtype-Specialized Kernel Definitions ---
+
+#define MF_STORE_f32(x) MF_SAFE_F32(x)
+#define MF_STORE_i32(x) ((i32)(x))
+#define MF_STORE_u8(x)  ((u8)(x))
+
+// Position of a dtype in signature tables (F32, I32, U8), -1 for anything else
+static inline int mf_dtype_slot(mf_dtype dtype) {
+    return (dtype >= MF_DTYPE_F32 && dtype <= MF_DTYPE_U8) ? (int)dtype - 1 : -1;
+}
+
+/**
+ * Kernel over native element types: the operands are loaded as TA/TB/TC, and EXPR sees
+ * va as XA and vb/vc as XB. The result is stored as TD (NaN/Inf sanitized for f32).
+ * Contiguous operands, or a broadcast src2, take an indexed loop the compiler vectorizes.
+ */
+#define MF_KERNEL_TYPED(FN, EXPR, ARITY, TD, TA, TB, TC, XA, XB) \
+static mf_exec_error FN(mf_exec_ctx* ctx, const struct mf_instruction* inst) { \
+    const size_t sz = ctx->batch_size; \
+    u8* d_ptr = (u8*)ctx->reg_ptrs[inst->dest_idx]; \
+    const u8* a_ptr = (const u8*)ctx->reg_ptrs[inst->src1_idx]; \
+    const u8* b_ptr = (ARITY >= 2) ? (const u8*)ctx->reg_ptrs[inst->src2_idx] : a_ptr; \
+    const u8* c_ptr = (ARITY >= 3) ? (const u8*)ctx->reg_ptrs[inst->src3_idx] : a_ptr; \
+    const i32 st0 = MF_GET_STRIDE_D(inst); \
+    const i32 st1 = MF_GET_STRIDE_S1(inst); \
+    const i32 st2 = (ARITY >= 2) ? MF_GET_STRIDE_S2(inst) : 0; \
+    const i32 st3 = (ARITY >= 3) ? MF_GET_STRIDE_S3(inst) : 0; \
+    if (st0 == (i32)sizeof(TD) && st1 == (i32)sizeof(TA) && (ARITY < 3 || st3 == (i32)sizeof(TC))) { \
+        TD* d = (TD*)d_ptr; \
+        const TA* a = (const TA*)a_ptr; \
+        const TB* b = (const TB*)b_ptr; \
+        const TC* c = (const TC*)c_ptr; \
+        if (ARITY < 2 || st2 == (i32)sizeof(TB)) { \
+            for (size_t i = 0; i < sz; ++i) { \
+                const XA va = (XA)a[i]; \
+                const XB vb = (ARITY >= 2) ? (XB)b[i] : (XB)0; \
+                const XB vc = (ARITY >= 3) ? (XB)c[i] : (XB)0; \
+                (void)vb; (void)vc; \
+                d[i] = MF_STORE_##TD(EXPR); \
+            } \
+            return MF_ERROR_NONE; \
+        } \
+        if (st2 == 0) { \
+            const XB vb = (XB)b[0]; \
+            for (size_t i = 0; i < sz; ++i) { \
+                const XA va = (XA)a[i]; \
+                const XB vc = (ARITY >= 3) ? (XB)c[i] : (XB)0; \
+                (void)vb; (void)vc; \
+                d[i] = MF_STORE_##TD(EXPR); \
+            } \
+            return MF_ERROR_NONE; \
+        } \
+    } \
+    for (size_t i = 0; i < sz; ++i) { \
+        const XA va = (XA)*(const TA*)a_ptr; \
+        const XB vb = (ARITY >= 2) ? (XB)*(const TB*)b_ptr : (XB)0; \
+        const XB vc = (ARITY >= 3) ? (XB)*(const TC*)c_ptr : (XB)0; \
+        (void)vb; (void)vc; \
+        *(TD*)d_ptr = MF_STORE_##TD(EXPR); \
+        a_ptr += st1; b_ptr += st2; c_ptr += st3; d_ptr += st0; \
+    } \
+    return MF_ERROR_NONE; \
+}
+
+// --- Macros: Vectorized Kernel Definitions ---
+
+/**
+ * Operand access classes for vector kernels.
+ * VEC: contiguous (stride == sizeof(f32)), SCALAR: broadcast (stride == 0),
+ * STRIDED: fixed stride-N walk (e.g. one channel of an interleaved tensor).
+ */
+#define MF_OPND_VEC     0
+#define MF_OPND_SCALAR  1
+#define MF_OPND_STRIDED 2
+#define MF_OPND_COUNT   3
+
+static inline int mf_opnd_class(i32 stride) {
+    if (stride == (i32)sizeof(f32)) return MF_OPND_VEC;
+    if (stride == 0) return MF_OPND_SCALAR;
+    return MF_OPND_STRIDED;
+}
+
+MF_FORCE_INLINE mf_vf32 _mf_simd_load(const u8* p, size_t i, i32 st, int mode, mf_vf32 bcast) {
+    if (mode == MF_OPND_VEC) return mf_vf32_load((const f32*)p + i);
+    if (mode == MF_OPND_SCALAR) return bcast;
+    return mf_vf32_load_strided(p + i * (size_t)st, st);
+}
+
+/**
+ * Generates the scalar reference kernel (op_NAME_ref), one specialization per
+ * operand class combination (op_NAME_vv, op_NAME_vs, ...) and the op_NAME
+ * entry point that picks a specialization from the current strides.
+ * Each also comes unsanitized, with a _fast suffix (op_NAME_vs_fast, ...).
+ * VEXPR is the mf_vf32 form of EXPR and must produce identical results.
+ */
+#define MF_KERNEL_SIMD(NAME, EXPR, VEXPR, ARITY) \
+MF_KERNEL_AUTO(NAME##_ref, EXPR, ARITY) \
+MF_FORCE_INLINE void _mf_simd_##NAME(mf_exec_ctx* ctx, const struct mf_instruction* inst, const int ma, const int mb, const int mc, const bool safe) { \
+    const size_t sz = ctx->batch_size; \
+    f32* d = (f32*)ctx->reg_ptrs[inst->dest_idx]; \
+    const u8* a_ptr = (const u8*)ctx->reg_ptrs[inst->src1_idx]; \
+    const u8* b_ptr = (ARITY >= 2) ? (const u8*)ctx->reg_ptrs[inst->src2_idx] : a_ptr; \
+    const u8* c_ptr = (ARITY >= 3) ? (const u8*)ctx->reg_ptrs[inst->src3_idx] : a_ptr; \
+    const i32 st1 = MF_GET_STRIDE_S1(inst); \
+    const i32 st2 = (ARITY >= 2) ? MF_GET_STRIDE_S2(inst) : 0; \
+    const i32 st3 = (ARITY >= 3) ? MF_GET_STRIDE_S3(inst) : 0; \
+    const mf_vf32 ba = mf_vf32_set1(ma == MF_OPND_SCALAR ? *(const f32*)a_ptr : 0.0f); \
+    const mf_vf32 bb = mf_vf32_set1(mb == MF_OPND_SCALAR ? *(const f32*)b_ptr : 0.0f); \
+    const mf_vf32 bc = mf_vf32_set1(mc == MF_OPND_SCALAR ? *(const f32*)c_ptr : 0.0f); \
+    size_t i = 0; \
+    for (; i + MF_VF32_WIDTH <= sz; i += MF_VF32_WIDTH) { \
+        const mf_vf32 va = _mf_simd_load(a_ptr, i, st1, ma, ba); \
+        const mf_vf32 vb = (ARITY >= 2) ? _mf_simd_load(b_ptr, i, st2, mb, bb) : va; \
+        const mf_vf32 vc = (ARITY >= 3) ? _mf_simd_load(c_ptr, i, st3, mc, bc) : va; \
+        (void)vb; (void)vc; \
+        const mf_vf32 r = (VEXPR); \
+        mf_vf32_store(d + i, safe ? mf_vf32_sanitize(r) : r); \
+    } \
+    for (; i < sz; ++i) { \
+        const f32 va = *(const f32*)(a_ptr + i * (size_t)st1); \
+        const f32 vb = (ARITY >= 2) ? *(const f32*)(b_ptr + i * (size_t)st2) : 0.0f; \
+        const f32 vc = (ARITY >= 3) ? *(const f32*)(c_ptr + i * (size_t)st3) : 0.0f; \
+        (void)vb; (void)vc; \
+        d[i] = safe ? MF_SAFE_F32(EXPR) : MF_RAW_F32(EXPR); \
+    } \
+} \
+MF_SIMD_VARIANTS_##ARITY(NAME) \
+mf_exec_error op_##NAME(mf_exec_ctx* ctx, const struct mf_instruction* inst) { \
+    const i32 st[4] = { MF_GET_STRIDE_D(inst), MF_GET_STRIDE_S1(inst), \
+                        (ARITY >= 2) ? MF_GET_STRIDE_S2(inst) : 0, (ARITY >= 3) ? MF_GET_STRIDE_S3(inst) : 0 }; \
+    mf_op_func fn = _mf_simd_select(_mf_simd_tbl_##NAME, ARITY, st); \
+    return (fn ? fn : op_##NAME##_ref)(ctx, inst); \
+} \
+mf_exec_error op_##NAME##_fast(mf_exec_ctx* ctx, const struct mf_instruction* inst) { \
+    const i32 st[4] = { MF_GET_STRIDE_D(inst), MF_GET_STRIDE_S1(inst), \
+                        (ARITY >= 2) ? MF_GET_STRIDE_S2(inst) : 0, (ARITY >= 3) ? MF_GET_STRIDE_S3(inst) : 0 }; \
+    mf_op_func fn = _mf_simd_select(_mf_simd_tbl_fast_##NAME, ARITY, st); \
+    return (fn ? fn : op_##NAME##_ref_fast)(ctx, inst); \
+}
+
+/**
+ * Picks the specialization for the given byte strides (dest, src1, src2, src3).
+ * Returns NULL when the destination is not contiguous (reference loop only).
+ */
+static inline mf_op_func _mf_simd_select(const mf_op_func* tbl, int arity, const i32* strides) {
+    if (strides[0] != (i32)sizeof(f32)) return NULL;
+    int cls = mf_opnd_class(strides[1]);
+    if (arity >= 2) cls += MF_OPND_COUNT * mf_opnd_class(strides[2]);
+    if (arity >= 3) cls += MF_OPND_COUNT * MF_OPND_COUNT * mf_opnd_class(strides[3]);
+    return tbl[cls];
 }
 
+// Specialization tables are indexed by (class_a + 3 * class_b + 9 * class_c).
+// F is empty for the sanitized table and _fast for the unsanitized one.
+#define MF_SIMD_VARIANT(NAME, SFX, MA, MB, MC) \
+    static mf_exec_error op_##NAME##_##SFX(mf_exec_ctx* ctx, const struct mf_instruction* inst) { _mf_simd_##NAME(ctx, inst, MA, MB, MC, true); return MF_ERROR_NONE; } \
+    static mf_exec_error op_##NAME##_##SFX##_fast(mf_exec_ctx* ctx, const struct mf_instruction* inst) { _mf_simd_##NAME(ctx, inst, MA, MB, MC, false); return MF_ERROR_NONE; }
+
+#define MF_SIMD_TBL_1(NAME, T, F) \
+    static const mf_op_func T[3] = { op_##NAME##_v##F, op_##NAME##_s##F, op_##NAME##_n##F };
+
+#define MF_SIMD_VARIANTS_1(NAME) \
+    MF_SIMD_VARIANT(NAME, v, MF_OPND_VEC, 0, 0) \
+    MF_SIMD_VARIANT(NAME, s, MF_OPND_SCALAR, 0, 0) \
+    MF_SIMD_VARIANT(NAME, n, MF_OPND_STRIDED, 0, 0) \
+    MF_SIMD_TBL_1(NAME, _mf_simd_tbl_##NAME, ) \
+    MF_SIMD_TBL_1(NAME, _mf_simd_tbl_fast_##NAME, _fast)
+
+#define MF_SIMD_VARIANTS_2_B(NAME, MB, B) \
+    MF_SIMD_VARIANT(NAME, v##B, MF_OPND_VEC, MB, 0) \
+    MF_SIMD_VARIANT(NAME, s##B, MF_OPND_SCALAR, MB, 0) \
+    MF_SIMD_VARIANT(NAME, n##B, MF_OPND_STRIDED, MB, 0)
+
+#define MF_SIMD_TBL_2(NAME, T, F) \
+    static const mf_op_func T[9] = { \
+        op_##NAME##_vv##F, op_##NAME##_sv##F, op_##NAME##_nv##F, \
+        op_##NAME##_vs##F, op_##NAME##_ss##F, op_##NAME##_ns##F, \
+        op_##NAME##_vn##F, op_##NAME##_sn##F, op_##NAME##_nn##F };
+
+#define MF_SIMD_VARIANTS_2(NAME) \
+    MF_SIMD_VARIANTS_2_B(NAME, MF_OPND_VEC, v) \
+    MF_SIMD_VARIANTS_2_B(NAME, MF_OPND_SCALAR, s) \
+    MF_SIMD_VARIANTS_2_B(NAME, MF_OPND_STRIDED, n) \
+    MF_SIMD_TBL_2(NAME, _mf_simd_tbl_##NAME, ) \
+    MF_SIMD_TBL_2(NAME, _mf_simd_tbl_fast_##NAME, _fast)
+
+#define MF_SIMD_VARIANTS_3_C(NAME, MB, B, MC, C) \
+    MF_SIMD_VARIANT(NAME, v##B##C, MF_OPND_VEC, MB, MC) \
+    MF_SIMD_VARIANT(NAME, s##B##C, MF_OPND_SCALAR, MB, MC) \
+    MF_SIMD_VARIANT(NAME, n##B##C, MF_OPND_STRIDED, MB, MC)
+
+#define MF_SIMD_VARIANTS_3_B(NAME, MC, C) \
+    MF_SIMD_VARIANTS_3_C(NAME, MF_OPND_VEC, v, MC, C) \
+    MF_SIMD_VARIANTS_3_C(NAME, MF_OPND_SCALAR, s, MC, C) \
+    MF_SIMD_VARIANTS_3_C(NAME, MF_OPND_STRIDED, n, MC, C)
+
+#define MF_SIMD_TBL_ROW_3(NAME, B, C, F) op_##NAME##_v##B##C##F, op_##NAME##_s##B##C##F, op_##NAME##_n##B##C##F
+
+#define MF_SIMD_TBL_3(NAME, T, F) \
+    static const mf_op_func T[27] = { \
+        MF_SIMD_TBL_ROW_3(NAME, v, v, F), MF_SIMD_TBL_ROW_3(NAME, s, v, F), MF_SIMD_TBL_ROW_3(NAME, n, v, F), \
+        MF_SIMD_TBL_ROW_3(NAME, v, s, F), MF_SIMD_TBL_ROW_3(NAME, s, s, F), MF_SIMD_TBL_ROW_3(NAME, n, s, F), \
+        MF_SIMD_TBL_ROW_3(NAME, v, n, F), MF_SIMD_TBL_ROW_3(NAME, s, n, F), MF_SIMD_TBL_ROW_3(NAME, n, n, F) };
+
+#define MF_SIMD_VARIANTS_3(NAME) \
+    MF_SIMD_VARIANTS_3_B(NAME, MF_OPND_VEC, v) \
+    MF_SIMD_VARIANTS_3_B(NAME, MF_OPND_SCALAR, s) \
+    MF_SIMD_VARIANTS_3_B(NAME, MF_OPND_STRIDED, n) \
+    MF_SIMD_TBL_3(NAME, _mf_simd_tbl_##NAME, ) \
+    MF_SIMD_TBL_3(NAME, _mf_simd_tbl_fast_##NAME, _fast)
+
 #endif // MF_KERNEL_UTILS_H
\ No newline at end of file
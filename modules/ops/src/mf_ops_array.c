@@ -5,115 +5,715 @@
 #include <stdio.h>
 #include <math.h>
 #include <mathflow/base/mf_log.h>
+#include <mathflow/base/mf_shape.h>
 
-// --- Op: CumSum (Prefix Sum) ---
-void op_CUMSUM(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
-    size_t count = ctx->batch_size;
-    u8* src_ptr = (u8*)ctx->reg_ptrs[inst->src1_idx];
-    u8* dst_ptr = (u8*)ctx->reg_ptrs[inst->dest_idx];
-
-    i32 st0 = MF_GET_STRIDE_D(inst);
-    i32 st1 = MF_GET_STRIDE_S1(inst);
-
-    if (ctx->sync_data && ctx->sync_pass == 0) {
-        // Pass 0: Local Scan + Reporting chunk total
-        f32 sum = 0.0f;
-        for (size_t i = 0; i < count; ++i) {
-            sum += *(f32*)src_ptr;
-            *(f32*)dst_ptr = sum;
-            src_ptr += st1;
-            dst_ptr += st0;
-        }
-        ((f32*)ctx->sync_data)[ctx->job_idx] = sum;
-    } 
-    else if (ctx->sync_data && ctx->sync_pass == 1) {
-        // Pass 1: Adding global offset from previous chunks
-        f32 offset = ((f32*)ctx->sync_data)[ctx->job_idx];
-        if (offset == 0.0f) return; // Nothing to add
-
-        for (size_t i = 0; i < count; ++i) {
-            *(f32*)dst_ptr += offset;
-            dst_ptr += st0;
-        }
+// --- Scan (Decoupled Look-Back) ---
+
+/**
+ * Single-pass parallel prefix scan. Every job (tile) reduces its slice and publishes
+ * the aggregate in its status word, then walks back over the preceding tiles until it
+ * meets an inclusive prefix, publishes its own and scans its slice from there.
+ * Jobs are numbered in the order they start, so every tile waited on is already running.
+ * Status word: flag in the high 32 bits, value bits in the low 32.
+ */
+#define MF_SCAN_FLAG_AGGREGATE 1
+#define MF_SCAN_FLAG_PREFIX    2
+#define MF_SCAN_SPINS          64   // Busy polls of a tile before yielding the thread
+
+typedef enum { MF_SCAN_SUM, MF_SCAN_PROD, MF_SCAN_MIN, MF_SCAN_MAX } mf_scan_op;
+
+// acc = EXPR over the slice; writes the running value when dst is set
+#define MF_SCAN_LOOP(T, EXPR) \
+    for (size_t i = 0; i < n; ++i) { \
+        T x = *(const T*)src; acc = (EXPR); src += st_src; \
+        if (dst) { *(T*)dst = acc; dst += st_dst; } \
+    }
+
+static u32 scan_slice_f32(mf_scan_op op, const u8* src, i32 st_src, u8* dst, i32 st_dst, size_t n, u32 carry) {
+    f32 acc; memcpy(&acc, &carry, sizeof(acc));
+    switch (op) {
+        case MF_SCAN_SUM:  MF_SCAN_LOOP(f32, acc + x); break;
+        case MF_SCAN_PROD: MF_SCAN_LOOP(f32, acc * x); break;
+        case MF_SCAN_MIN:  MF_SCAN_LOOP(f32, x < acc ? x : acc); break;
+        case MF_SCAN_MAX:  MF_SCAN_LOOP(f32, x > acc ? x : acc); break;
+    }
+    memcpy(&carry, &acc, sizeof(acc));
+    return carry;
+}
+
+static u32 scan_slice_i32(mf_scan_op op, const u8* src, i32 st_src, u8* dst, i32 st_dst, size_t n, u32 carry) {
+    i32 acc = (i32)carry;
+    switch (op) {
+        case MF_SCAN_SUM:  MF_SCAN_LOOP(i32, (i32)((u32)acc + (u32)x)); break; // Wraps
+        case MF_SCAN_PROD: MF_SCAN_LOOP(i32, (i32)((u32)acc * (u32)x)); break;
+        case MF_SCAN_MIN:  MF_SCAN_LOOP(i32, x < acc ? x : acc); break;
+        case MF_SCAN_MAX:  MF_SCAN_LOOP(i32, x > acc ? x : acc); break;
+    }
+    return (u32)acc;
+}
+
+static u32 scan_identity(mf_scan_op op, mf_dtype dtype) {
+    f32 f = 0.0f; i32 v = 0;
+    switch (op) {
+        case MF_SCAN_SUM:  break;
+        case MF_SCAN_PROD: f = 1.0f; v = 1; break;
+        case MF_SCAN_MIN:  f = INFINITY; v = INT32_MAX; break;
+        case MF_SCAN_MAX:  f = -INFINITY; v = INT32_MIN; break;
     }
-    else {
-        // Fallback: Sequential (if no sync context)
-        f32 sum = 0.0f;
-        for (size_t i = 0; i < count; ++i) {
-            sum += *(f32*)src_ptr;
-            *(f32*)dst_ptr = sum;
-            src_ptr += st1;
-            dst_ptr += st0;
+    if (dtype == MF_DTYPE_I32) return (u32)v;
+    u32 bits; memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+typedef u32 (*mf_scan_slice_func)(mf_scan_op op, const u8* src, i32 st_src, u8* dst, i32 st_dst, size_t n, u32 carry);
+
+static inline u32 scan_combine(mf_scan_slice_func slice, mf_scan_op op, u32 earlier, u32 later) {
+    return slice(op, (const u8*)&later, 0, NULL, 0, 1, earlier);
+}
+
+static inline int64_t scan_status(u32 flag, u32 value) { return (int64_t)(((u64)flag << 32) | value); }
+
+// Kill switch: a stopped run gives up waiting on other jobs, its outputs are discarded anyway
+static inline bool scan_stopped(mf_exec_ctx* ctx) {
+    return ctx->global_error_ptr && mf_atomic_load(ctx->global_error_ptr) != 0;
+}
+
+// Combined value of tiles [0, tile), whose status words lie `stride` apart, walking back
+// until a tile holds an inclusive prefix
+static u32 scan_lookback(mf_exec_ctx* ctx, mf_atomic_i64* tiles, size_t stride, u32 tile, mf_scan_slice_func slice, mf_scan_op op, u32 identity) {
+    u32 prefix = identity;
+    while (tile-- > 0) {
+        mf_atomic_i64* word = &tiles[(size_t)tile * stride];
+        u64 status;
+        for (u32 spin = 0; (status = (u64)mf_atomic_load64(word)) >> 32 == 0; ++spin) {
+            if (spin < MF_SCAN_SPINS) mf_cpu_relax();
+            else if (scan_stopped(ctx)) return prefix;
+            else mf_thread_yield();
         }
+        prefix = scan_combine(slice, op, (u32)status, prefix);
+        if (status >> 32 == MF_SCAN_FLAG_PREFIX) break;
+    }
+    return prefix;
+}
+
+// Publishes this tile's aggregate and returns the combined value of all tiles before it
+static u32 scan_publish(mf_exec_ctx* ctx, mf_scan_slice_func slice, mf_scan_op op, u32 identity, u32 aggregate) {
+    mf_atomic_i64* own = &ctx->scan_tiles[ctx->job_idx];
+    u32 prefix = identity;
+    if (ctx->job_idx > 0) {
+        mf_atomic_store64(own, scan_status(MF_SCAN_FLAG_AGGREGATE, aggregate));
+        prefix = scan_lookback(ctx, ctx->scan_tiles, 1, ctx->job_idx, slice, op, identity);
     }
+    mf_atomic_store64(own, scan_status(MF_SCAN_FLAG_PREFIX, scan_combine(slice, op, prefix, aggregate)));
+    return prefix;
+}
+
+static mf_exec_error scan_run(mf_exec_ctx* ctx, const struct mf_instruction* inst, mf_scan_op op) {
+    mf_dtype dtype = ctx->reg_info[inst->dest_idx].dtype;
+    if (dtype != MF_DTYPE_F32 && dtype != MF_DTYPE_I32) {
+        if (_mf_should_log_error(ctx)) MF_LOG_ERROR("Scan: unsupported dtype %d", (int)dtype);
+        return MF_ERROR_INVALID_OP;
+    }
+    mf_scan_slice_func slice = (dtype == MF_DTYPE_I32) ? scan_slice_i32 : scan_slice_f32;
+    const u8* src = (const u8*)ctx->reg_ptrs[inst->src1_idx];
+    u8* dst = (u8*)ctx->reg_ptrs[inst->dest_idx];
+    i32 st_dst = MF_GET_STRIDE_D(inst);
+    i32 st_src = MF_GET_STRIDE_S1(inst);
+    u32 identity = scan_identity(op, dtype);
+    u32 prefix = identity;
+
+    if (ctx->scan_tiles) {
+        // Publish before the scan itself, so later tiles stop waiting as early as possible
+        u32 aggregate = slice(op, src, st_src, NULL, 0, ctx->batch_size, identity);
+        prefix = scan_publish(ctx, slice, op, identity, aggregate);
+    }
+    slice(op, src, st_src, dst, st_dst, ctx->batch_size, prefix);
+    return MF_ERROR_NONE;
+}
+
+// --- Op: CumSum (Prefix Sum) ---
+mf_exec_error op_CUMSUM(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+    return scan_run(ctx, inst, MF_SCAN_SUM);
 }
 
 // --- Op: Compress (Filter) ---
-void op_COMPRESS(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
-    (void)ctx; (void)inst;
-    MF_LOG_WARN("OpCompress is temporarily disabled in the new Flat Execution model.");
+
+static inline bool compress_keep(const u8* mask, mf_dtype dtype) {
+    switch (dtype) {
+        case MF_DTYPE_F32: return *(const f32*)mask != 0.0f;
+        case MF_DTYPE_I32: return *(const i32*)mask != 0;
+        default:           return *mask != 0;
+    }
+}
+
+/**
+ * Stream compaction over the scan tiles: a job counts the survivors of its slice, gets
+ * the survivors of all earlier jobs by look-back and copies its own right after them.
+ * The last tile's prefix is the output length; the backend hands it to the readers.
+ */
+mf_exec_error op_COMPRESS(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+    const u8* src = (const u8*)ctx->reg_ptrs[inst->src1_idx];
+    const u8* mask = (const u8*)ctx->reg_ptrs[inst->src2_idx];
+    u8* dst = (u8*)ctx->reg_ptrs[inst->dest_idx];
+    i32 st_dst = MF_GET_STRIDE_D(inst);
+    i32 st_src = MF_GET_STRIDE_S1(inst);
+    i32 st_mask = MF_GET_STRIDE_S2(inst);
+    mf_dtype mask_dtype = ctx->reg_info[inst->src2_idx].dtype;
+    size_t elem_size = mf_dtype_size(ctx->reg_info[inst->src1_idx].dtype);
+    size_t count = ctx->batch_size;
+
+    u32 offset = 0;
+    if (ctx->scan_tiles) {
+        u32 kept = 0;
+        for (size_t i = 0; i < count; ++i) kept += compress_keep(mask + (ptrdiff_t)i * st_mask, mask_dtype);
+        offset = scan_publish(ctx, scan_slice_i32, MF_SCAN_SUM, 0, kept);
+    }
+
+    // Survivors land at absolute positions: step back from this job's slice to the buffer start
+    u8* out = dst + ((ptrdiff_t)offset - (ptrdiff_t)ctx->linear_offset) * st_dst;
+    for (size_t i = 0; i < count; ++i) {
+        if (compress_keep(mask, mask_dtype)) { memcpy(out, src, elem_size); out += st_dst; }
+        src += st_src;
+        mask += st_mask;
+    }
+    return MF_ERROR_NONE;
 }
 
 // --- Op: Gather (Random Access) ---
-void op_GATHER(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
-    u8* dst_ptr = (u8*)ctx->reg_ptrs[inst->dest_idx];
-    u8* idx_ptr = (u8*)ctx->reg_ptrs[inst->src2_idx];
-    u8* data_base = (u8*)ctx->reg_ptrs[inst->src1_idx];
 
-    const mf_type_info* idx_info = &ctx->reg_info[inst->src2_idx];
-    const mf_type_info* data_info = &ctx->reg_info[inst->src1_idx];
+#define MF_GATHER_PREFETCH 16   // Elements ahead to prefetch on random indices
 
-    size_t data_count = 1;
-    for(int i=0; i<data_info->ndim; ++i) data_count *= (size_t)data_info->shape[i];
-    
-    size_t out_count = ctx->batch_size;
-    size_t elem_size = mf_dtype_size(data_info->dtype);
-    
-    i32 st_dst = MF_GET_STRIDE_D(inst);
-    i32 st_idx = MF_GET_STRIDE_S2(inst);
+static inline i32 gather_index(const u8* p, mf_dtype dtype) {
+    switch (dtype) {
+        case MF_DTYPE_F32: return (i32)*(const f32*)p;
+        case MF_DTYPE_U8:  return (i32)*p;
+        default:           return *(const i32*)p;
+    }
+}
 
-    bool is_contiguous = true;
-    if (data_info->ndim > 0) {
-        int32_t expected_stride = 1;
-        for (int i = data_info->ndim - 1; i >= 0; --i) {
-            if (data_info->strides[i] != expected_stride) { is_contiguous = false; break; }
-            expected_stride *= data_info->shape[i];
-        }
+static bool gather_is_contiguous(const mf_type_info* info) {
+    int32_t expected_stride = 1;
+    for (int i = info->ndim - 1; i >= 0; --i) {
+        if (info->strides[i] != expected_stride) return false;
+        expected_stride *= info->shape[i];
     }
+    return true;
+}
 
-    for (size_t i = 0; i < out_count; ++i) {
-        int idx = -1;
-        if (idx_info->dtype == MF_DTYPE_F32) {
-            idx = (int)(*(f32*)idx_ptr);
-        } else {
-            idx = *(i32*)idx_ptr;
-        }
+// Any index stream and data layout; out-of-range indices write zero and raise the error
+static mf_exec_error gather_checked(mf_exec_ctx* ctx, u8* dst, i32 st_dst, const u8* idx, i32 st_idx, mf_dtype idx_dtype,
+                                    const u8* data, const mf_type_info* data_info, size_t data_count, size_t n) {
+    size_t elem_size = mf_dtype_size(data_info->dtype);
+    bool is_contiguous = gather_is_contiguous(data_info);
+    mf_exec_error err = MF_ERROR_NONE;
 
-        u8* target = dst_ptr;
-        if (idx >= 0 && (size_t)idx < data_count) {
-            void* src_item_ptr = NULL;
-            if (is_contiguous) {
-                src_item_ptr = data_base + (size_t)idx * elem_size;
-            } else {
-                size_t offset = 0;
-                size_t temp_idx = (size_t)idx;
+    for (size_t i = 0; i < n; ++i) {
+        i32 k = gather_index(idx, idx_dtype);
+        if (k >= 0 && (size_t)k < data_count) {
+            size_t offset = (size_t)k;
+            if (!is_contiguous) {
+                offset = 0;
+                size_t temp_idx = (size_t)k;
                 for (int d = data_info->ndim - 1; d >= 0; --d) {
                     offset += (temp_idx % data_info->shape[d]) * data_info->strides[d];
                     temp_idx /= data_info->shape[d];
                 }
-                src_item_ptr = data_base + offset * elem_size;
             }
-            memcpy(target, src_item_ptr, elem_size);
+            memcpy(dst, data + offset * elem_size, elem_size);
         } else {
-            memset(target, 0, elem_size);
-            if (_mf_should_log_error(ctx)) {
-                ctx->error = MF_ERROR_OUT_OF_BOUNDS;
+            memset(dst, 0, elem_size);
+            if (err == MF_ERROR_NONE && _mf_should_log_error(ctx)) {
+                err = MF_ERROR_OUT_OF_BOUNDS;
                 ctx->error_idx = (u32)i;
                 MF_LOG_ERROR("Gather OOB: Index %d at batch element %zu. Data size: %zu. Using 0.", 
-                             idx, i, data_count);
+                             k, i, data_count);
             }
         }
-        dst_ptr += st_dst;
-        idx_ptr += st_idx;
+        dst += st_dst;
+        idx += st_idx;
+    }
+    return err;
+}
+
+// The job's indices as a packed i32 array (the register itself when it already is one)
+static const i32* gather_unpack(mf_exec_ctx* ctx, const u8* idx, i32 st_idx, mf_dtype dtype, size_t n) {
+    if (dtype == MF_DTYPE_I32 && st_idx == (i32)sizeof(i32)) return (const i32*)idx;
+    i32* out = (i32*)mf_exec_ctx_scratch_alloc(ctx, sizeof(i32) * n);
+    if (!out) return NULL;
+    size_t i = 0;
+    if (dtype == MF_DTYPE_F32 && st_idx == (i32)sizeof(f32)) {
+        for (; i + MF_VF32_WIDTH <= n; i += MF_VF32_WIDTH) mf_vi32_store(out + i, mf_vi32_from_vf32(mf_vf32_load((const f32*)idx + i)));
+    }
+    for (; i < n; ++i) out[i] = gather_index(idx + (ptrdiff_t)i * st_idx, dtype);
+    return out;
+}
+
+/**
+ * Range of the indices, and whether they step by a constant (0 = one element for
+ * all, 1 = a contiguous run). One vector pass: lane-wise min/max, and the step
+ * mismatches of neighbouring indices or-ed together.
+ */
+typedef struct {
+    i32 min, max;
+    i32 step;
+    bool affine;
+} mf_gather_stats;
+
+static mf_gather_stats gather_scan(const i32* idx, size_t n) {
+    mf_gather_stats stats = { idx[0], idx[0], 0, true };
+    if (n < 2) return stats;
+    const u32 step = (u32)idx[1] - (u32)idx[0];
+    i32 lo = idx[0], hi = idx[0];
+    u32 off = 0;
+    size_t i = 1;
+    if (n > MF_VF32_WIDTH) {
+        mf_vi32 vlo = mf_vi32_set1(lo), vhi = vlo, voff = mf_vi32_set1(0);
+        const mf_vi32 vstep = mf_vi32_set1((i32)step);
+        for (; i + MF_VF32_WIDTH <= n; i += MF_VF32_WIDTH) {
+            mf_vi32 k = mf_vi32_load(idx + i);
+            vlo = mf_vi32_min(vlo, k);
+            vhi = mf_vi32_max(vhi, k);
+            voff = mf_vi32_or(voff, mf_vi32_xor(mf_vi32_sub(k, mf_vi32_load(idx + i - 1)), vstep));
+        }
+        lo = mf_vi32_reduce_min(vlo);
+        hi = mf_vi32_reduce_max(vhi);
+        off = (u32)mf_vi32_reduce_or(voff);
+    }
+    for (; i < n; ++i) {
+        i32 k = idx[i];
+        lo = k < lo ? k : lo;
+        hi = k > hi ? k : hi;
+        off |= ((u32)k - (u32)idx[i - 1]) ^ step;
     }
+    stats.min = lo;
+    stats.max = hi;
+    stats.step = (i32)step;
+    stats.affine = (off == 0);
+    return stats;
+}
+
+#define MF_GATHER_LOOP(T) { \
+    const T* src = (const T*)data; \
+    size_t i = 0; \
+    for (; i + MF_GATHER_PREFETCH < n; ++i) { \
+        MF_PREFETCH(src + idx[i + MF_GATHER_PREFETCH]); \
+        *(T*)(dst + (ptrdiff_t)i * st_dst) = src[idx[i]]; \
+    } \
+    for (; i < n; ++i) *(T*)(dst + (ptrdiff_t)i * st_dst) = src[idx[i]]; \
+}
+
+// In-bounds indices into contiguous data
+static void gather_random(u8* dst, i32 st_dst, const i32* idx, const u8* data, size_t elem_size, size_t n) {
+    switch (elem_size) {
+        case 1: MF_GATHER_LOOP(u8); break;
+        case 2: MF_GATHER_LOOP(u16); break;
+        case 4: MF_GATHER_LOOP(u32); break;
+        default:
+            for (size_t i = 0; i < n; ++i) memcpy(dst + (ptrdiff_t)i * st_dst, data + (size_t)idx[i] * elem_size, elem_size);
+            break;
+    }
+}
+
+#define MF_GATHER_STRIDED(T) \
+    for (size_t i = 0; i < n; ++i) *(T*)(dst + (ptrdiff_t)i * st_dst) = *(const T*)(src + (ptrdiff_t)i * step)
+
+// Indices first, first + step, ...: a strided copy, a plain memcpy for step 1
+static void gather_strided(u8* dst, i32 st_dst, const u8* src, ptrdiff_t step, size_t elem_size, size_t n) {
+    if (step == (ptrdiff_t)elem_size && st_dst == (i32)elem_size) {
+        memcpy(dst, src, n * elem_size);
+        return;
+    }
+    switch (elem_size) {
+        case 1: MF_GATHER_STRIDED(u8); break;
+        case 2: MF_GATHER_STRIDED(u16); break;
+        case 4: MF_GATHER_STRIDED(u32); break;
+        default:
+            for (size_t i = 0; i < n; ++i) memcpy(dst + (ptrdiff_t)i * st_dst, src + (ptrdiff_t)i * step, elem_size);
+            break;
+    }
+}
+
+static mf_exec_error gather_run(mf_exec_ctx* ctx, const struct mf_instruction* inst, bool fast) {
+    const mf_type_info* idx_info = &ctx->reg_info[inst->src2_idx];
+    const mf_type_info* data_info = &ctx->reg_info[inst->src1_idx];
+    u8* dst = (u8*)ctx->reg_ptrs[inst->dest_idx];
+    const u8* idx_ptr = (const u8*)ctx->reg_ptrs[inst->src2_idx];
+    size_t n = ctx->batch_size;
+    if (n == 0) return MF_ERROR_NONE;
+
+    // The data is read whole: step back from this job's offset to the start of the register
+    const u8* data = (const u8*)ctx->reg_ptrs[inst->src1_idx] - (ptrdiff_t)ctx->linear_offset * MF_GET_STRIDE_S1(inst);
+    size_t data_count = mf_shape_calc_count(data_info->shape, data_info->ndim);
+    size_t elem_size = mf_dtype_size(data_info->dtype);
+    i32 st_dst = MF_GET_STRIDE_D(inst);
+    i32 st_idx = MF_GET_STRIDE_S2(inst);
+
+    const i32* idx = (fast && gather_is_contiguous(data_info)) ? gather_unpack(ctx, idx_ptr, st_idx, idx_info->dtype, n) : NULL;
+    mf_gather_stats stats = idx ? gather_scan(idx, n) : (mf_gather_stats){ -1, -1, 0, false };
+    if (stats.min < 0 || (size_t)stats.max >= data_count) {
+        return gather_checked(ctx, dst, st_dst, idx_ptr, st_idx, idx_info->dtype, data, data_info, data_count, n);
+    }
+
+    if (stats.affine) gather_strided(dst, st_dst, data + (size_t)idx[0] * elem_size, (ptrdiff_t)stats.step * (ptrdiff_t)elem_size, elem_size, n);
+    else gather_random(dst, st_dst, idx, data, elem_size, n);
+    return MF_ERROR_NONE;
+}
+
+/**
+ * Indices are unpacked to i32 and scanned once per job: out-of-range indices or
+ * strided data take the checked loop, constant steps a strided copy, the rest a
+ * prefetching loop per element size.
+ */
+mf_exec_error op_GATHER(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+    return gather_run(ctx, inst, true);
+}
+
+// Checked loop only: reference for the fast paths (mf-bench gather)
+static mf_exec_error op_GATHER_ref(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+    return gather_run(ctx, inst, false);
+}
+
+// --- Op: Scatter / ScatterAdd (Random Writes) ---
+
+/**
+ * A scatter's dest register is a partial target (see mf_ops_scatter_slot_size): the
+ * running thread's own, or one shared by all threads for the _atomic kernels. ScatterAdd
+ * sums values into it. Scatter tags every value with its element index + 1 in the high
+ * word, so keeping the largest tag per slot lets the highest index win whatever order
+ * the jobs ran in, and a zero slot was never written.
+ */
+static inline i64 scatter_tag(size_t elem, const u8* val) {
+    u32 bits;
+    memcpy(&bits, val, sizeof(bits));
+    return (i64)((((u64)elem + 1) << 32) | bits);
+}
+
+static inline void scatter_add_f32_atomic(u8* slot, f32 v) {
+    mf_atomic_i32* a = (mf_atomic_i32*)slot;
+    for (;;) {
+        i32 seen = mf_atomic_load(a);
+        f32 sum;
+        memcpy(&sum, &seen, sizeof(sum));
+        sum += v;
+        i32 next;
+        memcpy(&next, &sum, sizeof(next));
+        if (mf_atomic_cas(a, seen, next)) return;
+    }
+}
+
+static inline void scatter_max_atomic(u8* slot, i64 tag) {
+    mf_atomic_i64* a = (mf_atomic_i64*)slot;
+    for (i64 seen = mf_atomic_load64(a); tag > seen; seen = mf_atomic_load64(a)) {
+        if (mf_atomic_cas64(a, seen, tag)) return;
+    }
+}
+
+// Out-of-range indices are skipped; the first one of the job is reported
+#define MF_SCATTER_LOOP(SLOT_SIZE, BODY) \
+    for (size_t i = 0; i < n; ++i) { \
+        i32 k = ids[i]; \
+        if (k < 0 || (size_t)k >= count) { \
+            if (err == MF_ERROR_NONE) { \
+                err = MF_ERROR_OUT_OF_BOUNDS; \
+                ctx->error_idx = (u32)i; \
+                if (_mf_should_log_error(ctx)) MF_LOG_ERROR("Scatter OOB: Index %d at batch element %zu. Target size: %zu. Skipped.", k, i, count); \
+            } \
+            continue; \
+        } \
+        if (i + MF_GATHER_PREFETCH < n) MF_PREFETCH(slots + (size_t)(u32)ids[i + MF_GATHER_PREFETCH] * (SLOT_SIZE)); \
+        u8* slot = slots + (size_t)k * (SLOT_SIZE); \
+        const u8* v = val + (ptrdiff_t)i * st_val; \
+        BODY; \
+    }
+
+static mf_exec_error scatter_run(mf_exec_ctx* ctx, const struct mf_instruction* inst, bool add, bool atomic) {
+    u8* slots = (u8*)ctx->reg_ptrs[inst->dest_idx];
+    const u8* val = (const u8*)ctx->reg_ptrs[inst->src1_idx];
+    const u8* idx_ptr = (const u8*)ctx->reg_ptrs[inst->src2_idx];
+    size_t n = ctx->batch_size;
+    if (n == 0) return MF_ERROR_NONE;
+    MF_CHECK_PTR(ctx, slots);
+    MF_CHECK_PTR(ctx, val);
+    MF_CHECK_PTR(ctx, idx_ptr);
+
+    const mf_type_info* target = &ctx->reg_info[inst->dest_idx];
+    size_t count = mf_shape_calc_count(target->shape, target->ndim);
+    i32 st_val = MF_GET_STRIDE_S1(inst);
+    const i32* ids = gather_unpack(ctx, idx_ptr, MF_GET_STRIDE_S2(inst), ctx->reg_info[inst->src2_idx].dtype, n);
+    MF_CHECK_PTR(ctx, ids);
+    const size_t base_elem = ctx->linear_offset;
+    mf_exec_error err = MF_ERROR_NONE;
+
+    if (!add) {
+        if (atomic) MF_SCATTER_LOOP(sizeof(i64), scatter_max_atomic(slot, scatter_tag(base_elem + i, v)))
+        else MF_SCATTER_LOOP(sizeof(i64), { i64 tag = scatter_tag(base_elem + i, v); if (tag > *(i64*)slot) *(i64*)slot = tag; })
+    } else if (target->dtype == MF_DTYPE_I32) {
+        // Wraps like the i32 sums of the other kernels
+        if (atomic) MF_SCATTER_LOOP(sizeof(i32), mf_atomic_add((mf_atomic_i32*)slot, *(const i32*)v))
+        else MF_SCATTER_LOOP(sizeof(i32), *(u32*)slot += *(const u32*)v)
+    } else {
+        if (atomic) MF_SCATTER_LOOP(sizeof(f32), scatter_add_f32_atomic(slot, *(const f32*)v))
+        else MF_SCATTER_LOOP(sizeof(f32), *(f32*)slot += *(const f32*)v)
+    }
+    return err;
+}
+
+mf_exec_error op_SCATTER(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+    return scatter_run(ctx, inst, false, false);
+}
+
+mf_exec_error op_SCATTER_ADD(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+    return scatter_run(ctx, inst, true, false);
+}
+
+static mf_exec_error op_SCATTER_atomic(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+    return scatter_run(ctx, inst, false, true);
+}
+
+static mf_exec_error op_SCATTER_ADD_atomic(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+    return scatter_run(ctx, inst, true, true);
+}
+
+mf_op_func mf_ops_find_atomic(u16 opcode) {
+    switch (opcode) {
+        case MF_OP_SCATTER:     return op_SCATTER_atomic;
+        case MF_OP_SCATTER_ADD: return op_SCATTER_ADD_atomic;
+        default:                return NULL;
+    }
+}
+
+size_t mf_ops_scatter_slot_size(u16 opcode, mf_dtype dtype) {
+    return opcode == MF_OP_SCATTER ? sizeof(i64) : mf_dtype_size(dtype);
+}
+
+void mf_ops_scatter_fold(u16 opcode, mf_dtype dtype, void* acc, const void* partial, size_t count) {
+    if (opcode == MF_OP_SCATTER) {
+        i64* a = (i64*)acc;
+        const i64* p = (const i64*)partial;
+        for (size_t j = 0; j < count; ++j) a[j] = p[j] > a[j] ? p[j] : a[j];
+    } else if (dtype == MF_DTYPE_I32) {
+        u32* a = (u32*)acc;
+        const u32* p = (const u32*)partial;
+        for (size_t j = 0; j < count; ++j) a[j] += p[j];
+    } else {
+        f32* a = (f32*)acc;
+        const f32* p = (const f32*)partial;
+        for (size_t j = 0; j < count; ++j) a[j] += p[j];
+    }
+}
+
+void mf_ops_scatter_store(u16 opcode, mf_dtype dtype, const void* acc, const void* base, void* dest, size_t count) {
+    if (opcode == MF_OP_SCATTER) {
+        const i64* a = (const i64*)acc;
+        const u32* b = (const u32*)base;
+        u32* d = (u32*)dest;
+        for (size_t j = 0; j < count; ++j) d[j] = a[j] ? (u32)a[j] : b[j];
+    } else if (dtype == MF_DTYPE_I32) {
+        const u32* a = (const u32*)acc;
+        const u32* b = (const u32*)base;
+        u32* d = (u32*)dest;
+        for (size_t j = 0; j < count; ++j) d[j] = b[j] + a[j];
+    } else {
+        const f32* a = (const f32*)acc;
+        const f32* b = (const f32*)base;
+        f32* d = (f32*)dest;
+        for (size_t j = 0; j < count; ++j) d[j] = b[j] + a[j];
+    }
+}
+
+// --- Op: Sort / ArgSort / SortByKey (LSD Radix Sort) ---
+
+/**
+ * Keys are sorted as u32 whose unsigned order is the value order: i32 flips the sign
+ * bit, f32 the sign bit of positives and every bit of negatives (-0 sorts before +0,
+ * NaNs to the end of their sign). Each pass moves the elements stably by one 8-bit
+ * digit, so equal keys keep their order. A pass whose digit is the same for every key
+ * would move nothing and is skipped.
+ */
+typedef enum { MF_SORT_VALUES, MF_SORT_INDICES, MF_SORT_PAYLOAD } mf_sort_mode;
+
+static inline u32 sort_key(u32 bits, bool is_float) {
+    if (!is_float) return bits ^ 0x80000000u;
+    return bits ^ ((bits >> 31) ? 0xFFFFFFFFu : 0x80000000u);
+}
+
+static inline u32 sort_key_inverse(u32 key, bool is_float) {
+    if (!is_float) return key ^ 0x80000000u;
+    return key ^ ((key >> 31) ? 0x80000000u : 0xFFFFFFFFu);
+}
+
+static inline u32 sort_digit(u32 key, u32 pass) { return (key >> (pass * 8)) & (MF_SORT_RADIX - 1); }
+
+// Waits until every tile has finished `round`; false if the run was stopped meanwhile
+static bool sort_wait_round(mf_exec_ctx* ctx, mf_sort_state* sort, u32 round) {
+    for (u32 spin = 0; (u32)mf_atomic_load(&sort->rounds_done[round]) < sort->tile_count; ++spin) {
+        if (spin < MF_SCAN_SPINS) mf_cpu_relax();
+        else if (scan_stopped(ctx)) return false;
+        else mf_thread_yield();
+    }
+    return true;
+}
+
+// Bit p set if pass p moves elements. The last pass runs when none would, so the result lands in dest.
+static u32 sort_active_passes(mf_sort_state* sort) {
+    u32 total = 0;
+    for (u32 d = 0; d < MF_SORT_RADIX; ++d) total += (u32)mf_atomic_load(&sort->histogram[d]);
+    u32 mask = 0;
+    for (u32 p = 0; p < MF_SORT_PASSES; ++p) {
+        bool trivial = false;
+        for (u32 d = 0; d < MF_SORT_RADIX && !trivial; ++d) trivial = (u32)mf_atomic_load(&sort->histogram[p * MF_SORT_RADIX + d]) == total;
+        if (!trivial) mask |= 1u << p;
+    }
+    return mask ? mask : 1u << (MF_SORT_PASSES - 1);
+}
+
+// Round 0: ordered keys (and payload) of the slice at `off` into buffer 0, digits of all passes into the histogram
+static void sort_count(mf_exec_ctx* ctx, const struct mf_instruction* inst, mf_sort_state* sort, mf_sort_mode mode, bool is_float, size_t off) {
+    const u8* src = (const u8*)ctx->reg_ptrs[inst->src1_idx];
+    i32 st_src = MF_GET_STRIDE_S1(inst);
+    size_t n = ctx->batch_size;
+    u32* keys = sort->keys[0] + off;
+    u32 counts[MF_SORT_PASSES][MF_SORT_RADIX];
+    memset(counts, 0, sizeof(counts));
+
+    for (size_t i = 0; i < n; ++i) {
+        u32 bits;
+        memcpy(&bits, src + (ptrdiff_t)i * st_src, sizeof(bits));
+        u32 key = sort_key(bits, is_float);
+        keys[i] = key;
+        for (u32 p = 0; p < MF_SORT_PASSES; ++p) counts[p][sort_digit(key, p)]++;
+    }
+    if (mode == MF_SORT_INDICES) {
+        u32* payload = sort->payload[0] + off;
+        for (size_t i = 0; i < n; ++i) payload[i] = (u32)(off + i);
+    } else if (mode == MF_SORT_PAYLOAD) {
+        const u8* val = (const u8*)ctx->reg_ptrs[inst->src2_idx];
+        i32 st_val = MF_GET_STRIDE_S2(inst);
+        u32* payload = sort->payload[0] + off;
+        for (size_t i = 0; i < n; ++i) memcpy(&payload[i], val + (ptrdiff_t)i * st_val, sizeof(u32));
+    }
+
+    for (u32 p = 0; p < MF_SORT_PASSES; ++p) {
+        for (u32 d = 0; d < MF_SORT_RADIX; ++d) {
+            if (counts[p][d]) mf_atomic_add(&sort->histogram[p * MF_SORT_RADIX + d], (i32)counts[p][d]);
+        }
+    }
+}
+
+/**
+ * Round 1 + pass: moves the slice at `off` by the pass digit. A digit's elements of this
+ * tile go after all smaller digits (histogram) and after the same digit of the tiles
+ * before (look-back over one status word per tile and digit). The last active pass
+ * writes dest: the keys (Sort) or the payload (ArgSort, SortByKey).
+ */
+static void sort_move(mf_exec_ctx* ctx, const struct mf_instruction* inst, mf_sort_state* sort, mf_sort_mode mode, bool is_float,
+                      u32 pass, u32 tile, size_t off) {
+    u32 active = sort_active_passes(sort);
+    if (!(active & (1u << pass))) return;
+    u32 before = 0;
+    for (u32 p = 0; p < pass; ++p) before += (active >> p) & 1u;
+    bool last = (active >> (pass + 1)) == 0;
+
+    const u32* keys = sort->keys[before & 1];
+    const u32* payload = sort->payload[before & 1];
+    u32* keys_out = sort->keys[(before + 1) & 1];
+    u32* payload_out = sort->payload[(before + 1) & 1];
+    size_t n = ctx->batch_size;
+
+    u32 counts[MF_SORT_RADIX] = {0};
+    for (size_t i = 0; i < n; ++i) counts[sort_digit(keys[off + i], pass)]++;
+
+    // Aggregates first, so later tiles stop waiting as early as possible
+    mf_atomic_i64* status = sort->status + (size_t)pass * sort->tile_count * MF_SORT_RADIX;
+    mf_atomic_i64* own = status + (size_t)tile * MF_SORT_RADIX;
+    if (tile > 0) {
+        for (u32 d = 0; d < MF_SORT_RADIX; ++d) mf_atomic_store64(&own[d], scan_status(MF_SCAN_FLAG_AGGREGATE, counts[d]));
+    }
+    u32 start[MF_SORT_RADIX];
+    u32 digit_base = 0;
+    for (u32 d = 0; d < MF_SORT_RADIX; ++d) {
+        u32 prefix = scan_lookback(ctx, status + d, MF_SORT_RADIX, tile, scan_slice_i32, MF_SCAN_SUM, 0);
+        mf_atomic_store64(&own[d], scan_status(MF_SCAN_FLAG_PREFIX, prefix + counts[d]));
+        start[d] = digit_base + prefix;
+        digit_base += (u32)mf_atomic_load(&sort->histogram[pass * MF_SORT_RADIX + d]);
+    }
+
+    if (!last) {
+        for (size_t i = 0; i < n; ++i) {
+            u32 pos = start[sort_digit(keys[off + i], pass)]++;
+            keys_out[pos] = keys[off + i];
+            if (payload) payload_out[pos] = payload[off + i];
+        }
+        return;
+    }
+    // Dest positions are absolute: step back from this job's slice to the buffer start
+    i32 st_dst = MF_GET_STRIDE_D(inst);
+    u8* dst = (u8*)ctx->reg_ptrs[inst->dest_idx] - (ptrdiff_t)ctx->linear_offset * st_dst;
+    for (size_t i = 0; i < n; ++i) {
+        u32 key = keys[off + i];
+        u32 out = (mode == MF_SORT_VALUES) ? sort_key_inverse(key, is_float) : payload[off + i];
+        memcpy(dst + (ptrdiff_t)start[sort_digit(key, pass)]++ * st_dst, &out, sizeof(out));
+    }
+}
+
+// Not dispatched in rounds (no sort state from the backend): sorts the batch alone in scratch buffers
+static mf_exec_error sort_alone(mf_exec_ctx* ctx, const struct mf_instruction* inst, mf_sort_mode mode, bool is_float) {
+    size_t n = ctx->batch_size;
+    mf_sort_state sort = {0};
+    sort.tile_count = 1;
+    sort.histogram = (mf_atomic_i32*)mf_exec_ctx_scratch_alloc(ctx, sizeof(mf_atomic_i32) * MF_SORT_PASSES * MF_SORT_RADIX);
+    sort.status = (mf_atomic_i64*)mf_exec_ctx_scratch_alloc(ctx, sizeof(mf_atomic_i64) * MF_SORT_PASSES * MF_SORT_RADIX);
+    sort.keys[0] = (u32*)mf_exec_ctx_scratch_alloc(ctx, sizeof(u32) * n * 2);
+    MF_CHECK_PTR(ctx, sort.histogram);
+    MF_CHECK_PTR(ctx, sort.status);
+    MF_CHECK_PTR(ctx, sort.keys[0]);
+    sort.keys[1] = sort.keys[0] + n;
+    if (mode != MF_SORT_VALUES) {
+        sort.payload[0] = (u32*)mf_exec_ctx_scratch_alloc(ctx, sizeof(u32) * n * 2);
+        MF_CHECK_PTR(ctx, sort.payload[0]);
+        sort.payload[1] = sort.payload[0] + n;
+    }
+    memset((void*)sort.histogram, 0, sizeof(mf_atomic_i32) * MF_SORT_PASSES * MF_SORT_RADIX);
+
+    // Dest is written at linear_offset + position
+    sort_count(ctx, inst, &sort, mode, is_float, 0);
+    u32 saved_offset = ctx->linear_offset;
+    ctx->linear_offset = 0;
+    for (u32 p = 0; p < MF_SORT_PASSES; ++p) sort_move(ctx, inst, &sort, mode, is_float, p, 0, 0);
+    ctx->linear_offset = saved_offset;
+    return MF_ERROR_NONE;
+}
+
+static mf_exec_error sort_run(mf_exec_ctx* ctx, const struct mf_instruction* inst, mf_sort_mode mode) {
+    if (ctx->batch_size == 0) return MF_ERROR_NONE;
+    MF_CHECK_PTR(ctx, ctx->reg_ptrs[inst->dest_idx]);
+    MF_CHECK_PTR(ctx, ctx->reg_ptrs[inst->src1_idx]);
+    if (mode == MF_SORT_PAYLOAD) MF_CHECK_PTR(ctx, ctx->reg_ptrs[inst->src2_idx]);
+    bool is_float = ctx->reg_info[inst->src1_idx].dtype == MF_DTYPE_F32;
+
+    mf_sort_state* sort = ctx->sort;
+    if (!sort) return sort_alone(ctx, inst, mode, is_float);
+
+    u32 round = ctx->job_round;
+    if (round > 0 && !sort_wait_round(ctx, sort, round - 1)) return MF_ERROR_NONE;
+    if (round == 0) sort_count(ctx, inst, sort, mode, is_float, ctx->linear_offset);
+    else sort_move(ctx, inst, sort, mode, is_float, round - 1, ctx->job_idx, ctx->linear_offset);
+    mf_atomic_inc(&sort->rounds_done[round]);
+    return MF_ERROR_NONE;
+}
+
+mf_exec_error op_SORT(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+    return sort_run(ctx, inst, MF_SORT_VALUES);
+}
+
+mf_exec_error op_ARGSORT(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+    return sort_run(ctx, inst, MF_SORT_INDICES);
+}
+
+mf_exec_error op_SORT_BY_KEY(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+    return sort_run(ctx, inst, MF_SORT_PAYLOAD);
+}
+
+void mf_ops_array_fill_reference(mf_op_func* table) {
+    table[MF_OP_GATHER] = op_GATHER_ref;
 }
@@ -1,6 +1,8 @@
 #include <mathflow/ops/mf_ops_core.h>
 #include "mf_ops_internal.h"
+#include "mf_simd.h"
 #include <mathflow/isa/mf_opcodes.h>
+#include <math.h>
 #include <string.h>
 
 /**
@@ -9,12 +11,13 @@
  */
 
 // No-operation kernel
-void op_NOOP(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+mf_exec_error op_NOOP(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
     (void)ctx; (void)inst;
+    return MF_ERROR_NONE;
 }
 
 // Forward declarations for all kernels defined in other modules
-#define MF_OPCODE(suffix, value) extern void op_##suffix(mf_exec_ctx* ctx, const struct mf_instruction* inst);
+#define MF_OPCODE(suffix, value) extern mf_exec_error op_##suffix(mf_exec_ctx* ctx, const struct mf_instruction* inst);
 MF_OPCODE_LIST
 #undef MF_OPCODE
 
@@ -25,4 +28,60 @@ void mf_ops_fill_table(mf_op_func* table) {
 #define MF_OPCODE(suffix, value) table[MF_OP_##suffix] = op_##suffix;
     MF_OPCODE_LIST
 #undef MF_OPCODE
-}
\ No newline at end of file
+    mf_ops_math_fill_emulated(table, false);
+}
+
+void mf_ops_fill_table_reference(mf_op_func* table) {
+    if (!table) return;
+    mf_ops_fill_table(table);
+    mf_ops_math_fill_reference(table);
+    mf_ops_matrix_fill_reference(table);
+    mf_ops_array_fill_reference(table);
+}
+
+void mf_ops_fill_table_fast(mf_op_func* table) {
+    if (!table) return;
+    mf_ops_fill_table(table);
+    mf_ops_math_fill_fast(table);
+    mf_ops_math_fill_emulated(table, true);
+}
+
+mf_op_func mf_ops_find_specialized(u16 opcode, const i32* byte_strides) {
+    if (!byte_strides || opcode >= MF_OP_LIMIT) return NULL;
+    return mf_ops_math_specialize(opcode, byte_strides, false);
+}
+
+mf_op_func mf_ops_find_specialized_fast(u16 opcode, const i32* byte_strides) {
+    if (!byte_strides || opcode >= MF_OP_LIMIT) return NULL;
+    return mf_ops_math_specialize(opcode, byte_strides, true);
+}
+
+mf_op_func mf_ops_find_typed(u16 opcode, const mf_dtype* dtypes) {
+    if (!dtypes || opcode >= MF_OP_LIMIT) return NULL;
+    mf_op_func fn = mf_ops_logic_find_typed(opcode, dtypes);
+    return fn ? fn : mf_ops_math_find_typed(opcode, dtypes);
+}
+
+// Blocks are checked as a whole (x - x is NaN only for NaN/Inf lanes), then searched on a hit
+#define MF_NONFINITE_BLOCK (8 * MF_VF32_WIDTH)
+
+size_t mf_ops_find_nonfinite(const f32* data, size_t count) {
+    if (!data) return count;
+    size_t i = 0;
+    for (; i + MF_NONFINITE_BLOCK <= count; i += MF_NONFINITE_BLOCK) {
+        mf_vf32 acc = mf_vf32_set1(0.0f);
+        for (size_t j = 0; j < MF_NONFINITE_BLOCK; j += MF_VF32_WIDTH) {
+            const mf_vf32 v = mf_vf32_load(data + i + j);
+            acc = mf_vf32_add(acc, mf_vf32_sub(v, v));
+        }
+        if (mf_vf32_any_nonfinite(acc)) break;
+    }
+    for (; i < count; ++i) {
+        if (!isfinite(data[i])) return i;
+    }
+    return count;
+}
+
+const char* mf_ops_simd_name(void) {
+    return MF_SIMD_NAME;
+}
@@ -17,6 +17,28 @@ static inline bool _mf_should_log_error(mf_exec_ctx* ctx) {
     return true;
 }
 
+// Overrides vectorized entries with their scalar reference kernels (mf_ops_math.c).
+void mf_ops_math_fill_reference(mf_op_func* table);
+
+// Overrides blocked matrix kernels with their direct loops (mf_ops_matrix.c).
+void mf_ops_matrix_fill_reference(mf_op_func* table);
+
+// Overrides the gather fast paths with the checked loop (mf_ops_array.c).
+void mf_ops_array_fill_reference(mf_op_func* table);
+
+// Overrides elementwise kernels with their unsanitized (_fast) forms (mf_ops_math.c).
+void mf_ops_math_fill_fast(mf_op_func* table);
+
+// Overrides vector kernels whose lanes are emulated (Fma without hardware FMA) with their scalar loops (mf_ops_math.c).
+void mf_ops_math_fill_emulated(mf_op_func* table, bool fast);
+
+// Stride-specialized variant of a vectorized kernel, NULL if none applies (mf_ops_math.c).
+mf_op_func mf_ops_math_specialize(u16 opcode, const i32* strides, bool fast);
+
+// Kernel for a non-f32 dtype signature {dest, src1, src2, src3}, NULL if none (mf_ops_math.c, mf_ops_logic.c).
+mf_op_func mf_ops_math_find_typed(u16 opcode, const mf_dtype* dtypes);
+mf_op_func mf_ops_logic_find_typed(u16 opcode, const mf_dtype* dtypes);
+
 // Generic Pointer Check
 #define MF_CHECK_PTR(CTX, PTR) \
     do { \
@@ -24,8 +46,7 @@ static inline bool _mf_should_log_error(mf_exec_ctx* ctx) {
             if (_mf_should_log_error(CTX)) { \
                 MF_LOG_ERROR("Runtime Error: Internal pointer is NULL. Op execution aborted."); \
             } \
-            (CTX)->error = MF_ERROR_RUNTIME; \
-            return; \
+            return MF_ERROR_RUNTIME; \
         } \
     } while(0)
 
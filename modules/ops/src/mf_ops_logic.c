@@ -7,16 +7,88 @@
 /**
  * MathFlow Logic Kernels
  * Automatically generated from mf_ops_db.inc
+ *
+ * Ops producing masks (MF_OUT_FORCE_U8) get one kernel per source dtype
+ * combination and store 1-byte results. Operands of the same dtype are
+ * compared natively, mixed ones as f64 (exact for f32, i32 and u8).
  */
 
-#define MF_GEN_AUTO(_op, _ke, _ar) MF_KERNEL_AUTO(_op, _ke, _ar)
-#define MF_GEN_MANUAL(...)
+#define MF_MASK_KERNEL(NAME, EXPR, AR, TA, TB, X) \
+    MF_KERNEL_TYPED(op_##NAME##_##TA##_##TB, EXPR, AR, u8, TA, TB, TB, X, X)
 
-#define MF_OP(_s, _n, _op, _cat, _strat, _in, _out, _tr, _sr, _ar, _p1, _p2, _p3, _p4, _kt, _ke, _arity) \
-    MF_GEN_##_kt(_op, _ke, _arity)
+// Table slot: slot(src1) + 3 * slot(src2)
+#define MF_MASK_KERNELS_2(NAME, EXPR) \
+    MF_MASK_KERNEL(NAME, EXPR, 2, f32, f32, f32) \
+    MF_MASK_KERNEL(NAME, EXPR, 2, i32, f32, f64) \
+    MF_MASK_KERNEL(NAME, EXPR, 2, u8,  f32, f64) \
+    MF_MASK_KERNEL(NAME, EXPR, 2, f32, i32, f64) \
+    MF_MASK_KERNEL(NAME, EXPR, 2, i32, i32, i32) \
+    MF_MASK_KERNEL(NAME, EXPR, 2, u8,  i32, f64) \
+    MF_MASK_KERNEL(NAME, EXPR, 2, f32, u8,  f64) \
+    MF_MASK_KERNEL(NAME, EXPR, 2, i32, u8,  f64) \
+    MF_MASK_KERNEL(NAME, EXPR, 2, u8,  u8,  u8) \
+    static const mf_op_func _mf_mask_tbl_##NAME[9] = { \
+        op_##NAME##_f32_f32, op_##NAME##_i32_f32, op_##NAME##_u8_f32, \
+        op_##NAME##_f32_i32, op_##NAME##_i32_i32, op_##NAME##_u8_i32, \
+        op_##NAME##_f32_u8,  op_##NAME##_i32_u8,  op_##NAME##_u8_u8 };
+
+// Unary: the second type only names the kernel
+#define MF_MASK_KERNELS_1(NAME, EXPR) \
+    MF_MASK_KERNEL(NAME, EXPR, 1, f32, u8, f32) \
+    MF_MASK_KERNEL(NAME, EXPR, 1, i32, u8, i32) \
+    MF_MASK_KERNEL(NAME, EXPR, 1, u8,  u8, u8) \
+    static const mf_op_func _mf_mask_tbl_##NAME[3] = { op_##NAME##_f32_u8, op_##NAME##_i32_u8, op_##NAME##_u8_u8 };
+
+static mf_op_func mask_select(const mf_op_func* tbl, int arity, mf_dtype a, mf_dtype b) {
+    int sa = mf_dtype_slot(a);
+    int sb = (arity >= 2) ? mf_dtype_slot(b) : 0;
+    if (sa < 0 || sb < 0) return NULL;
+    return tbl[sa + 3 * sb];
+}
+
+// The entry point resolves the signature per call; plans bind the typed kernel directly
+#define MF_MASK_ENTRY(NAME, AR) \
+mf_exec_error op_##NAME(mf_exec_ctx* ctx, const struct mf_instruction* inst) { \
+    mf_op_func fn = mask_select(_mf_mask_tbl_##NAME, AR, ctx->reg_info[inst->src1_idx].dtype, \
+                                (AR >= 2) ? ctx->reg_info[inst->src2_idx].dtype : MF_DTYPE_F32); \
+    return fn ? fn(ctx, inst) : MF_ERROR_NONE; \
+}
+
+#define MF_GEN_MASK_AUTO(_op, _ke, _ar) MF_MASK_KERNELS_##_ar(_op, _ke) MF_MASK_ENTRY(_op, _ar)
+#define MF_GEN_MASK_SIMD(...)
+#define MF_GEN_MASK_MANUAL(...)
+
+// Only ops that produce masks live here; the rest is generated in mf_ops_math.c
+#define MF_GEN_MF_OUT_FORCE_U8(_op, _kt, _ke, _ar) MF_GEN_MASK_##_kt(_op, _ke, _ar)
+#define MF_GEN_MF_OUT_FORCE_F32(...)
+#define MF_GEN_MF_OUT_FORCE_I32(...)
+#define MF_GEN_MF_OUT_SAME_AS_INPUT(...)
+#define MF_GEN_MF_OUT_SAME_AS_INPUT_2(...)
+
+#define MF_OP(_s, _n, _op, _cat, _strat, _in, _out, _tr, _sr, _ar, _p1, _p2, _p3, _p4, _kt, _ke, _kv, _arity) \
+    MF_GEN_##_tr(_op, _kt, _ke, _arity)
 
 MF_OP_LIST
 
 #undef MF_OP
-#undef MF_GEN_AUTO
-#undef MF_GEN_MANUAL
+
+mf_op_func mf_ops_logic_find_typed(u16 opcode, const mf_dtype* dtypes) {
+    switch (opcode) {
+#define MF_FIND_MASK_AUTO(_op, _ar) case MF_OP_##_op: return mask_select(_mf_mask_tbl_##_op, _ar, dtypes[1], dtypes[2]);
+#define MF_FIND_MASK_SIMD(...)
+#define MF_FIND_MASK_MANUAL(...)
+#define MF_FIND_MF_OUT_FORCE_U8(_op, _kt, _ar) MF_FIND_MASK_##_kt(_op, _ar)
+#define MF_FIND_MF_OUT_FORCE_F32(...)
+#define MF_FIND_MF_OUT_FORCE_I32(...)
+#define MF_FIND_MF_OUT_SAME_AS_INPUT(...)
+#define MF_FIND_MF_OUT_SAME_AS_INPUT_2(...)
+#define MF_OP(_s, _n, _op, _cat, _strat, _in, _out, _tr, _sr, _ar, _p1, _p2, _p3, _p4, _kt, _ke, _kv, _arity) \
+    MF_FIND_##_tr(_op, _kt, _arity)
+
+        MF_OP_LIST
+
+#undef MF_OP
+        default: break;
+    }
+    return NULL;
+}
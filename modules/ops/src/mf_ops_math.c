@@ -11,17 +11,149 @@
  * Automatically generated from mf_ops_db.inc
  */
 
-#define MF_GEN_AUTO(_op, _ke, _ar) MF_KERNEL_AUTO(_op, _ke, _ar)
+#define MF_GEN_AUTO(_op, _ke, _kv, _ar) MF_KERNEL_AUTO(_op, _ke, _ar)
+#define MF_GEN_SIMD(_op, _ke, _kv, _ar) MF_KERNEL_SIMD(_op, _ke, _kv, _ar)
 #define MF_GEN_MANUAL(...)
 
-#define MF_OP(_s, _n, _op, _cat, _strat, _in, _out, _tr, _sr, _ar, _p1, _p2, _p3, _p4, _kt, _ke, _arity) \
-    MF_GEN_##_kt(_op, _ke, _arity)
+// Mask-producing ops are generated in mf_ops_logic.c
+#define MF_MATH_MF_OUT_FORCE_U8(...)
+#define MF_MATH_MF_OUT_FORCE_F32(_op, _kt, _ke, _kv, _ar) MF_GEN_##_kt(_op, _ke, _kv, _ar)
+#define MF_MATH_MF_OUT_FORCE_I32(_op, _kt, _ke, _kv, _ar) MF_GEN_##_kt(_op, _ke, _kv, _ar)
+#define MF_MATH_MF_OUT_SAME_AS_INPUT(_op, _kt, _ke, _kv, _ar) MF_GEN_##_kt(_op, _ke, _kv, _ar)
+#define MF_MATH_MF_OUT_SAME_AS_INPUT_2(_op, _kt, _ke, _kv, _ar) MF_GEN_##_kt(_op, _ke, _kv, _ar)
+
+#define MF_OP(_s, _n, _op, _cat, _strat, _in, _out, _tr, _sr, _ar, _p1, _p2, _p3, _p4, _kt, _ke, _kv, _arity) \
+    MF_MATH_##_tr(_op, _kt, _ke, _kv, _arity)
 
 MF_OP_LIST
 
 #undef MF_OP
 #undef MF_GEN_AUTO
+#undef MF_GEN_SIMD
+#undef MF_GEN_MANUAL
+
+// --- Integer Kernels ---
+
+/**
+ * I32 forms of the numeric ops, for operands that are all I32. Arithmetic wraps
+ * (through u32), and division by zero gives 0 like the f32 sanitization does.
+ * Pow and Atan2 have no integer form and keep the f32 kernels.
+ */
+#define MF_I32_OP_LIST \
+    MF_I32_OP(ADD,   ((i32)((u32)va + (u32)vb)), 2) \
+    MF_I32_OP(SUB,   ((i32)((u32)va - (u32)vb)), 2) \
+    MF_I32_OP(MUL,   ((i32)((u32)va * (u32)vb)), 2) \
+    MF_I32_OP(DIV,   (vb == 0 ? 0 : (vb == -1 ? (i32)(0u - (u32)va) : va / vb)), 2) \
+    MF_I32_OP(MIN,   (va < vb ? va : vb), 2) \
+    MF_I32_OP(MAX,   (va > vb ? va : vb), 2) \
+    MF_I32_OP(ABS,   (va < 0 ? (i32)(0u - (u32)va) : va), 1) \
+    MF_I32_OP(STEP,  (vb < va ? 0 : 1), 2) \
+    MF_I32_OP(FMA,   ((i32)((u32)va * (u32)vb + (u32)vc)), 3) \
+    MF_I32_OP(CLAMP, (va < vb ? vb : (va > vc ? vc : va)), 3)
+
+#define MF_I32_OP(_op, _expr, _ar) MF_KERNEL_TYPED(op_##_op##_i32, _expr, _ar, i32, i32, i32, i32, i32, i32)
+MF_I32_OP_LIST
+#undef MF_I32_OP
+
+// Select: condition of any dtype, true/false values (and result) of another
+#define MF_SELECT_KERNEL(TA, TD) \
+    MF_KERNEL_TYPED(op_SELECT_##TA##_##TD, (va ? vb : vc), 3, TD, TA, TD, TD, TA, TD)
+
+#define MF_SELECT_KERNELS(TD) MF_SELECT_KERNEL(f32, TD) MF_SELECT_KERNEL(i32, TD) MF_SELECT_KERNEL(u8, TD)
+MF_SELECT_KERNELS(f32)
+MF_SELECT_KERNELS(i32)
+MF_SELECT_KERNELS(u8)
+
+// Table slot: slot(cond) + 3 * slot(values)
+static const mf_op_func _mf_select_tbl[9] = {
+    op_SELECT_f32_f32, op_SELECT_i32_f32, op_SELECT_u8_f32,
+    op_SELECT_f32_i32, op_SELECT_i32_i32, op_SELECT_u8_i32,
+    op_SELECT_f32_u8,  op_SELECT_i32_u8,  op_SELECT_u8_u8 };
+
+static bool dtypes_all(const mf_dtype* dtypes, int arity, mf_dtype dtype) {
+    for (int k = 0; k <= arity; ++k) if (dtypes[k] != dtype) return false;
+    return true;
+}
+
+mf_op_func mf_ops_math_find_typed(u16 opcode, const mf_dtype* dtypes) {
+    if (opcode == MF_OP_SELECT) {
+        int sc = mf_dtype_slot(dtypes[1]);
+        int sv = mf_dtype_slot(dtypes[0]);
+        if (sc < 0 || sv < 0 || dtypes[2] != dtypes[0] || dtypes[3] != dtypes[0]) return NULL;
+        return _mf_select_tbl[sc + 3 * sv];
+    }
+    switch (opcode) {
+#define MF_I32_OP(_op, _expr, _ar) case MF_OP_##_op: return dtypes_all(dtypes, _ar, MF_DTYPE_I32) ? op_##_op##_i32 : NULL;
+        MF_I32_OP_LIST
+#undef MF_I32_OP
+        default: break;
+    }
+    return NULL;
+}
+
+// --- Reference Kernels ---
+
+void mf_ops_math_fill_reference(mf_op_func* table) {
+#define MF_GEN_AUTO(...)
+#define MF_GEN_SIMD(_op, _ke, _kv, _ar) table[MF_OP_##_op] = op_##_op##_ref;
+#define MF_GEN_MANUAL(...)
+#define MF_OP(_s, _n, _op, _cat, _strat, _in, _out, _tr, _sr, _ar, _p1, _p2, _p3, _p4, _kt, _ke, _kv, _arity) \
+    MF_GEN_##_kt(_op, _ke, _kv, _arity)
+
+    MF_OP_LIST
+
+#undef MF_OP
+#undef MF_GEN_AUTO
+#undef MF_GEN_SIMD
+#undef MF_GEN_MANUAL
+}
+
+// --- Unsanitized Kernels (FAST execution profiles) ---
+
+void mf_ops_math_fill_fast(mf_op_func* table) {
+#define MF_GEN_AUTO(_op, _ke, _kv, _ar) table[MF_OP_##_op] = op_##_op##_fast;
+#define MF_GEN_SIMD(_op, _ke, _kv, _ar) table[MF_OP_##_op] = op_##_op##_fast;
+#define MF_GEN_MANUAL(...)
+#define MF_OP(_s, _n, _op, _cat, _strat, _in, _out, _tr, _sr, _ar, _p1, _p2, _p3, _p4, _kt, _ke, _kv, _arity) \
+    MF_MATH_##_tr(_op, _kt, _ke, _kv, _arity)
+
+    MF_OP_LIST
+
+#undef MF_OP
+#undef MF_GEN_AUTO
+#undef MF_GEN_SIMD
+#undef MF_GEN_MANUAL
+}
+
+void mf_ops_math_fill_emulated(mf_op_func* table, bool fast) {
+#if defined(MF_SIMD_EMULATED_FMA)
+    table[MF_OP_FMA] = fast ? op_FMA_ref_fast : op_FMA_ref;
+#else
+    (void)table; (void)fast;
+#endif
+}
+
+mf_op_func mf_ops_math_specialize(u16 opcode, const i32* strides, bool fast) {
+#if defined(MF_SIMD_EMULATED_FMA)
+    if (opcode == MF_OP_FMA) return NULL;
+#endif
+    switch (opcode) {
+#define MF_GEN_AUTO(...)
+#define MF_GEN_SIMD(_op, _ke, _kv, _ar) case MF_OP_##_op: return _mf_simd_select(fast ? _mf_simd_tbl_fast_##_op : _mf_simd_tbl_##_op, _ar, strides);
+#define MF_GEN_MANUAL(...)
+#define MF_OP(_s, _n, _op, _cat, _strat, _in, _out, _tr, _sr, _ar, _p1, _p2, _p3, _p4, _kt, _ke, _kv, _arity) \
+    MF_GEN_##_kt(_op, _ke, _kv, _arity)
+
+        MF_OP_LIST
+
+#undef MF_OP
+#undef MF_GEN_AUTO
+#undef MF_GEN_SIMD
 #undef MF_GEN_MANUAL
+        default: break;
+    }
+    return NULL;
+}
 
 // --- Vector Math (Custom Kernels) ---
 
@@ -42,7 +174,7 @@ static inline f32 _vec_len_sq_impl(f32* a_ptr, size_t len) {
     return sum;
 }
 
-void op_DOT(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+mf_exec_error op_DOT(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
     const mf_type_info* a_info = &ctx->reg_info[inst->src1_idx];
     size_t vec_len = a_info->shape[a_info->ndim - 1];
     size_t sz = ctx->batch_size;
@@ -61,9 +193,10 @@ void op_DOT(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
         b_ptr += st2;
         d_ptr += st0;
     }
+    return MF_ERROR_NONE;
 }
 
-void op_LENGTH(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+mf_exec_error op_LENGTH(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
     const mf_type_info* a_info = &ctx->reg_info[inst->src1_idx];
     size_t vec_len = a_info->shape[a_info->ndim - 1];
     size_t sz = ctx->batch_size;
@@ -79,9 +212,10 @@ void op_LENGTH(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
         a_ptr += st1;
         d_ptr += st0;
     }
+    return MF_ERROR_NONE;
 }
 
-void op_NORMALIZE(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+mf_exec_error op_NORMALIZE(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
     const mf_type_info* a_info = &ctx->reg_info[inst->src1_idx];
     size_t vec_len = a_info->shape[a_info->ndim - 1];
     size_t sz = ctx->batch_size;
@@ -104,9 +238,10 @@ void op_NORMALIZE(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
         a_ptr += st1;
         d_ptr += st0;
     }
+    return MF_ERROR_NONE;
 }
 
-void op_SMOOTHSTEP(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+mf_exec_error op_SMOOTHSTEP(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
     size_t sz = ctx->batch_size;
     
     u8* d_ptr = (u8*)ctx->reg_ptrs[inst->dest_idx];
@@ -144,28 +279,12 @@ void op_SMOOTHSTEP(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
         x_ptr += st2;
         d_ptr += st0;
     }
+    return MF_ERROR_NONE;
 }
 
-// --- Reduction ---
-
-void op_SUM(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
-    const mf_type_info* src_info = &ctx->reg_info[inst->src1_idx];
-    size_t sz = ctx->batch_size;
-    
-    f32 sum = 0;
-    u8* s_ptr = (u8*)ctx->reg_ptrs[inst->src1_idx];
-    i32 st1 = MF_GET_STRIDE_S1(inst);
-
-    for (size_t i = 0; i < sz; ++i) {
-        sum += *(f32*)s_ptr;
-        s_ptr += st1;
-    }
-    
-    f32* d_ptr = (f32*)ctx->reg_ptrs[inst->dest_idx];
-    *d_ptr = sum;
-}
+// --- Metadata ---
 
-void op_SIZE(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+mf_exec_error op_SIZE(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
     const mf_type_info* src_info = &ctx->reg_info[inst->src1_idx];
     size_t count = 1;
     for (int i = 0; i < src_info->ndim; ++i) {
@@ -174,4 +293,5 @@ void op_SIZE(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
     
     f32* d_ptr = (f32*)ctx->reg_ptrs[inst->dest_idx];
     *d_ptr = (f32)count;
+    return MF_ERROR_NONE;
 }
\ No newline at end of file
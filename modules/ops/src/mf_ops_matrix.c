@@ -5,102 +5,575 @@
 #include "mf_ops_internal.h"
 #include <string.h>
 #include <math.h>
+#include <float.h>
 
-void op_MATMUL(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+// --- MatMul ---
+// The task domain is the output matrix: a job computes the output elements
+// [linear_offset, linear_offset + batch_size), so jobs split the rows of C.
+// Whole row ranges go through the blocked GEMM below, partial rows at the edges
+// of a job and small products through the direct loop. Leading dims are a batch
+// of matrices; runs of small ones go through the batched kernels further down.
+
+#define MF_MM_MR        6                     // Rows of the register tile
+#define MF_MM_NR        (2 * MF_VF32_WIDTH)   // Columns of the register tile
+#define MF_MM_KC        256                   // Depth of a packed panel (MR x KC of A stays in L1)
+#define MF_MM_MC        96                    // Rows of a packed A block (MC x KC in L2), multiple of MR
+#define MF_MM_NC        2048                  // Columns of a packed B panel (KC x NC in L3), multiple of NR
+#define MF_MM_MIN_WORK  32768                 // rows x N x K below which packing does not pay off
+
+// Fused where the target has hardware FMA; the direct loop rounds the same way,
+// and both accumulate over K in order, so the blocked path is bit-exact with it.
+#if defined(MF_SIMD_HAS_FMA)
+    #define MF_MM_MADD(a, b, c)   mf_vf32_fma(a, b, c)
+    #define MF_MM_MADD_S(a, b, c) fmaf(a, b, c)
+#else
+    #define MF_MM_MADD(a, b, c)   mf_vf32_add(mf_vf32_mul(a, b), c)
+    #define MF_MM_MADD_S(a, b, c) ((a) * (b) + (c))
+#endif
+
+typedef struct {
+    const f32* a;
+    const f32* b;
+    f32* c;
+    i32 rs_a, cs_a;     // Element strides
+    i32 rs_b, cs_b;
+    i32 rs_c, cs_c;
+    i32 N, K;
+} mf_mm_args;
+
+static void mm_direct(const mf_mm_args* g, i32 r0, i32 r1, i32 c0, i32 c1) {
+    for (i32 r = r0; r < r1; ++r) {
+        for (i32 c = c0; c < c1; ++c) {
+            const f32* pa = g->a + (ptrdiff_t)r * g->rs_a;
+            const f32* pb = g->b + (ptrdiff_t)c * g->cs_b;
+            f32 sum = 0.0f;
+            for (i32 k = 0; k < g->K; ++k) {
+                sum = MF_MM_MADD_S(*pa, *pb, sum);
+                pa += g->cs_a;
+                pb += g->rs_b;
+            }
+            g->c[(ptrdiff_t)r * g->rs_c + (ptrdiff_t)c * g->cs_c] = sum;
+        }
+    }
+}
+
+// A block as slivers of MR rows, each stored k-major; missing rows are zero
+static void mm_pack_a(f32* dst, const f32* a, i32 rs, i32 cs, i32 rows, i32 kc) {
+    for (i32 i = 0; i < rows; i += MF_MM_MR) {
+        i32 mr = rows - i < MF_MM_MR ? rows - i : MF_MM_MR;
+        for (i32 k = 0; k < kc; ++k) {
+            const f32* src = a + (ptrdiff_t)i * rs + (ptrdiff_t)k * cs;
+            for (i32 r = 0; r < MF_MM_MR; ++r) *dst++ = r < mr ? src[(ptrdiff_t)r * rs] : 0.0f;
+        }
+    }
+}
+
+// B panel as slivers of NR columns, each stored k-major; missing columns are zero
+static void mm_pack_b(f32* dst, const f32* b, i32 rs, i32 cs, i32 kc, i32 cols) {
+    for (i32 j = 0; j < cols; j += MF_MM_NR) {
+        i32 nr = cols - j < MF_MM_NR ? cols - j : MF_MM_NR;
+        for (i32 k = 0; k < kc; ++k) {
+            const f32* src = b + (ptrdiff_t)k * rs + (ptrdiff_t)j * cs;
+            if (nr == MF_MM_NR && cs == 1) {
+                memcpy(dst, src, sizeof(f32) * MF_MM_NR);
+                dst += MF_MM_NR;
+            } else {
+                for (i32 c = 0; c < MF_MM_NR; ++c) *dst++ = c < nr ? src[(ptrdiff_t)c * cs] : 0.0f;
+            }
+        }
+    }
+}
+
+/**
+ * MR x NR tile of C over one packed K run. Each row of the tile is two named vector
+ * accumulators (the row macros below), so the whole tile stays in registers.
+ * With accumulate set the tile continues from the values already in C.
+ */
+#define MF_MM_ROWS(X) X(0) X(1) X(2) X(3) X(4) X(5)
+#define MF_MM_DECL(r) mf_vf32 acc##r##_0, acc##r##_1;
+#define MF_MM_ZERO(r) acc##r##_0 = acc##r##_1 = mf_vf32_set1(0.0f);
+#define MF_MM_LOAD(r) acc##r##_0 = mf_vf32_load(src + r * src_rs); acc##r##_1 = mf_vf32_load(src + r * src_rs + MF_VF32_WIDTH);
+#define MF_MM_STEP(r) { const mf_vf32 a = mf_vf32_set1(pa[r]); acc##r##_0 = MF_MM_MADD(a, b0, acc##r##_0); acc##r##_1 = MF_MM_MADD(a, b1, acc##r##_1); }
+#define MF_MM_STORE(r) mf_vf32_store(dst + r * dst_rs, acc##r##_0); mf_vf32_store(dst + r * dst_rs + MF_VF32_WIDTH, acc##r##_1);
+
+static void mm_micro(i32 kc, const f32* pa, const f32* pb, f32* c, i32 rs_c, i32 cs_c, i32 mr, i32 nr, bool accumulate) {
+    f32 edge[MF_MM_MR * MF_MM_NR];
+    const bool full = (mr == MF_MM_MR && nr == MF_MM_NR && cs_c == 1);
+    MF_MM_ROWS(MF_MM_DECL)
+
+    if (!accumulate) {
+        MF_MM_ROWS(MF_MM_ZERO)
+    } else {
+        // Edge tiles go through a full-size copy
+        const f32* src = c;
+        ptrdiff_t src_rs = rs_c;
+        if (!full) {
+            for (i32 r = 0; r < mr; ++r) for (i32 j = 0; j < nr; ++j) edge[r * MF_MM_NR + j] = c[(ptrdiff_t)r * rs_c + (ptrdiff_t)j * cs_c];
+            src = edge;
+            src_rs = MF_MM_NR;
+        }
+        MF_MM_ROWS(MF_MM_LOAD)
+    }
+
+    for (i32 k = 0; k < kc; ++k) {
+        const mf_vf32 b0 = mf_vf32_load(pb);
+        const mf_vf32 b1 = mf_vf32_load(pb + MF_VF32_WIDTH);
+        MF_MM_ROWS(MF_MM_STEP)
+        pa += MF_MM_MR;
+        pb += MF_MM_NR;
+    }
+
+    f32* dst = full ? c : edge;
+    ptrdiff_t dst_rs = full ? rs_c : MF_MM_NR;
+    MF_MM_ROWS(MF_MM_STORE)
+    if (full) return;
+    for (i32 r = 0; r < mr; ++r) for (i32 j = 0; j < nr; ++j) c[(ptrdiff_t)r * rs_c + (ptrdiff_t)j * cs_c] = edge[r * MF_MM_NR + j];
+}
+
+#undef MF_MM_DECL
+#undef MF_MM_ZERO
+#undef MF_MM_LOAD
+#undef MF_MM_STEP
+#undef MF_MM_STORE
+
+/**
+ * Rows [r0, r1) of C, all columns. B is packed per KC x NC panel and A per MC x KC
+ * block into the job's scratch; returns false if the scratch is unavailable.
+ */
+static bool mm_blocked(mf_exec_ctx* ctx, const mf_mm_args* g, i32 r0, i32 r1) {
+    const i32 N = g->N, K = g->K;
+    i32 kc_max = K < MF_MM_KC ? K : MF_MM_KC;
+    i32 mc_max = r1 - r0 < MF_MM_MC ? r1 - r0 : MF_MM_MC;
+    i32 nc_max = N < MF_MM_NC ? N : MF_MM_NC;
+    mc_max = (mc_max + MF_MM_MR - 1) / MF_MM_MR * MF_MM_MR;
+    nc_max = (nc_max + MF_MM_NR - 1) / MF_MM_NR * MF_MM_NR;
+
+    f32* pack_a = (f32*)mf_exec_ctx_scratch_alloc(ctx, sizeof(f32) * (size_t)mc_max * kc_max);
+    f32* pack_b = (f32*)mf_exec_ctx_scratch_alloc(ctx, sizeof(f32) * (size_t)kc_max * nc_max);
+    if (!pack_a || !pack_b) return false;
+
+    for (i32 jc = 0; jc < N; jc += MF_MM_NC) {
+        i32 nc = N - jc < MF_MM_NC ? N - jc : MF_MM_NC;
+        for (i32 pc = 0; pc < K; pc += MF_MM_KC) {
+            i32 kc = K - pc < MF_MM_KC ? K - pc : MF_MM_KC;
+            mm_pack_b(pack_b, g->b + (ptrdiff_t)pc * g->rs_b + (ptrdiff_t)jc * g->cs_b, g->rs_b, g->cs_b, kc, nc);
+
+            for (i32 ic = r0; ic < r1; ic += MF_MM_MC) {
+                i32 mc = r1 - ic < MF_MM_MC ? r1 - ic : MF_MM_MC;
+                mm_pack_a(pack_a, g->a + (ptrdiff_t)ic * g->rs_a + (ptrdiff_t)pc * g->cs_a, g->rs_a, g->cs_a, mc, kc);
+
+                for (i32 jr = 0; jr < nc; jr += MF_MM_NR) {
+                    i32 nr = nc - jr < MF_MM_NR ? nc - jr : MF_MM_NR;
+                    for (i32 ir = 0; ir < mc; ir += MF_MM_MR) {
+                        i32 mr = mc - ir < MF_MM_MR ? mc - ir : MF_MM_MR;
+                        f32* c = g->c + (ptrdiff_t)(ic + ir) * g->rs_c + (ptrdiff_t)(jc + jr) * g->cs_c;
+                        mm_micro(kc, pack_a + (size_t)ir * kc, pack_b + (size_t)jr * kc, c, g->rs_c, g->cs_c, mr, nr, pc > 0);
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Batched small products: one product per entity, MF_VF32_WIDTH entities at a time
+ * with one entity per SIMD lane. Operand elements are gathered across entities by
+ * their entity stride; an operand shared by all entities (stride 0) is broadcast.
+ * Each lane accumulates over K in order like mm_direct, so results match it bit for bit.
+ */
+typedef struct {
+    mf_mm_args g;       // First entity
+    i32 sa, sb, sc;     // Entity strides in elements, 0 = shared
+} mf_mm_batch;
+
+typedef void (*mf_mm_batched_func)(const mf_mm_batch* bt, size_t count);
+
+MF_FORCE_INLINE mf_vf32 mm_lanes(const f32* p, i32 stride) {
+    return stride ? mf_vf32_load_strided((const u8*)p, stride * (i32)sizeof(f32)) : mf_vf32_set1(*p);
+}
+
+MF_FORCE_INLINE void mm_batched(const mf_mm_batch* bt, size_t count, const i32 M, const i32 K, const i32 N) {
+    const mf_mm_args* g = &bt->g;
+    size_t e = 0;
+    for (; e + MF_VF32_WIDTH <= count; e += MF_VF32_WIDTH) {
+        const f32* a = g->a + (ptrdiff_t)e * bt->sa;
+        const f32* b = g->b + (ptrdiff_t)e * bt->sb;
+        f32* c = g->c + (ptrdiff_t)e * bt->sc;
+        mf_vf32 va[16], vb[16];
+        for (i32 r = 0; r < M; ++r) for (i32 k = 0; k < K; ++k) va[r * K + k] = mm_lanes(a + r * g->rs_a + k * g->cs_a, bt->sa);
+        for (i32 k = 0; k < K; ++k) for (i32 n = 0; n < N; ++n) vb[k * N + n] = mm_lanes(b + k * g->rs_b + n * g->cs_b, bt->sb);
+        for (i32 r = 0; r < M; ++r) {
+            for (i32 n = 0; n < N; ++n) {
+                mf_vf32 acc = mf_vf32_set1(0.0f);
+                for (i32 k = 0; k < K; ++k) acc = MF_MM_MADD(va[r * K + k], vb[k * N + n], acc);
+                mf_vf32_store_strided((u8*)(c + r * g->rs_c + n * g->cs_c), bt->sc * (i32)sizeof(f32), acc);
+            }
+        }
+    }
+    mf_mm_args t = *g;
+    for (; e < count; ++e) {
+        t.a = g->a + (ptrdiff_t)e * bt->sa;
+        t.b = g->b + (ptrdiff_t)e * bt->sb;
+        t.c = g->c + (ptrdiff_t)e * bt->sc;
+        mm_direct(&t, 0, M, 0, N);
+    }
+}
+
+#define MF_MM_BATCHED(M, K, N) \
+    static void mm_batched_##M##x##K##x##N(const mf_mm_batch* bt, size_t count) { mm_batched(bt, count, M, K, N); }
+
+// Square products, mat-vec (column vectors) and row vectors times a matrix
+MF_MM_BATCHED(2, 2, 2) MF_MM_BATCHED(3, 3, 3) MF_MM_BATCHED(4, 4, 4)
+MF_MM_BATCHED(2, 2, 1) MF_MM_BATCHED(3, 3, 1) MF_MM_BATCHED(4, 4, 1)
+MF_MM_BATCHED(1, 2, 2) MF_MM_BATCHED(1, 3, 3) MF_MM_BATCHED(1, 4, 4)
+
+#undef MF_MM_BATCHED
+
+static const struct { i32 M, K, N; mf_mm_batched_func fn; } MM_BATCHED[] = {
+    { 2, 2, 2, mm_batched_2x2x2 }, { 3, 3, 3, mm_batched_3x3x3 }, { 4, 4, 4, mm_batched_4x4x4 },
+    { 2, 2, 1, mm_batched_2x2x1 }, { 3, 3, 1, mm_batched_3x3x1 }, { 4, 4, 1, mm_batched_4x4x1 },
+    { 1, 2, 2, mm_batched_1x2x2 }, { 1, 3, 3, mm_batched_1x3x3 }, { 1, 4, 4, mm_batched_1x4x4 },
+};
+
+static mf_mm_batched_func mm_batched_find(i32 M, i32 K, i32 N) {
+    for (size_t i = 0; i < sizeof(MM_BATCHED) / sizeof(MM_BATCHED[0]); ++i) {
+        if (MM_BATCHED[i].M == M && MM_BATCHED[i].K == K && MM_BATCHED[i].N == N) return MM_BATCHED[i].fn;
+    }
+    return NULL;
+}
+
+// Output elements [begin, end) of one matrix: partial rows directly, whole rows blocked
+static void mm_range(mf_exec_ctx* ctx, const mf_mm_args* g, size_t begin, size_t end, bool blocked) {
+    const size_t N = (size_t)g->N;
+    size_t i = begin;
+    if (i % N) {
+        size_t stop = (i / N + 1) * N < end ? (i / N + 1) * N : end;
+        mm_direct(g, (i32)(i / N), (i32)(i / N) + 1, (i32)(i % N), (i32)(stop - i / N * N));
+        i = stop;
+    }
+    i32 r0 = (i32)(i / N), r1 = (i32)(end / N);
+    if (r1 > r0) {
+        // Rows times a small matrix (points through a transform): each row is an entity
+        mf_mm_batched_func rows = blocked ? mm_batched_find(1, g->K, g->N) : NULL;
+        bool small = (size_t)(r1 - r0) * N * (size_t)g->K < MF_MM_MIN_WORK;
+        if (rows) {
+            mf_mm_batch bt = { *g, g->rs_a, 0, g->rs_c };
+            bt.g.a = g->a + (ptrdiff_t)r0 * g->rs_a;
+            bt.g.c = g->c + (ptrdiff_t)r0 * g->rs_c;
+            rows(&bt, (size_t)(r1 - r0));
+        } else if (!blocked || small || !mm_blocked(ctx, g, r0, r1)) {
+            mm_direct(g, r0, r1, 0, g->N);
+        }
+        i = (size_t)r1 * N;
+    }
+    if (i < end) mm_direct(g, r1, r1 + 1, 0, (i32)(end - i));
+}
+
+static mf_exec_error mm_run(mf_exec_ctx* ctx, const struct mf_instruction* inst, bool blocked) {
     const mf_type_info* a_info = &ctx->reg_info[inst->src1_idx];
     const mf_type_info* b_info = &ctx->reg_info[inst->src2_idx];
-    const mf_type_info* dst_info = &ctx->reg_info[inst->dest_idx];
+    const mf_type_info* c_info = &ctx->reg_info[inst->dest_idx];
 
     const int32_t M = a_info->shape[a_info->ndim - 2];
     const int32_t K = a_info->shape[a_info->ndim - 1];
     const int32_t N = b_info->shape[b_info->ndim - 1];
+    if (M <= 0 || N <= 0 || ctx->batch_size == 0) return MF_ERROR_NONE;
 
-    u8* base_a = (u8*)ctx->reg_ptrs[inst->src1_idx];
-    u8* base_b = (u8*)ctx->reg_ptrs[inst->src2_idx];
-    u8* base_c = (u8*)ctx->reg_ptrs[inst->dest_idx];
-
-    const i32 st_batch_a = MF_GET_STRIDE_S1(inst);
-    const i32 st_batch_b = MF_GET_STRIDE_S2(inst);
-    const i32 st_batch_c = MF_GET_STRIDE_D(inst);
-
-    const int32_t stride_ra = a_info->strides[a_info->ndim - 2];
-    const int32_t stride_ka = a_info->strides[a_info->ndim - 1];
-    const int32_t stride_kb = b_info->strides[b_info->ndim - 2];
-    const int32_t stride_cb = b_info->strides[b_info->ndim - 1];
-    const int32_t stride_rc = dst_info->strides[dst_info->ndim - 2];
-    const int32_t stride_cc = dst_info->strides[dst_info->ndim - 1];
-
-    const size_t batch_size = ctx->batch_size;
-
-    for (size_t b = 0; b < batch_size; ++b) {
-        f32* curr_a = (f32*)(base_a + b * st_batch_a);
-        f32* curr_b = (f32*)(base_b + b * st_batch_b);
-        f32* curr_c = (f32*)(base_c + b * st_batch_c);
-
-        for (int32_t r = 0; r < M; r++) {
-            for (int32_t c = 0; c < N; c++) { 
-                float sum = 0.0f; 
-                f32* pa = curr_a + r * stride_ra;
-                f32* pb = curr_b + c * stride_cb;
-                for (int32_t k = 0; k < K; k++) {
-                    sum += (*pa) * (*pb);
-                    pa += stride_ka;
-                    pb += stride_kb;
-                }
-                curr_c[r * stride_rc + c * stride_cc] = sum; 
-            }
+    MF_CHECK_PTR(ctx, ctx->reg_ptrs[inst->src1_idx]);
+    MF_CHECK_PTR(ctx, ctx->reg_ptrs[inst->src2_idx]);
+    MF_CHECK_PTR(ctx, ctx->reg_ptrs[inst->dest_idx]);
+
+    // Operands are read whole: step back from this job's offset to the start of each register
+    const ptrdiff_t offset = (ptrdiff_t)ctx->linear_offset;
+    const f32* base_a = (const f32*)((u8*)ctx->reg_ptrs[inst->src1_idx] - offset * MF_GET_STRIDE_S1(inst));
+    const f32* base_b = (const f32*)((u8*)ctx->reg_ptrs[inst->src2_idx] - offset * MF_GET_STRIDE_S2(inst));
+    f32* base_c = (f32*)((u8*)ctx->reg_ptrs[inst->dest_idx] - offset * MF_GET_STRIDE_D(inst));
+
+    // Leading dims of C are a batch of matrices; an operand without them is shared
+    const ptrdiff_t bs_a = (a_info->ndim > 2) ? a_info->strides[a_info->ndim - 3] : 0;
+    const ptrdiff_t bs_b = (b_info->ndim > 2) ? b_info->strides[b_info->ndim - 3] : 0;
+    const ptrdiff_t bs_c = (c_info->ndim > 2) ? c_info->strides[c_info->ndim - 3] : 0;
+
+    mf_mm_args g = {
+        .rs_a = a_info->strides[a_info->ndim - 2], .cs_a = a_info->strides[a_info->ndim - 1],
+        .rs_b = b_info->strides[b_info->ndim - 2], .cs_b = b_info->strides[b_info->ndim - 1],
+        .rs_c = c_info->strides[c_info->ndim - 2], .cs_c = c_info->strides[c_info->ndim - 1],
+        .N = N, .K = K
+    };
+
+    // Runs of whole small matrices go across the batch, one matrix per lane
+    mf_mm_batched_func batched = (blocked && c_info->ndim > 2) ? mm_batched_find(M, K, N) : NULL;
+
+    const size_t plane = (size_t)M * N;
+    size_t i = ctx->linear_offset;
+    const size_t end = i + ctx->batch_size;
+    while (i < end) {
+        size_t batch = i / plane;
+        if (batched && i % plane == 0 && end - i >= plane) {
+            size_t count = (end - i) / plane;
+            mf_mm_batch bt = { g, (i32)bs_a, (i32)bs_b, (i32)bs_c };
+            bt.g.a = base_a + (ptrdiff_t)batch * bs_a;
+            bt.g.b = base_b + (ptrdiff_t)batch * bs_b;
+            bt.g.c = base_c + (ptrdiff_t)batch * bs_c;
+            batched(&bt, count);
+            i += count * plane;
+            continue;
         }
+        size_t stop = (batch + 1) * plane < end ? (batch + 1) * plane : end;
+        g.a = base_a + (ptrdiff_t)batch * bs_a;
+        g.b = base_b + (ptrdiff_t)batch * bs_b;
+        g.c = base_c + (ptrdiff_t)batch * bs_c;
+        mm_range(ctx, &g, i - batch * plane, stop - batch * plane, blocked);
+        i = stop;
     }
+    return MF_ERROR_NONE;
+}
+
+mf_exec_error op_MATMUL(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+    return mm_run(ctx, inst, true);
 }
 
-void op_TRANSPOSE(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+// Direct loop only: reference for the blocked path (mf-bench gemm)
+static mf_exec_error op_MATMUL_ref(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+    return mm_run(ctx, inst, false);
+}
+
+
+mf_exec_error op_TRANSPOSE(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
     (void)ctx; (void)inst;
+    return MF_ERROR_NONE;
 }
 
-void op_INVERSE(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
-    const mf_type_info* a_info = &ctx->reg_info[inst->src1_idx];
-    size_t sz_a = 1;
-    for(int i=0; i<a_info->ndim; ++i) sz_a *= a_info->shape[i];
+// --- Inverse ---
+// Like MatMul, the domain is the output: leading dims are a batch of D x D matrices
+// (D = 2, 3, 4) and a job inverts the matrices covering its element range. Singular
+// matrices come out as identity, with the thresholds of mf_mat3_inverse/mf_mat4_inverse.
 
-    int dim = (int)sqrtf((float)sz_a);
-    f32* da = (f32*)ctx->reg_ptrs[inst->src1_idx];
-    f32* dd = (f32*)ctx->reg_ptrs[inst->dest_idx];
+typedef struct {
+    const f32* a;
+    f32* c;
+    i32 sa, sc;         // Entity strides in elements
+    i32 rs_a, cs_a;
+    i32 rs_c, cs_c;
+} mf_inv_batch;
 
-    if ((dim == 3 && sz_a == 9) || (dim == 4 && sz_a == 16)) {
-        int32_t s0 = a_info->strides[0];
-        int32_t s1 = a_info->strides[1];
+typedef void (*mf_inv_batched_func)(const mf_inv_batch* bt, size_t count);
 
-        if (dim == 3) {
-            mf_mat3 m;
-            for(int r=0; r<3; ++r) for(int c=0; c<3; ++c) {
-                m.m[r * 3 + c] = da[r * s0 + c * s1];
-            }
-            mf_mat3 res = mf_mat3_inverse(m);
-            memcpy(dd, res.m, sizeof(mf_mat3));
+MF_FORCE_INLINE mf_vf32 inv_det2(mf_vf32 a, mf_vf32 b, mf_vf32 c, mf_vf32 d) {
+    return mf_vf32_sub(mf_vf32_mul(a, b), mf_vf32_mul(c, d));
+}
+
+MF_FORCE_INLINE mf_vf32 inv_cof3(mf_vf32 a, mf_vf32 p, mf_vf32 b, mf_vf32 q, mf_vf32 c, mf_vf32 r) {
+    return mf_vf32_add(mf_vf32_sub(mf_vf32_mul(a, p), mf_vf32_mul(b, q)), mf_vf32_mul(c, r));
+}
+
+// Adjugate in r scaled by 1/det; identity in lanes where |det| < eps
+MF_FORCE_INLINE void inv_finish(mf_vf32* r, const i32 D, mf_vf32 det, f32 eps) {
+    const mf_vf32 one = mf_vf32_set1(1.0f);
+    const mf_vf32 ok = mf_vf32_step(mf_vf32_set1(eps), mf_vf32_abs(det));
+    const mf_vf32 singular = mf_vf32_sub(one, ok);
+    const mf_vf32 scale = mf_vf32_mul(mf_vf32_div(one, mf_vf32_add(det, singular)), ok);
+    for (i32 i = 0; i < D * D; ++i) r[i] = mf_vf32_mul(r[i], scale);
+    for (i32 i = 0; i < D; ++i) r[i * D + i] = mf_vf32_add(r[i * D + i], singular);
+}
+
+// Same cofactor order as mf_mat3_inverse
+MF_FORCE_INLINE void inv_lanes_3(const mf_vf32* m, mf_vf32* r) {
+    r[0] = inv_det2(m[4], m[8], m[5], m[7]);
+    r[1] = inv_det2(m[2], m[7], m[1], m[8]);
+    r[2] = inv_det2(m[1], m[5], m[2], m[4]);
+    r[3] = inv_det2(m[5], m[6], m[3], m[8]);
+    r[4] = inv_det2(m[0], m[8], m[2], m[6]);
+    r[5] = inv_det2(m[2], m[3], m[0], m[5]);
+    r[6] = inv_det2(m[3], m[7], m[4], m[6]);
+    r[7] = inv_det2(m[1], m[6], m[0], m[7]);
+    r[8] = inv_det2(m[0], m[4], m[1], m[3]);
+    mf_vf32 det = mf_vf32_add(mf_vf32_sub(mf_vf32_mul(m[0], r[0]), mf_vf32_mul(m[3], inv_det2(m[1], m[8], m[2], m[7]))), mf_vf32_mul(m[6], r[2]));
+    inv_finish(r, 3, det, 1e-6f);
+}
+
+// Laplace expansion over 2x2 minors of the top (s) and bottom (c) row pairs
+MF_FORCE_INLINE void inv_lanes_4(const mf_vf32* m, mf_vf32* r) {
+    const mf_vf32 s0 = inv_det2(m[0], m[5], m[4], m[1]), c5 = inv_det2(m[10], m[15], m[14], m[11]);
+    const mf_vf32 s1 = inv_det2(m[0], m[6], m[4], m[2]), c4 = inv_det2(m[9], m[15], m[13], m[11]);
+    const mf_vf32 s2 = inv_det2(m[0], m[7], m[4], m[3]), c3 = inv_det2(m[9], m[14], m[13], m[10]);
+    const mf_vf32 s3 = inv_det2(m[1], m[6], m[5], m[2]), c2 = inv_det2(m[8], m[15], m[12], m[11]);
+    const mf_vf32 s4 = inv_det2(m[1], m[7], m[5], m[3]), c1 = inv_det2(m[8], m[14], m[12], m[10]);
+    const mf_vf32 s5 = inv_det2(m[2], m[7], m[6], m[3]), c0 = inv_det2(m[8], m[13], m[12], m[9]);
+    const mf_vf32 zero = mf_vf32_set1(0.0f);
+
+    r[0]  = inv_cof3(m[5], c5, m[6], c4, m[7], c3);
+    r[1]  = mf_vf32_sub(zero, inv_cof3(m[1], c5, m[2], c4, m[3], c3));
+    r[2]  = inv_cof3(m[13], s5, m[14], s4, m[15], s3);
+    r[3]  = mf_vf32_sub(zero, inv_cof3(m[9], s5, m[10], s4, m[11], s3));
+    r[4]  = mf_vf32_sub(zero, inv_cof3(m[4], c5, m[6], c2, m[7], c1));
+    r[5]  = inv_cof3(m[0], c5, m[2], c2, m[3], c1);
+    r[6]  = mf_vf32_sub(zero, inv_cof3(m[12], s5, m[14], s2, m[15], s1));
+    r[7]  = inv_cof3(m[8], s5, m[10], s2, m[11], s1);
+    r[8]  = inv_cof3(m[4], c4, m[5], c2, m[7], c0);
+    r[9]  = mf_vf32_sub(zero, inv_cof3(m[0], c4, m[1], c2, m[3], c0));
+    r[10] = inv_cof3(m[12], s4, m[13], s2, m[15], s0);
+    r[11] = mf_vf32_sub(zero, inv_cof3(m[8], s4, m[9], s2, m[11], s0));
+    r[12] = mf_vf32_sub(zero, inv_cof3(m[4], c3, m[5], c1, m[6], c0));
+    r[13] = inv_cof3(m[0], c3, m[1], c1, m[2], c0);
+    r[14] = mf_vf32_sub(zero, inv_cof3(m[12], s3, m[13], s1, m[14], s0));
+    r[15] = inv_cof3(m[8], s3, m[9], s1, m[10], s0);
+
+    mf_vf32 det = mf_vf32_add(mf_vf32_sub(mf_vf32_add(mf_vf32_add(mf_vf32_sub(
+        mf_vf32_mul(s0, c5), mf_vf32_mul(s1, c4)), mf_vf32_mul(s2, c3)), mf_vf32_mul(s3, c2)), mf_vf32_mul(s4, c1)), mf_vf32_mul(s5, c0));
+    inv_finish(r, 4, det, FLT_MIN);
+}
+
+MF_FORCE_INLINE void inv_block(const f32* a, i32 sa, i32 rs_a, i32 cs_a, f32* c, i32 sc, i32 rs_c, i32 cs_c, const i32 D) {
+    mf_vf32 m[16], r[16];
+    for (i32 i = 0; i < D; ++i) for (i32 j = 0; j < D; ++j) m[i * D + j] = mf_vf32_load_strided((const u8*)(a + i * rs_a + j * cs_a), sa * (i32)sizeof(f32));
+    if (D == 3) inv_lanes_3(m, r);
+    else inv_lanes_4(m, r);
+    for (i32 i = 0; i < D; ++i) for (i32 j = 0; j < D; ++j) mf_vf32_store_strided((u8*)(c + i * rs_c + j * cs_c), sc * (i32)sizeof(f32), r[i * D + j]);
+}
+
+// Whole lane groups in place; the remainder through a padded copy so every matrix takes the same path
+MF_FORCE_INLINE void inv_batched(const mf_inv_batch* bt, size_t count, const i32 D) {
+    size_t e = 0;
+    for (; e + MF_VF32_WIDTH <= count; e += MF_VF32_WIDTH) {
+        inv_block(bt->a + (ptrdiff_t)e * bt->sa, bt->sa, bt->rs_a, bt->cs_a,
+                  bt->c + (ptrdiff_t)e * bt->sc, bt->sc, bt->rs_c, bt->cs_c, D);
+    }
+    if (e == count) return;
+
+    f32 in[MF_VF32_WIDTH * 16] = {0};
+    f32 out[MF_VF32_WIDTH * 16];
+    size_t rest = count - e;
+    for (size_t l = 0; l < rest; ++l) {
+        const f32* a = bt->a + (ptrdiff_t)(e + l) * bt->sa;
+        for (i32 i = 0; i < D; ++i) for (i32 j = 0; j < D; ++j) in[l * D * D + i * D + j] = a[i * bt->rs_a + j * bt->cs_a];
+    }
+    inv_block(in, D * D, D, 1, out, D * D, D, 1, D);
+    for (size_t l = 0; l < rest; ++l) {
+        f32* c = bt->c + (ptrdiff_t)(e + l) * bt->sc;
+        for (i32 i = 0; i < D; ++i) for (i32 j = 0; j < D; ++j) c[i * bt->rs_c + j * bt->cs_c] = out[l * D * D + i * D + j];
+    }
+}
+
+static void inv_batched_3(const mf_inv_batch* bt, size_t count) { inv_batched(bt, count, 3); }
+static void inv_batched_4(const mf_inv_batch* bt, size_t count) { inv_batched(bt, count, 4); }
+
+// Per matrix through mf_math.h
+static void inv_scalar(const mf_inv_batch* bt, size_t count, i32 D) {
+    for (size_t e = 0; e < count; ++e) {
+        const f32* a = bt->a + (ptrdiff_t)e * bt->sa;
+        f32* c = bt->c + (ptrdiff_t)e * bt->sc;
+        f32 m[16], r[16];
+        for (i32 i = 0; i < D; ++i) for (i32 j = 0; j < D; ++j) m[i * D + j] = a[i * bt->rs_a + j * bt->cs_a];
+        if (D == 2) {
+            f32 det = m[0] * m[3] - m[1] * m[2];
+            if (fabsf(det) < FLT_MIN) { r[0] = 1.0f; r[1] = 0.0f; r[2] = 0.0f; r[3] = 1.0f; }
+            else { f32 inv = 1.0f / det; r[0] = m[3] * inv; r[1] = -m[1] * inv; r[2] = -m[2] * inv; r[3] = m[0] * inv; }
+        } else if (D == 3) {
+            mf_mat3 mat; memcpy(mat.m, m, sizeof(mat.m));
+            mf_mat3 res = mf_mat3_inverse(mat);
+            memcpy(r, res.m, sizeof(res.m));
         } else {
-            mf_mat4 m;
-            for(int r=0; r<4; ++r) for(int c=0; c<4; ++c) {
-                m.m[r * 4 + c] = da[r * s0 + c * s1];
-            }
-            mf_mat4 res = mf_mat4_inverse(m);
-            memcpy(dd, res.m, sizeof(mf_mat4));
+            mf_mat4 mat; memcpy(mat.m, m, sizeof(mat.m));
+            mf_mat4 res = mf_mat4_inverse(mat);
+            memcpy(r, res.m, sizeof(res.m));
         }
+        for (i32 i = 0; i < D; ++i) for (i32 j = 0; j < D; ++j) c[i * bt->rs_c + j * bt->cs_c] = r[i * D + j];
     }
-    else {
-        size_t count = sz_a;
-        for(size_t i=0; i<count; ++i) {
-            size_t offset = 0;
-            size_t temp_idx = i;
-            for (int d = a_info->ndim - 1; d >= 0; --d) {
-                offset += (temp_idx % a_info->shape[d]) * a_info->strides[d];
-                temp_idx /= a_info->shape[d];
-            }
-            dd[i] = da[offset];
+}
+
+static void inv_scalar_2(const mf_inv_batch* bt, size_t count) { inv_scalar(bt, count, 2); }
+static void inv_scalar_3(const mf_inv_batch* bt, size_t count) { inv_scalar(bt, count, 3); }
+static void inv_scalar_4(const mf_inv_batch* bt, size_t count) { inv_scalar(bt, count, 4); }
+
+static mf_exec_error inv_run(mf_exec_ctx* ctx, const struct mf_instruction* inst, bool batched) {
+    const mf_type_info* a_info = &ctx->reg_info[inst->src1_idx];
+    const mf_type_info* c_info = &ctx->reg_info[inst->dest_idx];
+    if (ctx->batch_size == 0) return MF_ERROR_NONE;
+
+    MF_CHECK_PTR(ctx, ctx->reg_ptrs[inst->src1_idx]);
+    MF_CHECK_PTR(ctx, ctx->reg_ptrs[inst->dest_idx]);
+
+    // A flat [4], [9] or [16] is one row-major matrix
+    i32 D = 0;
+    if (a_info->ndim >= 2 && a_info->shape[a_info->ndim - 1] == a_info->shape[a_info->ndim - 2]) D = a_info->shape[a_info->ndim - 1];
+    else if (a_info->ndim == 1) D = (a_info->shape[0] == 4) ? 2 : (a_info->shape[0] == 9) ? 3 : (a_info->shape[0] == 16) ? 4 : 0;
+
+    if (D < 2 || D > 4) {
+        // Unsupported size: pass the input through
+        u8* da = (u8*)ctx->reg_ptrs[inst->src1_idx];
+        u8* dd = (u8*)ctx->reg_ptrs[inst->dest_idx];
+        for (u32 i = 0; i < ctx->batch_size; ++i) {
+            *(f32*)dd = *(f32*)da;
+            da += MF_GET_STRIDE_S1(inst);
+            dd += MF_GET_STRIDE_D(inst);
+        }
+        return MF_ERROR_NONE;
+    }
+
+    // A 2x2 inverse is too little work to pay for the lane transposes: it stays per matrix
+    static const mf_inv_batched_func batched_fn[5] = { NULL, NULL, inv_scalar_2, inv_batched_3, inv_batched_4 };
+    static const mf_inv_batched_func scalar_fn[5] = { NULL, NULL, inv_scalar_2, inv_scalar_3, inv_scalar_4 };
+    const mf_inv_batched_func fn = batched ? batched_fn[D] : scalar_fn[D];
+
+    const ptrdiff_t offset = (ptrdiff_t)ctx->linear_offset;
+    const f32* base_a = (const f32*)((u8*)ctx->reg_ptrs[inst->src1_idx] - offset * MF_GET_STRIDE_S1(inst));
+    f32* base_c = (f32*)((u8*)ctx->reg_ptrs[inst->dest_idx] - offset * MF_GET_STRIDE_D(inst));
+
+    const size_t plane = (size_t)D * D;
+    const i32 an = a_info->ndim, cn = c_info->ndim;
+    mf_inv_batch bt = {
+        .a = base_a, .c = base_c,
+        .sa = (an > 2) ? a_info->strides[an - 3] : (i32)plane,
+        .sc = (cn > 2) ? c_info->strides[cn - 3] : (i32)plane,
+        .rs_a = (an >= 2) ? a_info->strides[an - 2] : D * a_info->strides[0],
+        .cs_a = a_info->strides[an - 1],
+        .rs_c = (cn >= 2) ? c_info->strides[cn - 2] : D * c_info->strides[0],
+        .cs_c = c_info->strides[cn - 1],
+    };
+
+    size_t i = ctx->linear_offset;
+    const size_t end = i + ctx->batch_size;
+    while (i < end) {
+        size_t e = i / plane;
+        if (i % plane == 0 && end - i >= plane) {
+            size_t count = (end - i) / plane;
+            mf_inv_batch run = bt;
+            run.a = bt.a + (ptrdiff_t)e * bt.sa;
+            run.c = bt.c + (ptrdiff_t)e * bt.sc;
+            fn(&run, count);
+            i += count * plane;
+            continue;
+        }
+        // Part of a matrix at a job edge: invert it whole, keep this job's elements
+        f32 tmp[16];
+        mf_inv_batch one = { bt.a + (ptrdiff_t)e * bt.sa, tmp, (i32)plane, (i32)plane, bt.rs_a, bt.cs_a, D, 1 };
+        fn(&one, 1);
+        size_t stop = (e + 1) * plane < end ? (e + 1) * plane : end;
+        for (; i < stop; ++i) {
+            size_t k = i - e * plane;
+            bt.c[(ptrdiff_t)e * bt.sc + (ptrdiff_t)(k / D) * bt.rs_c + (ptrdiff_t)(k % D) * bt.cs_c] = tmp[k];
         }
     }
+    return MF_ERROR_NONE;
+}
+
+mf_exec_error op_INVERSE(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+    return inv_run(ctx, inst, true);
+}
+
+// One matrix at a time through mf_math.h: reference for the batched path (mf-bench batched)
+static mf_exec_error op_INVERSE_ref(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+    return inv_run(ctx, inst, false);
+}
+
+void mf_ops_matrix_fill_reference(mf_op_func* table) {
+    table[MF_OP_MATMUL] = op_MATMUL_ref;
+    table[MF_OP_INVERSE] = op_INVERSE_ref;
 }
 
-void op_JOIN(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+mf_exec_error op_JOIN(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
     const mf_type_info* dst_info = &ctx->reg_info[inst->dest_idx];
     int components = dst_info->shape[dst_info->ndim - 1];
     
@@ -130,4 +603,5 @@ void op_JOIN(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
         if (d_in_ptr) d_in_ptr += st4;
         d_ptr += st0;
     }
+    return MF_ERROR_NONE;
 }
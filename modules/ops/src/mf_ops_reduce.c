@@ -0,0 +1,494 @@
+#include "mf_ops_internal.h"
+#include "mf_kernel_utils.h"
+#include <mathflow/isa/mf_opcodes.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * MathFlow Reduction Kernels
+ * The dest register of a reduction is the running thread's accumulator (mf_reduce_acc),
+ * not the output tensor: each job folds its elements into it and the backend merges the
+ * threads' partials. NaN elements are skipped by Min/Max/ArgMin/ArgMax; ties of
+ * ArgMin/ArgMax go to the lowest flat index, whatever order the jobs ran in.
+ */
+
+#define MF_REDUCE_UNROLL         4     // Independent vector accumulators (hides the add latency)
+#define MF_REDUCE_BLOCK          1024  // Elements summed in f32 lanes before the partial moves to f64
+#define MF_REDUCE_PAIRWISE_BLOCK 128   // Elements summed in f32 lanes at the leaves of the pairwise tree
+#define MF_REDUCE_AXIS_ROWS      32    // Rows an axis sum folds in f32 before its partials move to f64
+#define MF_REDUCE_AXIS_TILE      256   // Outputs per set of f64 partials (on the stack)
+
+// Non-f32 sources are integers; i32 is the only one the op DB admits, u8 is read defensively
+static inline i64 reduce_load_int(const u8* p, mf_dtype dtype) {
+    return dtype == MF_DTYPE_U8 ? (i64)*p : (i64)*(const i32*)p;
+}
+
+// --- Sum ---
+
+static f64 sum_lanes_f32(const f32* p, size_t n) {
+    mf_vf32 acc[MF_REDUCE_UNROLL];
+    for (int k = 0; k < MF_REDUCE_UNROLL; ++k) acc[k] = mf_vf32_set1(0.0f);
+    size_t i = 0;
+    for (; i + MF_REDUCE_UNROLL * MF_VF32_WIDTH <= n; i += MF_REDUCE_UNROLL * MF_VF32_WIDTH) {
+        for (int k = 0; k < MF_REDUCE_UNROLL; ++k) acc[k] = mf_vf32_add(acc[k], mf_vf32_load(p + i + k * MF_VF32_WIDTH));
+    }
+    f32 lanes[MF_VF32_WIDTH];
+    mf_vf32_store(lanes, mf_vf32_add(mf_vf32_add(acc[0], acc[1]), mf_vf32_add(acc[2], acc[3])));
+    f64 sum = 0.0;
+    for (int k = 0; k < MF_VF32_WIDTH; ++k) sum += lanes[k];
+    for (; i < n; ++i) sum += p[i];
+    return sum;
+}
+
+// Lanes only ever add a block's worth of elements in f32: the error stays bounded by the block
+static f64 sum_blocked_f32(const f32* p, size_t n) {
+    f64 sum = 0.0;
+    for (size_t i = 0; i < n; i += MF_REDUCE_BLOCK) sum += sum_lanes_f32(p + i, n - i < MF_REDUCE_BLOCK ? n - i : MF_REDUCE_BLOCK);
+    return sum;
+}
+
+static f64 sum_pairwise_f32(const f32* p, size_t n) {
+    if (n <= MF_REDUCE_PAIRWISE_BLOCK) return sum_lanes_f32(p, n);
+    // Halves stay whole vector blocks so the leaves keep their full lanes
+    size_t half = (n / 2) & ~(size_t)(MF_VF32_WIDTH - 1);
+    return sum_pairwise_f32(p, half) + sum_pairwise_f32(p + half, n - half);
+}
+
+static f64 sum_strided_f32(const u8* p, i32 st, size_t n) {
+    f64 sum = 0.0;
+    for (size_t i = 0; i < n; ++i, p += st) sum += *(const f32*)p;
+    return sum;
+}
+
+static mf_exec_error reduce_sum(mf_exec_ctx* ctx, const struct mf_instruction* inst, bool pairwise) {
+    mf_reduce_acc* acc = (mf_reduce_acc*)ctx->reg_ptrs[inst->dest_idx];
+    const u8* s_ptr = (const u8*)ctx->reg_ptrs[inst->src1_idx];
+    MF_CHECK_PTR(ctx, acc);
+    MF_CHECK_PTR(ctx, s_ptr);
+    const mf_dtype dtype = ctx->reg_info[inst->src1_idx].dtype;
+    const i32 st1 = MF_GET_STRIDE_S1(inst);
+    const size_t sz = ctx->batch_size;
+
+    if (dtype == MF_DTYPE_F32) {
+        if (st1 != (i32)sizeof(f32)) acc->value.f += sum_strided_f32(s_ptr, st1, sz);
+        else acc->value.f += pairwise ? sum_pairwise_f32((const f32*)s_ptr, sz) : sum_blocked_f32((const f32*)s_ptr, sz);
+    } else {
+        i64 sum = 0;
+        for (size_t i = 0; i < sz; ++i, s_ptr += st1) sum += reduce_load_int(s_ptr, dtype);
+        acc->value.i += sum;
+    }
+    acc->count += (i64)sz;
+    return MF_ERROR_NONE;
+}
+
+mf_exec_error op_SUM(mf_exec_ctx* ctx, const struct mf_instruction* inst) { return reduce_sum(ctx, inst, false); }
+mf_exec_error op_REDUCE_MEAN(mf_exec_ctx* ctx, const struct mf_instruction* inst) { return reduce_sum(ctx, inst, false); }
+
+static mf_exec_error op_SUM_pairwise(mf_exec_ctx* ctx, const struct mf_instruction* inst) { return reduce_sum(ctx, inst, true); }
+static mf_exec_error op_REDUCE_MEAN_pairwise(mf_exec_ctx* ctx, const struct mf_instruction* inst) { return reduce_sum(ctx, inst, true); }
+
+// --- Min / Max ---
+
+// Vector min/max keep their second operand on NaN, so the accumulator goes second
+static f32 extreme_f32(const f32* p, size_t n, bool is_max) {
+    const f32 identity = is_max ? -INFINITY : INFINITY;
+    mf_vf32 acc = mf_vf32_set1(identity);
+    size_t i = 0;
+    if (is_max) { for (; i + MF_VF32_WIDTH <= n; i += MF_VF32_WIDTH) acc = mf_vf32_max(mf_vf32_load(p + i), acc); }
+    else        { for (; i + MF_VF32_WIDTH <= n; i += MF_VF32_WIDTH) acc = mf_vf32_min(mf_vf32_load(p + i), acc); }
+    f32 lanes[MF_VF32_WIDTH];
+    mf_vf32_store(lanes, acc);
+    f32 r = identity;
+    for (int k = 0; k < MF_VF32_WIDTH; ++k) r = is_max ? (lanes[k] > r ? lanes[k] : r) : (lanes[k] < r ? lanes[k] : r);
+    for (; i < n; ++i) r = is_max ? (p[i] > r ? p[i] : r) : (p[i] < r ? p[i] : r);
+    return r;
+}
+
+static mf_exec_error reduce_extreme(mf_exec_ctx* ctx, const struct mf_instruction* inst, bool is_max) {
+    mf_reduce_acc* acc = (mf_reduce_acc*)ctx->reg_ptrs[inst->dest_idx];
+    const u8* s_ptr = (const u8*)ctx->reg_ptrs[inst->src1_idx];
+    MF_CHECK_PTR(ctx, acc);
+    MF_CHECK_PTR(ctx, s_ptr);
+    const mf_dtype dtype = ctx->reg_info[inst->src1_idx].dtype;
+    const i32 st1 = MF_GET_STRIDE_S1(inst);
+    const size_t sz = ctx->batch_size;
+
+    mf_reduce_acc part;
+    mf_ops_reduce_init(inst->opcode, dtype, &part);
+    if (dtype == MF_DTYPE_F32) {
+        f32 r = is_max ? -INFINITY : INFINITY;
+        if (st1 == (i32)sizeof(f32)) r = extreme_f32((const f32*)s_ptr, sz, is_max);
+        else {
+            for (size_t i = 0; i < sz; ++i, s_ptr += st1) {
+                f32 v = *(const f32*)s_ptr;
+                r = is_max ? (v > r ? v : r) : (v < r ? v : r);
+            }
+        }
+        part.value.f = r;
+    } else {
+        i64 r = part.value.i;
+        for (size_t i = 0; i < sz; ++i, s_ptr += st1) {
+            i64 v = reduce_load_int(s_ptr, dtype);
+            r = is_max ? (v > r ? v : r) : (v < r ? v : r);
+        }
+        part.value.i = r;
+    }
+    part.count = (i64)sz;
+    mf_ops_reduce_combine(inst->opcode, dtype, acc, &part);
+    return MF_ERROR_NONE;
+}
+
+mf_exec_error op_REDUCE_MIN(mf_exec_ctx* ctx, const struct mf_instruction* inst) { return reduce_extreme(ctx, inst, false); }
+mf_exec_error op_REDUCE_MAX(mf_exec_ctx* ctx, const struct mf_instruction* inst) { return reduce_extreme(ctx, inst, true); }
+
+// --- ArgMin / ArgMax ---
+
+/**
+ * The job's extreme is found with vectors first; only then is it located, by a scalar
+ * search that stops at its first occurrence. Indices are flat, counted from the
+ * start of the domain (ctx->linear_offset).
+ */
+static mf_exec_error reduce_arg(mf_exec_ctx* ctx, const struct mf_instruction* inst, bool is_max) {
+    mf_reduce_acc* acc = (mf_reduce_acc*)ctx->reg_ptrs[inst->dest_idx];
+    const u8* s_ptr = (const u8*)ctx->reg_ptrs[inst->src1_idx];
+    MF_CHECK_PTR(ctx, acc);
+    MF_CHECK_PTR(ctx, s_ptr);
+    const mf_dtype dtype = ctx->reg_info[inst->src1_idx].dtype;
+    const i32 st1 = MF_GET_STRIDE_S1(inst);
+    const size_t sz = ctx->batch_size;
+
+    mf_reduce_acc part;
+    mf_ops_reduce_init(inst->opcode, dtype, &part);
+    if (dtype == MF_DTYPE_F32) {
+        f32 r = is_max ? -INFINITY : INFINITY;
+        size_t at = SIZE_MAX;
+        if (st1 == (i32)sizeof(f32)) {
+            const f32* p = (const f32*)s_ptr;
+            r = extreme_f32(p, sz, is_max);
+            for (size_t i = 0; i < sz; ++i) if (p[i] == r) { at = i; break; }
+        } else {
+            for (size_t i = 0; i < sz; ++i, s_ptr += st1) {
+                f32 v = *(const f32*)s_ptr;
+                if (is_max ? v > r : v < r) { r = v; at = i; }
+                else if (at == SIZE_MAX && v == r) at = i; // An infinite extreme equals the identity
+            }
+        }
+        if (at != SIZE_MAX) { part.value.f = r; part.count = (i64)ctx->linear_offset + (i64)at; }
+    } else {
+        i64 r = 0;
+        for (size_t i = 0; i < sz; ++i, s_ptr += st1) {
+            i64 v = reduce_load_int(s_ptr, dtype);
+            if (i == 0 || (is_max ? v > r : v < r)) { r = v; part.count = (i64)ctx->linear_offset + (i64)i; }
+        }
+        part.value.i = r;
+    }
+    mf_ops_reduce_combine(inst->opcode, dtype, acc, &part);
+    return MF_ERROR_NONE;
+}
+
+mf_exec_error op_ARGMIN(mf_exec_ctx* ctx, const struct mf_instruction* inst) { return reduce_arg(ctx, inst, false); }
+mf_exec_error op_ARGMAX(mf_exec_ctx* ctx, const struct mf_instruction* inst) { return reduce_arg(ctx, inst, true); }
+
+// --- Axis Reductions ---
+
+/**
+ * ReduceSumAxis & co. run over their output, not their input: the input is seen as
+ * [outer, K, inner] around the reduced axis, and a job produces the outputs
+ * [linear_offset, linear_offset + batch_size). A last axis (inner == 1) reduces
+ * contiguous rows of K; any other folds K rows of consecutive outputs together, so the
+ * vectors run across outputs (sums in f32, moved to f64 every MF_REDUCE_AXIS_ROWS rows).
+ */
+
+// acc[i] = acc[i] (op) row[i] for n contiguous outputs
+static void axis_fold_f32(f32* acc, const f32* row, size_t n, u16 op) {
+    size_t i = 0;
+    switch (op) {
+        case MF_OP_REDUCE_MIN:
+            for (; i + MF_VF32_WIDTH <= n; i += MF_VF32_WIDTH) mf_vf32_store(acc + i, mf_vf32_min(mf_vf32_load(row + i), mf_vf32_load(acc + i)));
+            for (; i < n; ++i) acc[i] = row[i] < acc[i] ? row[i] : acc[i];
+            break;
+        case MF_OP_REDUCE_MAX:
+            for (; i + MF_VF32_WIDTH <= n; i += MF_VF32_WIDTH) mf_vf32_store(acc + i, mf_vf32_max(mf_vf32_load(row + i), mf_vf32_load(acc + i)));
+            for (; i < n; ++i) acc[i] = row[i] > acc[i] ? row[i] : acc[i];
+            break;
+        default:
+            for (; i + MF_VF32_WIDTH <= n; i += MF_VF32_WIDTH) mf_vf32_store(acc + i, mf_vf32_add(mf_vf32_load(acc + i), mf_vf32_load(row + i)));
+            for (; i < n; ++i) acc[i] += row[i];
+            break;
+    }
+}
+
+static void reduce_axis_f32(f32* d, const f32* s, size_t offset, size_t sz, size_t k_len, size_t inner, u16 op) {
+    const bool is_extreme = (op == MF_OP_REDUCE_MIN || op == MF_OP_REDUCE_MAX);
+    if (k_len == 0) { memset(d, 0, sz * sizeof(f32)); return; } // Like an empty scalar reduction
+
+    if (inner == 1) {
+        for (size_t i = 0; i < sz; ++i) {
+            const f32* row = s + (offset + i) * k_len;
+            if (is_extreme) d[i] = extreme_f32(row, k_len, op == MF_OP_REDUCE_MAX);
+            else {
+                f64 sum = sum_blocked_f32(row, k_len);
+                d[i] = (f32)(op == MF_OP_REDUCE_MEAN ? sum / (f64)k_len : sum);
+            }
+        }
+        return;
+    }
+
+    const f32 identity = (op == MF_OP_REDUCE_MIN) ? INFINITY : (op == MF_OP_REDUCE_MAX) ? -INFINITY : 0.0f;
+    for (size_t i = 0; i < sz;) {
+        // Outputs up to the end of the job or of this outer slice
+        size_t o = offset + i;
+        size_t col = o % inner;
+        size_t n = (inner - col < sz - i) ? inner - col : sz - i;
+        const f32* rows = s + (o / inner) * k_len * inner + col;
+
+        for (size_t t = 0; t < n; t += MF_REDUCE_AXIS_TILE) {
+            size_t m = (n - t < MF_REDUCE_AXIS_TILE) ? n - t : MF_REDUCE_AXIS_TILE;
+            f32* acc = d + i + t;
+            const f32* row = rows + t;
+            if (is_extreme) {
+                for (size_t j = 0; j < m; ++j) acc[j] = identity;
+                for (size_t k = 0; k < k_len; ++k, row += inner) axis_fold_f32(acc, row, m, op);
+                continue;
+            }
+            f64 part[MF_REDUCE_AXIS_TILE];
+            for (size_t j = 0; j < m; ++j) part[j] = 0.0;
+            for (size_t k = 0; k < k_len;) {
+                size_t end = (k_len - k < MF_REDUCE_AXIS_ROWS) ? k_len : k + MF_REDUCE_AXIS_ROWS;
+                for (size_t j = 0; j < m; ++j) acc[j] = 0.0f;
+                for (; k < end; ++k, row += inner) axis_fold_f32(acc, row, m, op);
+                for (size_t j = 0; j < m; ++j) part[j] += acc[j];
+            }
+            const f64 scale = (op == MF_OP_REDUCE_MEAN) ? 1.0 / (f64)k_len : 1.0;
+            for (size_t j = 0; j < m; ++j) acc[j] = (f32)(part[j] * scale);
+        }
+        i += n;
+    }
+}
+
+static mf_exec_error reduce_axis(mf_exec_ctx* ctx, const struct mf_instruction* inst, u16 op) {
+    u8* d_ptr = (u8*)ctx->reg_ptrs[inst->dest_idx];
+    const u8* s_ptr = (const u8*)ctx->reg_ptrs[inst->src1_idx];
+    const u8* a_ptr = (const u8*)ctx->reg_ptrs[inst->src2_idx];
+    MF_CHECK_PTR(ctx, d_ptr);
+    MF_CHECK_PTR(ctx, s_ptr);
+    MF_CHECK_PTR(ctx, a_ptr);
+    const mf_type_info* s_info = &ctx->reg_info[inst->src1_idx];
+    const mf_dtype dtype = s_info->dtype;
+    const mf_dtype d_dtype = ctx->reg_info[inst->dest_idx].dtype;
+    const i32 st0 = MF_GET_STRIDE_D(inst);
+    const size_t sz = ctx->batch_size;
+    const size_t offset = ctx->linear_offset;
+
+    int axis = (ctx->reg_info[inst->src2_idx].dtype == MF_DTYPE_F32) ? (int)*(const f32*)a_ptr : *(const i32*)a_ptr;
+    if (axis < 0) axis += s_info->ndim;
+    if (axis < 0 || axis >= s_info->ndim) { ctx->error_idx = 0; return MF_ERROR_SHAPE_MISMATCH; }
+    size_t k_len = (size_t)s_info->shape[axis];
+    size_t inner = 1;
+    for (int k = axis + 1; k < s_info->ndim; ++k) inner *= (size_t)s_info->shape[k];
+
+    // The input was advanced by the job's start at its linear stride: rows are addressed from its base
+    s_ptr -= (ptrdiff_t)offset * MF_GET_STRIDE_S1(inst);
+
+    if (dtype == MF_DTYPE_F32 && d_dtype == MF_DTYPE_F32 && st0 == (i32)sizeof(f32)) {
+        reduce_axis_f32((f32*)d_ptr, (const f32*)s_ptr, offset, sz, k_len, inner, op);
+        return MF_ERROR_NONE;
+    }
+
+    // Integer sources (and odd layouts): one accumulator per output, with the scalar reductions' semantics
+    const size_t elem = mf_dtype_size(dtype);
+    for (size_t i = 0; i < sz; ++i, d_ptr += st0) {
+        size_t o = offset + i;
+        const u8* p = s_ptr + ((o / inner) * k_len * inner + o % inner) * elem;
+        mf_reduce_acc acc, part;
+        mf_ops_reduce_init(op, dtype, &acc);
+        part.count = 1;
+        for (size_t k = 0; k < k_len; ++k, p += inner * elem) {
+            if (dtype == MF_DTYPE_F32) part.value.f = *(const f32*)p;
+            else part.value.i = reduce_load_int(p, dtype);
+            mf_ops_reduce_combine(op, dtype, &acc, &part);
+        }
+        mf_ops_reduce_store(op, dtype, &acc, d_ptr, d_dtype);
+    }
+    return MF_ERROR_NONE;
+}
+
+mf_exec_error op_REDUCE_SUM_AXIS(mf_exec_ctx* ctx, const struct mf_instruction* inst) { return reduce_axis(ctx, inst, MF_OP_SUM); }
+mf_exec_error op_REDUCE_MIN_AXIS(mf_exec_ctx* ctx, const struct mf_instruction* inst) { return reduce_axis(ctx, inst, MF_OP_REDUCE_MIN); }
+mf_exec_error op_REDUCE_MAX_AXIS(mf_exec_ctx* ctx, const struct mf_instruction* inst) { return reduce_axis(ctx, inst, MF_OP_REDUCE_MAX); }
+mf_exec_error op_REDUCE_MEAN_AXIS(mf_exec_ctx* ctx, const struct mf_instruction* inst) { return reduce_axis(ctx, inst, MF_OP_REDUCE_MEAN); }
+
+// --- Segmented Reductions ---
+
+/**
+ * SegmentSum/Min/Max/Count: the dest register is the running thread's array of one
+ * accumulator per segment. A run of equal ids (sorted ids are one run per segment)
+ * folds into a local accumulator and touches the thread's array once. Ids outside
+ * [0, segments) are dropped.
+ */
+
+static inline i64 segment_load_id(const u8* p, mf_dtype dtype) {
+    if (dtype != MF_DTYPE_F32) return reduce_load_int(p, dtype);
+    f32 v = *(const f32*)p;
+    return (v >= 0.0f && v < 2147483648.0f) ? (i64)v : -1; // NaN is out of range too
+}
+
+static inline void segment_fold(mf_reduce_acc* run, u16 op, const u8* v_ptr, mf_dtype v_dtype) {
+    run->count++;
+    if (op == MF_OP_SEGMENT_COUNT) return;
+    if (v_dtype == MF_DTYPE_F32) {
+        f64 v = *(const f32*)v_ptr;
+        if (op == MF_OP_SEGMENT_MIN) { if (v < run->value.f) run->value.f = v; }
+        else if (op == MF_OP_SEGMENT_MAX) { if (v > run->value.f) run->value.f = v; }
+        else run->value.f += v;
+    } else {
+        i64 v = reduce_load_int(v_ptr, v_dtype);
+        if (op == MF_OP_SEGMENT_MIN) { if (v < run->value.i) run->value.i = v; }
+        else if (op == MF_OP_SEGMENT_MAX) { if (v > run->value.i) run->value.i = v; }
+        else run->value.i += v;
+    }
+}
+
+static mf_exec_error reduce_segments(mf_exec_ctx* ctx, const struct mf_instruction* inst, u16 op) {
+    // SegmentCount has no values: its ids are the first source
+    const bool has_values = (op != MF_OP_SEGMENT_COUNT);
+    const u16 id_idx = has_values ? inst->src2_idx : inst->src1_idx;
+    mf_reduce_acc* accs = (mf_reduce_acc*)ctx->reg_ptrs[inst->dest_idx];
+    const u8* v_ptr = (const u8*)ctx->reg_ptrs[inst->src1_idx];
+    const u8* id_ptr = (const u8*)ctx->reg_ptrs[id_idx];
+    MF_CHECK_PTR(ctx, accs);
+    MF_CHECK_PTR(ctx, id_ptr);
+    if (has_values) MF_CHECK_PTR(ctx, v_ptr);
+
+    const mf_type_info* d_info = &ctx->reg_info[inst->dest_idx];
+    const i64 segments = d_info->ndim > 0 ? d_info->shape[0] : 1;
+    const mf_dtype v_dtype = ctx->reg_info[inst->src1_idx].dtype;
+    const mf_dtype id_dtype = ctx->reg_info[id_idx].dtype;
+    const i32 st_v = MF_GET_STRIDE_S1(inst);
+    const i32 st_id = ctx->reg_strides[id_idx];
+    const size_t sz = ctx->batch_size;
+
+    mf_reduce_acc run;
+    i64 cur = -1;
+    for (size_t i = 0; i < sz; ++i) {
+        i64 id = segment_load_id(id_ptr + (ptrdiff_t)i * st_id, id_dtype);
+        if (id != cur) {
+            if (cur >= 0) mf_ops_reduce_combine(op, v_dtype, &accs[cur], &run);
+            cur = (id >= 0 && id < segments) ? id : -1;
+            if (cur >= 0) mf_ops_reduce_init(op, v_dtype, &run);
+        }
+        if (cur >= 0) segment_fold(&run, op, has_values ? v_ptr + (ptrdiff_t)i * st_v : NULL, v_dtype);
+    }
+    if (cur >= 0) mf_ops_reduce_combine(op, v_dtype, &accs[cur], &run);
+    return MF_ERROR_NONE;
+}
+
+mf_exec_error op_SEGMENT_SUM(mf_exec_ctx* ctx, const struct mf_instruction* inst) { return reduce_segments(ctx, inst, MF_OP_SEGMENT_SUM); }
+mf_exec_error op_SEGMENT_MIN(mf_exec_ctx* ctx, const struct mf_instruction* inst) { return reduce_segments(ctx, inst, MF_OP_SEGMENT_MIN); }
+mf_exec_error op_SEGMENT_MAX(mf_exec_ctx* ctx, const struct mf_instruction* inst) { return reduce_segments(ctx, inst, MF_OP_SEGMENT_MAX); }
+mf_exec_error op_SEGMENT_COUNT(mf_exec_ctx* ctx, const struct mf_instruction* inst) { return reduce_segments(ctx, inst, MF_OP_SEGMENT_COUNT); }
+
+// --- Accumulators ---
+
+mf_op_func mf_ops_find_pairwise(u16 opcode, mf_dtype src_dtype) {
+    if (src_dtype != MF_DTYPE_F32) return NULL;
+    switch (opcode) {
+        case MF_OP_SUM:         return op_SUM_pairwise;
+        case MF_OP_REDUCE_MEAN: return op_REDUCE_MEAN_pairwise;
+        default:                return NULL;
+    }
+}
+
+// Segmented reductions fold like their whole-stream counterparts (SegmentCount like a Sum)
+static u16 reduce_base_op(u16 opcode) {
+    switch (opcode) {
+        case MF_OP_SEGMENT_MIN: return MF_OP_REDUCE_MIN;
+        case MF_OP_SEGMENT_MAX: return MF_OP_REDUCE_MAX;
+        case MF_OP_SEGMENT_SUM: return MF_OP_SUM;
+        default:                return opcode;
+    }
+}
+
+void mf_ops_reduce_init(u16 opcode, mf_dtype src_dtype, mf_reduce_acc* acc) {
+    const bool is_float = (src_dtype == MF_DTYPE_F32);
+    opcode = reduce_base_op(opcode);
+    acc->count = 0;
+    switch (opcode) {
+        case MF_OP_REDUCE_MIN: case MF_OP_ARGMIN:
+            if (is_float) acc->value.f = INFINITY; else acc->value.i = INT64_MAX;
+            break;
+        case MF_OP_REDUCE_MAX: case MF_OP_ARGMAX:
+            if (is_float) acc->value.f = -INFINITY; else acc->value.i = INT64_MIN;
+            break;
+        default:
+            if (is_float) acc->value.f = 0.0; else acc->value.i = 0;
+            break;
+    }
+    if (opcode == MF_OP_ARGMIN || opcode == MF_OP_ARGMAX) acc->count = -1;
+}
+
+void mf_ops_reduce_combine(u16 opcode, mf_dtype src_dtype, mf_reduce_acc* acc, const mf_reduce_acc* other) {
+    const bool is_float = (src_dtype == MF_DTYPE_F32);
+    opcode = reduce_base_op(opcode);
+    switch (opcode) {
+        case MF_OP_REDUCE_MIN:
+            if (is_float) { if (other->value.f < acc->value.f) acc->value.f = other->value.f; }
+            else if (other->value.i < acc->value.i) acc->value.i = other->value.i;
+            acc->count += other->count;
+            break;
+        case MF_OP_REDUCE_MAX:
+            if (is_float) { if (other->value.f > acc->value.f) acc->value.f = other->value.f; }
+            else if (other->value.i > acc->value.i) acc->value.i = other->value.i;
+            acc->count += other->count;
+            break;
+        case MF_OP_ARGMIN: case MF_OP_ARGMAX: {
+            if (other->count < 0) break;
+            const bool is_max = (opcode == MF_OP_ARGMAX);
+            bool better = acc->count < 0;
+            if (!better) {
+                if (is_float) better = is_max ? other->value.f > acc->value.f : other->value.f < acc->value.f;
+                else better = is_max ? other->value.i > acc->value.i : other->value.i < acc->value.i;
+                bool tie = is_float ? other->value.f == acc->value.f : other->value.i == acc->value.i;
+                if (tie && other->count < acc->count) better = true;
+            }
+            if (better) *acc = *other;
+            break;
+        }
+        default:
+            if (is_float) acc->value.f += other->value.f; else acc->value.i += other->value.i;
+            acc->count += other->count;
+            break;
+    }
+}
+
+void mf_ops_reduce_store(u16 opcode, mf_dtype src_dtype, const mf_reduce_acc* acc, void* dest, mf_dtype dest_dtype) {
+    opcode = reduce_base_op(opcode);
+    const bool is_float = (src_dtype == MF_DTYPE_F32);
+    // ArgMin/ArgMax and SegmentCount store their count field
+    const bool is_arg = (opcode == MF_OP_ARGMIN || opcode == MF_OP_ARGMAX || opcode == MF_OP_SEGMENT_COUNT);
+    // Nothing folded into Min/Max: the identity (+-inf) is no value
+    const bool empty = (opcode == MF_OP_REDUCE_MIN || opcode == MF_OP_REDUCE_MAX) && acc->count == 0;
+
+    if (!is_float && !is_arg && opcode != MF_OP_REDUCE_MEAN && dest_dtype != MF_DTYPE_F32) {
+        // Integer results wrap like the i32 kernels do
+        u64 bits = empty ? 0 : (u64)acc->value.i;
+        if (dest_dtype == MF_DTYPE_I32) *(i32*)dest = (i32)(u32)bits;
+        else if (dest_dtype == MF_DTYPE_U8) *(u8*)dest = (u8)bits;
+        return;
+    }
+
+    f64 v;
+    if (is_arg) v = (f64)acc->count;
+    else if (empty) v = 0.0;
+    else {
+        v = is_float ? acc->value.f : (f64)acc->value.i;
+        if (opcode == MF_OP_REDUCE_MEAN) v = acc->count > 0 ? v / (f64)acc->count : 0.0;
+    }
+    switch (dest_dtype) {
+        case MF_DTYPE_F32: *(f32*)dest = (f32)v; break;
+        case MF_DTYPE_I32: *(i32*)dest = (i32)v; break;
+        case MF_DTYPE_U8:  *(u8*)dest = (u8)(i32)v; break;
+        default: break;
+    }
+}
@@ -5,8 +5,53 @@
 #include "mf_ops_internal.h"
 #include <string.h>
 
-void op_COPY(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+// --- Dtype Conversion ---
+
+// Contiguous runs between f32 and half storage, the common case (widening loads, narrowing stores)
+static bool copy_convert_vec(u8* d_ptr, mf_dtype d_type, const u8* s_ptr, mf_dtype s_type, size_t sz) {
+    size_t i = 0;
+    const size_t vec_end = sz - sz % MF_VF32_WIDTH;
+    if (s_type == MF_DTYPE_F32 && d_type == MF_DTYPE_F16) {
+        for (; i < vec_end; i += MF_VF32_WIDTH) mf_vf32_store_f16((u16*)d_ptr + i, mf_vf32_load((const f32*)s_ptr + i));
+    } else if (s_type == MF_DTYPE_F32 && d_type == MF_DTYPE_BF16) {
+        for (; i < vec_end; i += MF_VF32_WIDTH) mf_vf32_store_bf16((u16*)d_ptr + i, mf_vf32_load((const f32*)s_ptr + i));
+    } else if (s_type == MF_DTYPE_F16 && d_type == MF_DTYPE_F32) {
+        for (; i < vec_end; i += MF_VF32_WIDTH) mf_vf32_store((f32*)d_ptr + i, mf_vf32_load_f16((const u16*)s_ptr + i));
+    } else if (s_type == MF_DTYPE_BF16 && d_type == MF_DTYPE_F32) {
+        for (; i < vec_end; i += MF_VF32_WIDTH) mf_vf32_store((f32*)d_ptr + i, mf_vf32_load_bf16((const u16*)s_ptr + i));
+    } else {
+        return false;
+    }
+    for (; i < sz; ++i) mf_dtype_store_f32(d_ptr, d_type, i, mf_dtype_load_f32(s_ptr, s_type, i));
+    return true;
+}
+
+static void copy_convert(mf_exec_ctx* ctx, const struct mf_instruction* inst, mf_dtype s_type, mf_dtype d_type) {
+    size_t sz = ctx->batch_size;
+    u8* d_ptr = (u8*)ctx->reg_ptrs[inst->dest_idx];
+    const u8* s_ptr = (const u8*)ctx->reg_ptrs[inst->src1_idx];
+    i32 st0 = MF_GET_STRIDE_D(inst);
+    i32 st1 = MF_GET_STRIDE_S1(inst);
+
+    if (st0 == (i32)mf_dtype_size(d_type) && st1 == (i32)mf_dtype_size(s_type) &&
+        copy_convert_vec(d_ptr, d_type, s_ptr, s_type, sz)) return;
+
+    for (size_t i = 0; i < sz; ++i) {
+        mf_dtype_store_f32(d_ptr, d_type, 0, mf_dtype_load_f32(s_ptr, s_type, 0));
+        s_ptr += st1;
+        d_ptr += st0;
+    }
+}
+
+// Copy between registers; a dtype change (e.g. f32 results into F16 storage) converts through f32
+mf_exec_error op_COPY(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
     const mf_type_info* info = &ctx->reg_info[inst->src1_idx];
+    mf_dtype d_type = ctx->reg_info[inst->dest_idx].dtype;
+    if (d_type != info->dtype && d_type != MF_DTYPE_UNKNOWN) {
+        copy_convert(ctx, inst, info->dtype, d_type);
+        return MF_ERROR_NONE;
+    }
+
     size_t sz = ctx->batch_size;
     size_t esize = mf_dtype_size(info->dtype);
     
@@ -21,12 +66,13 @@ void op_COPY(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
         s_ptr += st1;
         d_ptr += st0;
     }
+    return MF_ERROR_NONE;
 }
 
-void op_SLICE(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
-    op_COPY(ctx, inst);
+mf_exec_error op_SLICE(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+    return op_COPY(ctx, inst);
 }
 
-void op_RESHAPE(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
-    op_COPY(ctx, inst);
+mf_exec_error op_RESHAPE(mf_exec_ctx* ctx, const struct mf_instruction* inst) {
+    return op_COPY(ctx, inst);
 }
\ No newline at end of file
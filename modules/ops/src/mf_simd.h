@@ -0,0 +1,367 @@
+#ifndef MF_SIMD_H
+#define MF_SIMD_H
+
+#include <mathflow/base/mf_types.h>
+#include <mathflow/base/mf_half.h>
+#include <math.h>
+
+/**
+ * MathFlow SIMD Abstraction
+ * Thin wrapper over the widest vector unit enabled at compile time.
+ * Kernels are written once against mf_vf32 and get AVX2, SSE2, NEON or a
+ * scalar fallback depending on the target flags (see MF_ENABLE_NATIVE_ARCH).
+ */
+
+#if defined(_MSC_VER)
+    #define MF_FORCE_INLINE static __forceinline
+#else
+    #define MF_FORCE_INLINE static inline __attribute__((always_inline))
+#endif
+
+#if defined(__AVX2__)
+    #define MF_SIMD_AVX2 1
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define MF_SIMD_SSE2 1
+    #include <emmintrin.h>
+    #if defined(__SSE4_1__)
+        #include <smmintrin.h>
+    #endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #define MF_SIMD_NEON 1
+    #include <arm_neon.h>
+#else
+    #define MF_SIMD_SCALAR 1
+#endif
+
+// --- AVX2 (8 lanes) ---
+#if defined(MF_SIMD_AVX2)
+
+typedef __m256 mf_vf32;
+#define MF_VF32_WIDTH 8
+#define MF_SIMD_NAME "AVX2"
+
+MF_FORCE_INLINE mf_vf32 mf_vf32_load(const f32* p) { return _mm256_loadu_ps(p); }
+MF_FORCE_INLINE void mf_vf32_store(f32* p, mf_vf32 v) { _mm256_storeu_ps(p, v); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_set1(f32 x) { return _mm256_set1_ps(x); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_load_strided(const u8* p, i32 stride) {
+    const __m256i offs = _mm256_mullo_epi32(_mm256_set1_epi32(stride), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    return _mm256_i32gather_ps((const float*)p, offs, 1);
+}
+
+MF_FORCE_INLINE mf_vf32 mf_vf32_add(mf_vf32 a, mf_vf32 b) { return _mm256_add_ps(a, b); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_sub(mf_vf32 a, mf_vf32 b) { return _mm256_sub_ps(a, b); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_mul(mf_vf32 a, mf_vf32 b) { return _mm256_mul_ps(a, b); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_div(mf_vf32 a, mf_vf32 b) { return _mm256_div_ps(a, b); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_min(mf_vf32 a, mf_vf32 b) { return _mm256_min_ps(a, b); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_max(mf_vf32 a, mf_vf32 b) { return _mm256_max_ps(a, b); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_sqrt(mf_vf32 a) { return _mm256_sqrt_ps(a); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_floor(mf_vf32 a) { return _mm256_floor_ps(a); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_ceil(mf_vf32 a) { return _mm256_ceil_ps(a); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_abs(mf_vf32 a) {
+    return _mm256_and_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff)));
+}
+MF_FORCE_INLINE mf_vf32 mf_vf32_step(mf_vf32 edge, mf_vf32 x) {
+    return _mm256_andnot_ps(_mm256_cmp_ps(x, edge, _CMP_LT_OQ), _mm256_set1_ps(1.0f));
+}
+MF_FORCE_INLINE mf_vf32 mf_vf32_sanitize(mf_vf32 a) {
+    return _mm256_and_ps(a, _mm256_cmp_ps(mf_vf32_abs(a), _mm256_set1_ps(INFINITY), _CMP_LT_OQ));
+}
+MF_FORCE_INLINE bool mf_vf32_any_nonfinite(mf_vf32 a) {
+    return _mm256_movemask_ps(_mm256_cmp_ps(mf_vf32_abs(a), _mm256_set1_ps(INFINITY), _CMP_LT_OQ)) != 0xFF;
+}
+#if defined(__FMA__)
+MF_FORCE_INLINE mf_vf32 mf_vf32_fma(mf_vf32 a, mf_vf32 b, mf_vf32 c) { return _mm256_fmadd_ps(a, b, c); }
+#endif
+
+// Integer lanes (index streams)
+typedef __m256i mf_vi32;
+MF_FORCE_INLINE mf_vi32 mf_vi32_load(const i32* p) { return _mm256_loadu_si256((const __m256i*)p); }
+MF_FORCE_INLINE void mf_vi32_store(i32* p, mf_vi32 v) { _mm256_storeu_si256((__m256i*)p, v); }
+MF_FORCE_INLINE mf_vi32 mf_vi32_set1(i32 x) { return _mm256_set1_epi32(x); }
+MF_FORCE_INLINE mf_vi32 mf_vi32_from_vf32(mf_vf32 a) { return _mm256_cvttps_epi32(a); } // Truncates like (i32)
+MF_FORCE_INLINE mf_vi32 mf_vi32_sub(mf_vi32 a, mf_vi32 b) { return _mm256_sub_epi32(a, b); }
+MF_FORCE_INLINE mf_vi32 mf_vi32_min(mf_vi32 a, mf_vi32 b) { return _mm256_min_epi32(a, b); }
+MF_FORCE_INLINE mf_vi32 mf_vi32_max(mf_vi32 a, mf_vi32 b) { return _mm256_max_epi32(a, b); }
+MF_FORCE_INLINE mf_vi32 mf_vi32_or(mf_vi32 a, mf_vi32 b) { return _mm256_or_si256(a, b); }
+MF_FORCE_INLINE mf_vi32 mf_vi32_xor(mf_vi32 a, mf_vi32 b) { return _mm256_xor_si256(a, b); }
+
+// --- SSE2 (4 lanes) ---
+#elif defined(MF_SIMD_SSE2)
+
+typedef __m128 mf_vf32;
+#define MF_VF32_WIDTH 4
+#define MF_SIMD_NAME "SSE2"
+
+MF_FORCE_INLINE mf_vf32 mf_vf32_load(const f32* p) { return _mm_loadu_ps(p); }
+MF_FORCE_INLINE void mf_vf32_store(f32* p, mf_vf32 v) { _mm_storeu_ps(p, v); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_set1(f32 x) { return _mm_set1_ps(x); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_load_strided(const u8* p, i32 stride) {
+    return _mm_setr_ps(*(const f32*)p, *(const f32*)(p + stride), *(const f32*)(p + 2 * stride), *(const f32*)(p + 3 * stride));
+}
+
+MF_FORCE_INLINE mf_vf32 mf_vf32_add(mf_vf32 a, mf_vf32 b) { return _mm_add_ps(a, b); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_sub(mf_vf32 a, mf_vf32 b) { return _mm_sub_ps(a, b); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_mul(mf_vf32 a, mf_vf32 b) { return _mm_mul_ps(a, b); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_div(mf_vf32 a, mf_vf32 b) { return _mm_div_ps(a, b); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_min(mf_vf32 a, mf_vf32 b) { return _mm_min_ps(a, b); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_max(mf_vf32 a, mf_vf32 b) { return _mm_max_ps(a, b); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_sqrt(mf_vf32 a) { return _mm_sqrt_ps(a); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_abs(mf_vf32 a) {
+    return _mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)));
+}
+#if defined(__SSE4_1__)
+MF_FORCE_INLINE mf_vf32 mf_vf32_floor(mf_vf32 a) { return _mm_floor_ps(a); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_ceil(mf_vf32 a) { return _mm_ceil_ps(a); }
+#else
+// Truncate-and-correct. Values >= 2^23 (and NaN) are already integral and pass through.
+MF_FORCE_INLINE mf_vf32 _mf_vf32_round_fix(mf_vf32 a, mf_vf32 r) {
+    const __m128 sign = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000u));
+    const __m128 big = _mm_cmpnlt_ps(mf_vf32_abs(a), _mm_set1_ps(8388608.0f));
+    r = _mm_or_ps(r, _mm_and_ps(a, sign));
+    return _mm_or_ps(_mm_and_ps(big, a), _mm_andnot_ps(big, r));
+}
+MF_FORCE_INLINE mf_vf32 mf_vf32_floor(mf_vf32 a) {
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+    t = _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a), _mm_set1_ps(1.0f)));
+    return _mf_vf32_round_fix(a, t);
+}
+MF_FORCE_INLINE mf_vf32 mf_vf32_ceil(mf_vf32 a) {
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+    t = _mm_add_ps(t, _mm_and_ps(_mm_cmplt_ps(t, a), _mm_set1_ps(1.0f)));
+    return _mf_vf32_round_fix(a, t);
+}
+#endif
+MF_FORCE_INLINE mf_vf32 mf_vf32_step(mf_vf32 edge, mf_vf32 x) {
+    return _mm_andnot_ps(_mm_cmplt_ps(x, edge), _mm_set1_ps(1.0f));
+}
+MF_FORCE_INLINE mf_vf32 mf_vf32_sanitize(mf_vf32 a) {
+    return _mm_and_ps(a, _mm_cmplt_ps(mf_vf32_abs(a), _mm_set1_ps(INFINITY)));
+}
+MF_FORCE_INLINE bool mf_vf32_any_nonfinite(mf_vf32 a) {
+    return _mm_movemask_ps(_mm_cmplt_ps(mf_vf32_abs(a), _mm_set1_ps(INFINITY))) != 0xF;
+}
+
+// Integer lanes (index streams)
+typedef __m128i mf_vi32;
+MF_FORCE_INLINE mf_vi32 mf_vi32_load(const i32* p) { return _mm_loadu_si128((const __m128i*)p); }
+MF_FORCE_INLINE void mf_vi32_store(i32* p, mf_vi32 v) { _mm_storeu_si128((__m128i*)p, v); }
+MF_FORCE_INLINE mf_vi32 mf_vi32_set1(i32 x) { return _mm_set1_epi32(x); }
+MF_FORCE_INLINE mf_vi32 mf_vi32_from_vf32(mf_vf32 a) { return _mm_cvttps_epi32(a); } // Truncates like (i32)
+MF_FORCE_INLINE mf_vi32 mf_vi32_sub(mf_vi32 a, mf_vi32 b) { return _mm_sub_epi32(a, b); }
+#if defined(__SSE4_1__)
+MF_FORCE_INLINE mf_vi32 mf_vi32_min(mf_vi32 a, mf_vi32 b) { return _mm_min_epi32(a, b); }
+MF_FORCE_INLINE mf_vi32 mf_vi32_max(mf_vi32 a, mf_vi32 b) { return _mm_max_epi32(a, b); }
+#else
+MF_FORCE_INLINE mf_vi32 mf_vi32_min(mf_vi32 a, mf_vi32 b) {
+    const __m128i gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+}
+MF_FORCE_INLINE mf_vi32 mf_vi32_max(mf_vi32 a, mf_vi32 b) {
+    const __m128i gt = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+}
+#endif
+MF_FORCE_INLINE mf_vi32 mf_vi32_or(mf_vi32 a, mf_vi32 b) { return _mm_or_si128(a, b); }
+MF_FORCE_INLINE mf_vi32 mf_vi32_xor(mf_vi32 a, mf_vi32 b) { return _mm_xor_si128(a, b); }
+
+// --- NEON (4 lanes, AArch64) ---
+#elif defined(MF_SIMD_NEON)
+
+typedef float32x4_t mf_vf32;
+#define MF_VF32_WIDTH 4
+#define MF_SIMD_NAME "NEON"
+
+MF_FORCE_INLINE mf_vf32 mf_vf32_load(const f32* p) { return vld1q_f32(p); }
+MF_FORCE_INLINE void mf_vf32_store(f32* p, mf_vf32 v) { vst1q_f32(p, v); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_set1(f32 x) { return vdupq_n_f32(x); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_load_strided(const u8* p, i32 stride) {
+    f32 lanes[4] = { *(const f32*)p, *(const f32*)(p + stride), *(const f32*)(p + 2 * stride), *(const f32*)(p + 3 * stride) };
+    return vld1q_f32(lanes);
+}
+
+MF_FORCE_INLINE mf_vf32 mf_vf32_add(mf_vf32 a, mf_vf32 b) { return vaddq_f32(a, b); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_sub(mf_vf32 a, mf_vf32 b) { return vsubq_f32(a, b); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_mul(mf_vf32 a, mf_vf32 b) { return vmulq_f32(a, b); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_div(mf_vf32 a, mf_vf32 b) { return vdivq_f32(a, b); }
+// Match the scalar (a < b ? a : b) selection, including NaN handling.
+MF_FORCE_INLINE mf_vf32 mf_vf32_min(mf_vf32 a, mf_vf32 b) { return vbslq_f32(vcltq_f32(a, b), a, b); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_max(mf_vf32 a, mf_vf32 b) { return vbslq_f32(vcgtq_f32(a, b), a, b); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_sqrt(mf_vf32 a) { return vsqrtq_f32(a); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_floor(mf_vf32 a) { return vrndmq_f32(a); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_ceil(mf_vf32 a) { return vrndpq_f32(a); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_abs(mf_vf32 a) { return vabsq_f32(a); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_step(mf_vf32 edge, mf_vf32 x) {
+    return vbslq_f32(vcltq_f32(x, edge), vdupq_n_f32(0.0f), vdupq_n_f32(1.0f));
+}
+MF_FORCE_INLINE mf_vf32 mf_vf32_sanitize(mf_vf32 a) {
+    return vbslq_f32(vcltq_f32(vabsq_f32(a), vdupq_n_f32(INFINITY)), a, vdupq_n_f32(0.0f));
+}
+MF_FORCE_INLINE bool mf_vf32_any_nonfinite(mf_vf32 a) {
+    return vminvq_u32(vcltq_f32(vabsq_f32(a), vdupq_n_f32(INFINITY))) == 0;
+}
+MF_FORCE_INLINE mf_vf32 mf_vf32_fma(mf_vf32 a, mf_vf32 b, mf_vf32 c) { return vfmaq_f32(c, a, b); }
+#define MF_SIMD_HAS_FMA 1
+
+// Integer lanes (index streams)
+typedef int32x4_t mf_vi32;
+MF_FORCE_INLINE mf_vi32 mf_vi32_load(const i32* p) { return vld1q_s32(p); }
+MF_FORCE_INLINE void mf_vi32_store(i32* p, mf_vi32 v) { vst1q_s32(p, v); }
+MF_FORCE_INLINE mf_vi32 mf_vi32_set1(i32 x) { return vdupq_n_s32(x); }
+MF_FORCE_INLINE mf_vi32 mf_vi32_from_vf32(mf_vf32 a) { return vcvtq_s32_f32(a); } // Truncates like (i32)
+MF_FORCE_INLINE mf_vi32 mf_vi32_sub(mf_vi32 a, mf_vi32 b) { return vsubq_s32(a, b); }
+MF_FORCE_INLINE mf_vi32 mf_vi32_min(mf_vi32 a, mf_vi32 b) { return vminq_s32(a, b); }
+MF_FORCE_INLINE mf_vi32 mf_vi32_max(mf_vi32 a, mf_vi32 b) { return vmaxq_s32(a, b); }
+MF_FORCE_INLINE mf_vi32 mf_vi32_or(mf_vi32 a, mf_vi32 b) { return vorrq_s32(a, b); }
+MF_FORCE_INLINE mf_vi32 mf_vi32_xor(mf_vi32 a, mf_vi32 b) { return veorq_s32(a, b); }
+
+// --- Scalar Fallback (1 lane) ---
+#else
+
+typedef f32 mf_vf32;
+#define MF_VF32_WIDTH 1
+#define MF_SIMD_NAME "Scalar"
+
+MF_FORCE_INLINE mf_vf32 mf_vf32_load(const f32* p) { return *p; }
+MF_FORCE_INLINE void mf_vf32_store(f32* p, mf_vf32 v) { *p = v; }
+MF_FORCE_INLINE mf_vf32 mf_vf32_set1(f32 x) { return x; }
+MF_FORCE_INLINE mf_vf32 mf_vf32_load_strided(const u8* p, i32 stride) { (void)stride; return *(const f32*)p; }
+
+MF_FORCE_INLINE mf_vf32 mf_vf32_add(mf_vf32 a, mf_vf32 b) { return a + b; }
+MF_FORCE_INLINE mf_vf32 mf_vf32_sub(mf_vf32 a, mf_vf32 b) { return a - b; }
+MF_FORCE_INLINE mf_vf32 mf_vf32_mul(mf_vf32 a, mf_vf32 b) { return a * b; }
+MF_FORCE_INLINE mf_vf32 mf_vf32_div(mf_vf32 a, mf_vf32 b) { return a / b; }
+MF_FORCE_INLINE mf_vf32 mf_vf32_min(mf_vf32 a, mf_vf32 b) { return a < b ? a : b; }
+MF_FORCE_INLINE mf_vf32 mf_vf32_max(mf_vf32 a, mf_vf32 b) { return a > b ? a : b; }
+MF_FORCE_INLINE mf_vf32 mf_vf32_sqrt(mf_vf32 a) { return sqrtf(a); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_floor(mf_vf32 a) { return floorf(a); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_ceil(mf_vf32 a) { return ceilf(a); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_abs(mf_vf32 a) { return fabsf(a); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_step(mf_vf32 edge, mf_vf32 x) { return x < edge ? 0.0f : 1.0f; }
+MF_FORCE_INLINE mf_vf32 mf_vf32_sanitize(mf_vf32 a) { return isfinite(a) ? a : 0.0f; }
+MF_FORCE_INLINE bool mf_vf32_any_nonfinite(mf_vf32 a) { return !isfinite(a); }
+MF_FORCE_INLINE mf_vf32 mf_vf32_fma(mf_vf32 a, mf_vf32 b, mf_vf32 c) { return fmaf(a, b, c); }
+#define MF_SIMD_HAS_FMA 1
+
+// Integer lanes (index streams)
+typedef i32 mf_vi32;
+MF_FORCE_INLINE mf_vi32 mf_vi32_load(const i32* p) { return *p; }
+MF_FORCE_INLINE void mf_vi32_store(i32* p, mf_vi32 v) { *p = v; }
+MF_FORCE_INLINE mf_vi32 mf_vi32_set1(i32 x) { return x; }
+MF_FORCE_INLINE mf_vi32 mf_vi32_from_vf32(mf_vf32 a) { return (i32)a; }
+MF_FORCE_INLINE mf_vi32 mf_vi32_sub(mf_vi32 a, mf_vi32 b) { return (i32)((u32)a - (u32)b); }
+MF_FORCE_INLINE mf_vi32 mf_vi32_min(mf_vi32 a, mf_vi32 b) { return a < b ? a : b; }
+MF_FORCE_INLINE mf_vi32 mf_vi32_max(mf_vi32 a, mf_vi32 b) { return a > b ? a : b; }
+MF_FORCE_INLINE mf_vi32 mf_vi32_or(mf_vi32 a, mf_vi32 b) { return a | b; }
+MF_FORCE_INLINE mf_vi32 mf_vi32_xor(mf_vi32 a, mf_vi32 b) { return a ^ b; }
+
+#endif
+
+// --- Fused Multiply-Add Fallback ---
+// Without hardware FMA the lanes go through fmaf() so results stay bit-exact with the scalar kernel.
+#if (defined(MF_SIMD_AVX2) && defined(__FMA__))
+    #define MF_SIMD_HAS_FMA 1
+#endif
+
+#if !defined(MF_SIMD_HAS_FMA)
+#define MF_SIMD_EMULATED_FMA 1 // Slower than the scalar loop: Fma kernels stay scalar (mf_ops_math_fill_emulated)
+MF_FORCE_INLINE mf_vf32 mf_vf32_fma(mf_vf32 a, mf_vf32 b, mf_vf32 c) {
+    f32 la[MF_VF32_WIDTH], lb[MF_VF32_WIDTH], lc[MF_VF32_WIDTH];
+    mf_vf32_store(la, a); mf_vf32_store(lb, b); mf_vf32_store(lc, c);
+    for (int i = 0; i < MF_VF32_WIDTH; ++i) la[i] = fmaf(la[i], lb[i], lc[i]);
+    return mf_vf32_load(la);
+}
+#endif
+
+// --- Half Conversion ---
+// F16/BF16 storage widens to and narrows from mf_vf32 lanes. F16 uses F16C where enabled,
+// BF16 is integer shifts; elsewhere the lanes go through the mf_half.h conversions.
+#if defined(MF_SIMD_AVX2) && defined(__F16C__)
+    #define MF_SIMD_HAS_F16C 1
+MF_FORCE_INLINE mf_vf32 mf_vf32_load_f16(const u16* p) { return _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)p)); }
+MF_FORCE_INLINE void mf_vf32_store_f16(u16* p, mf_vf32 v) {
+    _mm_storeu_si128((__m128i*)p, _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+}
+#else
+MF_FORCE_INLINE mf_vf32 mf_vf32_load_f16(const u16* p) {
+    f32 lanes[MF_VF32_WIDTH];
+    for (int i = 0; i < MF_VF32_WIDTH; ++i) lanes[i] = mf_f16_to_f32(p[i]);
+    return mf_vf32_load(lanes);
+}
+MF_FORCE_INLINE void mf_vf32_store_f16(u16* p, mf_vf32 v) {
+    f32 lanes[MF_VF32_WIDTH];
+    mf_vf32_store(lanes, v);
+    for (int i = 0; i < MF_VF32_WIDTH; ++i) p[i] = mf_f16_from_f32(lanes[i]);
+}
+#endif
+
+#if defined(MF_SIMD_AVX2)
+MF_FORCE_INLINE mf_vf32 mf_vf32_load_bf16(const u16* p) {
+    __m256i w = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)p));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(w, 16));
+}
+MF_FORCE_INLINE void mf_vf32_store_bf16(u16* p, mf_vf32 v) {
+    const __m256i x = _mm256_castps_si256(v);
+    const __m256i odd = _mm256_and_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(1));
+    const __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(x, _mm256_add_epi32(odd, _mm256_set1_epi32(0x7FFF))), 16);
+    const __m256i quiet = _mm256_or_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(0x40));
+    const __m256i nan = _mm256_cmpgt_epi32(_mm256_and_si256(x, _mm256_set1_epi32(0x7FFFFFFF)), _mm256_set1_epi32(0x7F800000));
+    const __m256i r = _mm256_blendv_epi8(rounded, quiet, nan);
+    // Lanes hold 0..0xFFFF, so the unsigned pack is exact; it packs within 128-bit halves
+    const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(r, r), 0x08);
+    _mm_storeu_si128((__m128i*)p, _mm256_castsi256_si128(packed));
+}
+#else
+MF_FORCE_INLINE mf_vf32 mf_vf32_load_bf16(const u16* p) {
+    f32 lanes[MF_VF32_WIDTH];
+    for (int i = 0; i < MF_VF32_WIDTH; ++i) lanes[i] = mf_bf16_to_f32(p[i]);
+    return mf_vf32_load(lanes);
+}
+MF_FORCE_INLINE void mf_vf32_store_bf16(u16* p, mf_vf32 v) {
+    f32 lanes[MF_VF32_WIDTH];
+    mf_vf32_store(lanes, v);
+    for (int i = 0; i < MF_VF32_WIDTH; ++i) p[i] = mf_bf16_from_f32(lanes[i]);
+}
+#endif
+
+// --- Prefetch ---
+#if defined(__GNUC__) || defined(__clang__)
+    #define MF_PREFETCH(p) __builtin_prefetch(p)
+#elif defined(MF_SIMD_AVX2) || defined(MF_SIMD_SSE2)
+    #define MF_PREFETCH(p) _mm_prefetch((const char*)(p), _MM_HINT_T0)
+#else
+    #define MF_PREFETCH(p) ((void)(p))
+#endif
+
+// --- Integer Lane Reductions ---
+MF_FORCE_INLINE i32 mf_vi32_reduce_min(mf_vi32 v) {
+    i32 lanes[MF_VF32_WIDTH];
+    mf_vi32_store(lanes, v);
+    i32 r = lanes[0];
+    for (int i = 1; i < MF_VF32_WIDTH; ++i) r = lanes[i] < r ? lanes[i] : r;
+    return r;
+}
+MF_FORCE_INLINE i32 mf_vi32_reduce_max(mf_vi32 v) {
+    i32 lanes[MF_VF32_WIDTH];
+    mf_vi32_store(lanes, v);
+    i32 r = lanes[0];
+    for (int i = 1; i < MF_VF32_WIDTH; ++i) r = lanes[i] > r ? lanes[i] : r;
+    return r;
+}
+MF_FORCE_INLINE i32 mf_vi32_reduce_or(mf_vi32 v) {
+    i32 lanes[MF_VF32_WIDTH];
+    mf_vi32_store(lanes, v);
+    i32 r = 0;
+    for (int i = 0; i < MF_VF32_WIDTH; ++i) r |= lanes[i];
+    return r;
+}
+
+// --- Strided Store ---
+// No ISA above has a scatter; lanes go out one by one.
+MF_FORCE_INLINE void mf_vf32_store_strided(u8* p, i32 stride, mf_vf32 v) {
+    f32 lanes[MF_VF32_WIDTH];
+    mf_vf32_store(lanes, v);
+    for (int i = 0; i < MF_VF32_WIDTH; ++i) *(f32*)(p + (ptrdiff_t)i * stride) = lanes[i];
+}
+
+#endif // MF_SIMD_H